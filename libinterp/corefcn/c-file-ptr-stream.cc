@@ -24,6 +24,7 @@ along with Octave; see the file COPYING.  If not, see
 #  include "config.h"
 #endif
 
+#include <cstring>
 #include <iostream>
 
 #include "filepos-wrappers.h"
@@ -178,6 +179,131 @@ c_file_ptr_buf::tell (void)
   return f ? octave_ftello_wrapper (f) : -1;
 }
 
+bool
+c_file_ptr_buf::seekable (void)
+{
+  if (seek_state < 0)
+    seek_state = (f && octave_ftello_wrapper (f) >= 0) ? 1 : 0;
+
+  return seek_state > 0;
+}
+
+// Read a line terminated by LF, CRLF, or CR directly from the file in
+// blocks instead of one character at a time.  At most MAX_LEN
+// characters are read if MAX_LEN is positive.  Returns the number of
+// characters consumed, including the line ending.
+//
+// Characters read past a lone CR are returned to the file by seeking
+// backward, so this function must only be used if the file is
+// seekable.
+
+int
+c_file_ptr_buf::read_line (std::string& line, int max_len,
+                           bool strip_newline, bool& at_eof, bool& read_err)
+{
+  static const int block_size = 4096;
+
+  char buf[block_size + 2];
+
+  int char_count = 0;
+
+  at_eof = false;
+  read_err = false;
+
+  if (! f)
+    {
+      read_err = true;
+      return char_count;
+    }
+
+  for (;;)
+    {
+      int want = block_size;
+
+      if (max_len > 0 && max_len - char_count < want - 1)
+        want = max_len - char_count + 1;
+
+      // Fill the buffer with newline characters so that the end of
+      // the data returned by fgets can be found with memchr even if
+      // the data contains NUL characters.  If the first newline is
+      // followed by NUL, it is the last character read.  Otherwise it
+      // immediately follows the NUL appended by fgets.
+
+      std::memset (buf, '\n', want + 2);
+
+      if (! std::fgets (buf, want, f))
+        {
+          if (std::ferror (f))
+            read_err = true;
+          else
+            at_eof = true;
+
+          break;
+        }
+
+      const char *nl = static_cast<const char *> (std::memchr (buf, '\n',
+                                                              want + 2));
+
+      int len = (nl[1] == '\0') ? nl - buf + 1 : nl - buf - 1;
+
+      const char *cr = static_cast<const char *> (std::memchr (buf, '\r',
+                                                              len));
+
+      if (cr)
+        {
+          int pos = cr - buf;
+          int rest = len - pos - 1;
+
+          bool crlf = false;
+
+          if (rest == 0)
+            {
+              int c = std::fgetc (f);
+
+              if (c == '\n')
+                crlf = true;
+              else if (c != EOF)
+                std::ungetc (c, f);
+            }
+          else if (rest == 1 && buf[pos+1] == '\n')
+            crlf = true;
+          else
+            octave_fseeko_wrapper (f, -rest, SEEK_CUR);
+
+          line.append (buf, pos);
+          char_count += pos + 1;
+
+          if (! strip_newline)
+            line += '\r';
+
+          if (crlf)
+            {
+              char_count++;
+
+              if (! strip_newline)
+                line += '\n';
+            }
+
+          break;
+        }
+
+      char_count += len;
+
+      if (buf[len-1] == '\n')
+        {
+          line.append (buf, strip_newline ? len - 1 : len);
+          break;
+        }
+
+      line.append (buf, len);
+
+      if (max_len > 0 && char_count == max_len)
+        break;
+    }
+
+  return char_count;
+}
+
 int
 c_file_ptr_buf::file_close (FILE *f)
 {
@@ -28,6 +28,7 @@ along with Octave; see the file COPYING.  If not, see
 #include <cstdio>
 
 #include <streambuf>
+#include <string>
 
 class
 c_file_ptr_buf : public std::streambuf
@@ -41,7 +42,7 @@ public:
   FILE* stdiofile (void) { return f; }
 
   c_file_ptr_buf (FILE *f_arg, close_fcn cf_arg = file_close)
-    : std::streambuf (), f (f_arg), cf (cf_arg)
+    : std::streambuf (), f (f_arg), cf (cf_arg), seek_state (-1)
   { }
 
   ~c_file_ptr_buf (void);
@@ -78,6 +79,11 @@ public:
 
   void clear (void) { if (f) clearerr (f); }
 
+  bool seekable (void);
+
+  int read_line (std::string& line, int max_len, bool strip_newline,
+                 bool& at_eof, bool& read_err);
+
   static int file_close (FILE *f);
 
 protected:
@@ -88,6 +94,9 @@ protected:
 
 private:
 
+  // 1 if F is known to be seekable, 0 if it is not, -1 if unknown.
+  int seek_state;
+
   int_type underflow_common (bool);
 
   // No copying!
@@ -31,6 +31,7 @@ along with Octave; see the file COPYING.  If not, see
 #include <vector>
 #include <list>
 #include <memory>
+#include <set>
 
 #include "caseless-str.h"
 #include "lo-mappers.h"
@@ -39,6 +40,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "Cell.h"
 #include "oct-map.h"
 #include "defun.h"
+#include "error.h"
 #include "parse.h"
 #include "variables.h"
 #include "unwind-prot.h"
@@ -63,6 +65,14 @@ along with Octave; see the file COPYING.  If not, see
 #include "ov-uint8.h"
 
 #include "ov-fcn-handle.h"
+#include "ov-usr-fcn.h"
+#include "pt-arg-list.h"
+#include "pt-binop.h"
+#include "pt-id.h"
+#include "pt-idx.h"
+#include "pt-misc.h"
+#include "pt-unop.h"
+#include "symtab.h"
 
 static octave_value_list
 get_output_list (octave_idx_type count, octave_idx_type nargout,
@@ -993,6 +1003,293 @@ v = cellfun (@@det, a); # faster
 %!error cellfun (@sin, {[]}, "ErrorHandler")
 */
 
+// Arrayfun calls an anonymous function once for each element of its
+// arguments.  If the body of the function only applies element-wise
+// operations to the arguments and to real scalars, calling it once
+// with the whole arrays gives the same result.  The operations must
+// compute each element exactly as they would for scalars, so matrix
+// operators, powers, and mappers that switch to complex arithmetic for
+// some arguments (like sqrt and log) are not included.
+
+static bool
+is_elementwise_builtin (const std::string& name, int nargs)
+{
+  static const char *unary_fcns[] =
+  {
+    "abs", "asinh", "atan", "ceil", "conj", "cos", "cosh", "erf", "erfc",
+    "exp", "expm1", "fix", "floor", "imag", "isfinite", "isinf", "isnan",
+    "real", "round", "sign", "sin", "sinh", "tan", "tanh", 0
+  };
+
+  static const char *binary_fcns[] =
+  {
+    "atan2", "hypot", "mod", "rem", 0
+  };
+
+  const char **names = (nargs == 1 ? unary_fcns
+                        : (nargs == 2 ? binary_fcns : 0));
+
+  if (! names)
+    return false;
+
+  for (int i = 0; names[i]; i++)
+    {
+      if (name == names[i])
+        {
+          octave_value fcn = symbol_table::find_function (name);
+
+          return fcn.is_defined () && fcn.is_builtin_function ();
+        }
+    }
+
+  return false;
+}
+
+static bool
+is_real_full_array (const octave_value& val)
+{
+  return ((val.is_numeric_type () || val.is_bool_type ())
+          && val.is_real_type () && ! val.is_sparse_type ()
+          && ! val.is_diag_matrix () && ! val.is_perm_matrix ());
+}
+
+// TRUE if EXPR is a real scalar constant or a variable captured by the
+// anonymous function (which is checked to be a real scalar).
+
+static bool
+is_scalar_operand (tree_expression *expr,
+                   const std::set<std::string>& params)
+{
+  if (expr->is_constant ())
+    return expr->rvalue1 ().numel () == 1;
+  else if (expr->is_identifier ())
+    {
+      tree_identifier *id = dynamic_cast<tree_identifier *> (expr);
+
+      return params.find (id->name ()) == params.end ();
+    }
+
+  return false;
+}
+
+static bool
+is_elementwise_expr (tree_expression *expr,
+                     const std::set<std::string>& params,
+                     symbol_table::scope_id scope)
+{
+  if (expr->is_constant ())
+    {
+      octave_value val = expr->rvalue1 ();
+
+      return val.numel () == 1 && is_real_full_array (val);
+    }
+  else if (expr->is_identifier ())
+    {
+      tree_identifier *id = dynamic_cast<tree_identifier *> (expr);
+
+      std::string nm = id->name ();
+
+      if (params.find (nm) != params.end ())
+        return true;
+
+      octave_value val = symbol_table::varval (nm, scope, 0);
+
+      return (val.is_defined () && val.numel () == 1
+              && is_real_full_array (val));
+    }
+  else if (expr->is_binary_expression ())
+    {
+      if (expr->is_boolean_expression ())
+        return false;
+
+      tree_binary_expression *binop
+        = dynamic_cast<tree_binary_expression *> (expr);
+
+      tree_expression *lhs = binop->lhs ();
+      tree_expression *rhs = binop->rhs ();
+
+      switch (binop->op_type ())
+        {
+        case octave_value::op_add:
+        case octave_value::op_sub:
+        case octave_value::op_el_mul:
+        case octave_value::op_el_div:
+        case octave_value::op_el_ldiv:
+        case octave_value::op_lt:
+        case octave_value::op_le:
+        case octave_value::op_eq:
+        case octave_value::op_ge:
+        case octave_value::op_gt:
+        case octave_value::op_ne:
+        case octave_value::op_el_and:
+        case octave_value::op_el_or:
+          break;
+
+        case octave_value::op_mul:
+          if (! (is_scalar_operand (lhs, params)
+                 || is_scalar_operand (rhs, params)))
+            return false;
+          break;
+
+        case octave_value::op_div:
+          if (! is_scalar_operand (rhs, params))
+            return false;
+          break;
+
+        default:
+          return false;
+        }
+
+      return (is_elementwise_expr (lhs, params, scope)
+              && is_elementwise_expr (rhs, params, scope));
+    }
+  else if (expr->is_prefix_expression ())
+    {
+      tree_prefix_expression *unop
+        = dynamic_cast<tree_prefix_expression *> (expr);
+
+      switch (unop->op_type ())
+        {
+        case octave_value::op_not:
+        case octave_value::op_uplus:
+        case octave_value::op_uminus:
+          return is_elementwise_expr (unop->operand (), params, scope);
+
+        default:
+          return false;
+        }
+    }
+  else if (expr->is_index_expression ())
+    {
+      tree_index_expression *idx_expr
+        = dynamic_cast<tree_index_expression *> (expr);
+
+      tree_expression *fcn_expr = idx_expr->expression ();
+
+      if (! fcn_expr->is_identifier () || idx_expr->type_tags () != "(")
+        return false;
+
+      std::string nm = dynamic_cast<tree_identifier *> (fcn_expr)->name ();
+
+      if (params.find (nm) != params.end ()
+          || symbol_table::varval (nm, scope, 0).is_defined ())
+        return false;
+
+      tree_argument_list *arg_list = idx_expr->arg_lists ().front ();
+
+      if (! arg_list || ! is_elementwise_builtin (nm, arg_list->length ()))
+        return false;
+
+      for (tree_argument_list::iterator p = arg_list->begin ();
+           p != arg_list->end (); p++)
+        {
+          if (! is_elementwise_expr (*p, params, scope))
+            return false;
+        }
+
+      return true;
+    }
+
+  return false;
+}
+
+// Try to evaluate FUNC for all elements of the NARGIN arrays in INPUTS
+// (which have dimensions FDIMS or a single element) at once.  Return
+// false if that is not possible or not known to give the same result
+// as calling FUNC for each element.
+
+static bool
+try_elementwise_eval (octave_value& func, const octave_value *inputs,
+                      int nargin, int nargout, const dim_vector& fdims,
+                      octave_value_list& retval)
+{
+  if (! func.is_function_handle ())
+    return false;
+
+  octave_value fcn = func.fcn_handle_value ()->fcn_val ();
+
+  octave_user_function *uf = fcn.user_function_value (true);
+
+  if (! uf || ! uf->is_anonymous_function () || ! uf->is_special_expr ())
+    return false;
+
+  tree_parameter_list *param_list = uf->parameter_list ();
+
+  if (! param_list || param_list->takes_varargs ()
+      || param_list->length () != static_cast<size_t> (nargin))
+    return false;
+
+  std::set<std::string> params;
+
+  for (tree_parameter_list::iterator p = param_list->begin ();
+       p != param_list->end (); p++)
+    params.insert ((*p)->name ());
+
+  tree_expression *expr = uf->special_expr ();
+
+  if (! expr || ! is_elementwise_expr (expr, params, uf->scope ()))
+    return false;
+
+  octave_value_list args (nargin, octave_value ());
+
+  for (int j = 0; j < nargin; j++)
+    {
+      if (! is_real_full_array (inputs[j]))
+        return false;
+
+      // Ranges compute their elements the same way when indexed, but
+      // operations on them might not.
+
+      if (inputs[j].is_range ())
+        args(j) = inputs[j].array_value ();
+      else
+        args(j) = inputs[j];
+    }
+
+  octave_value_list tmp;
+
+  octave::unwind_protect frame;
+
+  frame.protect_var (discard_error_messages);
+  frame.protect_var (discard_warning_messages);
+
+  discard_error_messages = true;
+  discard_warning_messages = true;
+
+  size_t num_warnings = warning_count ();
+
+  try
+    {
+      tmp = func.do_multi_index_op (nargout, args);
+    }
+  catch (const octave_execution_exception&)
+    {
+      // Let the element-wise evaluation report the error.
+
+      recover_from_exception ();
+
+      return false;
+    }
+
+  // Likewise for warnings, which the element-wise evaluation issues
+  // once for each element instead of once for the whole array.
+
+  if (warning_count () != num_warnings || tmp.empty ())
+    return false;
+
+  octave_value val = tmp(0);
+
+  if (! (val.is_defined () && val.dims () == fdims
+         && (val.is_numeric_type () || val.is_bool_type ())
+         && ! val.is_sparse_type () && ! val.is_diag_matrix ()
+         && ! val.is_perm_matrix ()))
+    return false;
+
+  retval = ovl (val);
+
+  return true;
+}
+
 // Arrayfun was originally a .m file written by Bill Denney and Jaroslav
 // Hajek.  It was converted to C++ by jwe so that it could properly
 // handle the nargout = 0 case.
@@ -1196,10 +1493,24 @@ arrayfun (@@str2num, [1234],
 
       // Collect arguments.  Pre-fill scalar elements of inputlist array.
 
+      // Elements of full numeric and logical arrays can be extracted
+      // without indexing.  Others, like the elements of character
+      // strings, cell arrays, and sparse, diagonal, and permutation
+      // matrices and ranges, must keep the type that indexing gives
+      // them.
+
+      OCTAVE_LOCAL_BUFFER (bool, fast_extract, nargin);
+
       for (int j = 0; j < nargin; j++)
         {
           inputs[j] = args(j+1);
           mask[j] = inputs[j].numel () != 1;
+          fast_extract[j] = ((inputs[j].is_numeric_type ()
+                              || inputs[j].is_bool_type ())
+                             && ! (inputs[j].is_sparse_type ()
+                                   || inputs[j].is_diag_matrix ()
+                                   || inputs[j].is_perm_matrix ()
+                                   || inputs[j].is_range ()));
 
           if (! mask[j])
             inputlist(j) = inputs[j];
@@ -1222,6 +1533,12 @@ arrayfun (@@str2num, [1234],
             }
         }
 
+      if (uniform_output && nargout <= 1 && k > 1
+          && ! error_handler.is_defined ()
+          && try_elementwise_eval (func, inputs, nargin, nargout, fdims,
+                                   retval))
+        return retval;
+
       octave::unwind_protect frame;
       frame.protect_var (buffer_error_messages);
 
@@ -1245,7 +1562,16 @@ arrayfun (@@str2num, [1234],
               for (int j = 0; j < nargin; j++)
                 {
                   if (mask[j])
-                    inputlist.xelem (j) = inputs[j].do_index_op (idx_list);
+                    {
+                      octave_value val;
+
+                      if (fast_extract[j])
+                        val = inputs[j].fast_elem_extract (count);
+
+                      inputlist.xelem (j) = (val.is_defined ()
+                                             ? val
+                                             : inputs[j].do_index_op (idx_list));
+                    }
                 }
 
               const octave_value_list tmp
@@ -1337,7 +1663,16 @@ arrayfun (@@str2num, [1234],
               for (int j = 0; j < nargin; j++)
                 {
                   if (mask[j])
-                    inputlist.xelem (j) = inputs[j].do_index_op (idx_list);
+                    {
+                      octave_value val;
+
+                      if (fast_extract[j])
+                        val = inputs[j].fast_elem_extract (count);
+
+                      inputlist.xelem (j) = (val.is_defined ()
+                                             ? val
+                                             : inputs[j].do_index_op (idx_list));
+                    }
                 }
 
               const octave_value_list tmp
@@ -1595,6 +1930,45 @@ arrayfun (@@str2num, [1234],
 %! assert ([(isfield (A(1), "index")), (isfield (A(2), "index"))], [true, true]);
 %! assert ([(isempty (A(1).message)), (isempty (A(2).message))], [false, false]);
 %! assert ([A(1).index, A(2).index], [1, 2]);
+
+## Element-wise anonymous functions are evaluated on whole arrays
+%!test
+%! a = 2;
+%! x = [1, 2; 3, 4];
+%! A = arrayfun (@(x, y) a*x + y ./ 4 - (x > 1) + abs (-x), x, 1);
+%! B = zeros (2, 2);
+%! for k = 1:4
+%!   B(k) = a*x(k) + 1 ./ 4 - (x(k) > 1) + abs (-x(k));
+%! endfor
+%! assert (A, B);
+%!test
+%! r = 0.1:0.1:0.5;
+%! A = arrayfun (@(x) x * 3, r);
+%! B = zeros (1, 5);
+%! for k = 1:5
+%!   B(k) = r(k) * 3;
+%! endfor
+%! assert (A, B);
+%!assert (arrayfun (@(x) x * x, [1, 2, 3]), [1, 4, 9])
+%!assert (arrayfun (@(x) x + 1, int8 ([126, 127])), int8 ([127, 127]))
+%!assert (arrayfun (@(x) ! x, [0, 1, 2]), [true, false, false])
+%!assert (arrayfun (@(x) x, "ab", "UniformOutput", false), {"a", "b"})
+%!error <binary operator> arrayfun (@(x) x + int16 (1), int8 ([1, 2]))
+
+## Elements of sparse matrices and ranges keep the type indexing gives
+%!assert (arrayfun (@issparse, sparse ([1, 2])), [true, true])
+%!test
+%! A = arrayfun (@(x) x, sparse ([1, 0, 2]), "UniformOutput", false);
+%! assert (A, {sparse(1), sparse(0), sparse(2)});
+%! assert (all (cellfun (@issparse, A)));
+%!assert (arrayfun (@(x) isa (x, "double"), 1:3), [true, true, true])
+
+## Warnings are issued for each element
+%!test
+%! warning ("on", "Octave:divide-by-zero", "local");
+%! str = evalc ("y = arrayfun (@(x) x / 0, [1, 2, 3]);");
+%! assert (y, [Inf, Inf, Inf]);
+%! assert (numel (strfind (str, "division by zero")), 3);
 */
 
 static void
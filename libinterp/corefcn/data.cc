@@ -1940,8 +1940,23 @@ do_cat (const octave_value_list& xargs, int dim, std::string fname)
 
       bool first_elem_is_struct = false;
 
+      int last_type_id = -1;
+
       for (int i = 0; i < n_args; i++)
         {
+          // Arguments of the same type as the previous one, as in
+          // vertcat (c{:}), do not change the result type or the flags
+          // below.  The class name of objects may differ for the same
+          // type.
+
+          int type_id = args(i).type_id ();
+
+          if (type_id == last_type_id)
+            continue;
+
+          last_type_id = ((args(i).is_object () || args(i).is_java ())
+                          ? -1 : type_id);
+
           if (i == 0)
             {
               result_type = args(i).class_name ();
@@ -52,6 +52,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "ovl.h"
 #include "pager.h"
 #include "procstream.h"
+#include "symtab.h"
 #include "sysdep.h"
 #include "toplev.h"
 #include "unwind-prot.h"
@@ -76,6 +77,7 @@ octave_change_to_directory (const std::string& newdir)
     error ("%s: %s", newdir.c_str (), std::strerror (errno));
 
   Vlast_chdir_time.stamp ();
+  fcn_table_generation++;
 
   // FIXME: should these actions be handled as a list of functions
   // to call so users can add their own chdir handlers?
@@ -88,6 +88,10 @@ static std::string Vlast_warning_message;
 // The last warning message id.
 static std::string Vlast_warning_id;
 
+// The number of warnings issued so far, including those that were
+// disabled.
+static size_t Vwarning_count = 0;
+
 // The last error message id.
 static std::string Vlast_error_id;
 
@@ -690,6 +694,8 @@ warning_enabled (const std::string& id)
 static void
 warning_1 (const char *id, const char *fmt, va_list args)
 {
+  Vwarning_count++;
+
   int warn_opt = warning_enabled (id);
 
   if (warn_opt == 2)
@@ -2177,6 +2183,12 @@ last_warning_id (void)
   return Vlast_warning_id;
 }
 
+size_t
+warning_count (void)
+{
+  return Vwarning_count;
+}
+
 void
 interpreter_try (octave::unwind_protect& frame)
 {
@@ -171,6 +171,10 @@ extern OCTINTERP_API octave_map last_error_stack (void);
 extern OCTINTERP_API std::string last_warning_message (void);
 extern OCTINTERP_API std::string last_warning_id (void);
 
+// The number of calls to warning functions so far, whether or not the
+// warning was enabled.
+extern OCTINTERP_API size_t warning_count (void);
+
 extern OCTINTERP_API void interpreter_try (octave::unwind_protect&);
 
 #endif
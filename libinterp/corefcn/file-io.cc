@@ -431,6 +431,78 @@ Returns the number of lines skipped (end-of-line sequences encountered).
     return ovl ();
 }
 
+DEFUN (fgetlines, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn  {} {@var{c} =} fgetlines (@var{fid})
+@deftypefnx {} {@var{c} =} fgetlines (@var{fid}, @var{count})
+@deftypefnx {} {@var{c} =} fgetlines (@var{fid}, Inf)
+Read @var{count} lines from the file specified by the file descriptor
+@var{fid} and return them as a column cell array of strings.
+
+Lines may be terminated by LF, CRLF, or CR.  As with @code{fgetl}, the
+line endings are not included in the strings that are returned.
+
+If @var{count} is omitted or is @code{Inf}, lines are read until the end of
+the file.  Fewer than @var{count} lines are returned if the end of the file
+is reached first.  If there are no more lines to read, @code{fgetlines}
+returns an empty cell array.
+
+Reading a block of lines with a single call to @code{fgetlines} is much
+faster than reading them one at a time by calling @code{fgetl} in a loop.
+@seealso{fgetl, fgets, fskipl, textscan, fopen}
+@end deftypefn */)
+{
+  static std::string who = "fgetlines";
+
+  int nargin = args.length ();
+
+  if (nargin < 1 || nargin > 2)
+    print_usage ();
+
+  octave_stream os = octave_stream_list::lookup (args(0), who);
+
+  octave_value count_arg = (nargin == 2) ? args(1) : octave_value ();
+
+  bool err = false;
+
+  Cell tmp = os.getlines (count_arg, err, who);
+
+  if (! err)
+    return ovl (tmp);
+  else
+    return ovl (Cell (0, 1));
+}
+
+/*
+%!test
+%! f = tempname ();
+%! fid = fopen (f, "w+");
+%! unwind_protect
+%!   fprintf (fid, "one\ntwo\r\nthree\rfour\n\nsix");
+%!   frewind (fid);
+%!   c = fgetlines (fid, 2);
+%!   assert (c, {"one"; "two"});
+%!   assert (fgetl (fid), "three");
+%!   c = fgetlines (fid);
+%!   assert (c, {"four"; ""; "six"});
+%!   assert (feof (fid));
+%!   assert (fgetlines (fid), cell (0, 1));
+%!   frewind (fid);
+%!   assert (fgets (fid), "one\n");
+%!   assert (fgets (fid), "two\r\n");
+%!   assert (fgets (fid, 3), "thr");
+%!   assert (fgets (fid), "ee\r");
+%!   assert (fskipl (fid, Inf), 2);
+%!   assert (fgetl (fid), -1);
+%! unwind_protect_cleanup
+%!   fclose (fid);
+%!   unlink (f);
+%! end_unwind_protect
+
+%!error fgetlines ()
+%!error <invalid number of lines> fgetlines (stdin, -1)
+*/
+
 static octave_stream
 do_stream_open (const std::string& name, const std::string& mode_arg,
                 const std::string& arch, int& fid)
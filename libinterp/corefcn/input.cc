@@ -192,6 +192,7 @@ static inline std::string
 interactive_input (const std::string& s, bool& eof)
 {
   Vlast_prompt_time.stamp ();
+  fcn_table_generation++;
 
   if (Vdrawnow_requested && interactive)
     {
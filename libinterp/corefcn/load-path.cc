@@ -31,6 +31,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "file-ops.h"
 #include "file-stat.h"
 #include "oct-env.h"
+#include "oct-perf-counters.h"
 #include "pathsearch.h"
 #include "singleton-cleanup.h"
 
@@ -41,6 +42,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "ov-usr-fcn.h"
 #include "pager.h"
 #include "parse.h"
+#include "symtab.h"
 #include "toplev.h"
 #include "unwind-prot.h"
 #include "utils.h"
@@ -967,6 +969,8 @@ load_path::do_update (void) const
   // preserve the correct directory ordering for new files that
   // have appeared.
 
+  octave::perf_counters::increment (octave::perf_counters::load_path_rescans);
+
   default_loader.clear ();
 
   loader_map.clear ();
@@ -2277,6 +2281,7 @@ rehash_internal (void)
 
   // This will force updated functions to be found.
   Vlast_prompt_time.stamp ();
+  fcn_table_generation++;
 }
 
 DEFUN (rehash, , ,
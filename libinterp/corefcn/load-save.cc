@@ -47,6 +47,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "mach-info.h"
 #include "oct-env.h"
 #include "oct-locbuf.h"
+#include "oct-probes.h"
 #include "oct-time.h"
 #include "quit.h"
 #include "str-vec.h"
@@ -522,6 +523,22 @@ find_file_to_load (const std::string& name, const std::string& orig_name)
   return fname;
 }
 
+#if defined (ENABLE_PROBES)
+
+static void
+probe_load_return (const char *fname)
+{
+  OCTAVE_PROBE1 (load__return, fname);
+}
+
+static void
+probe_save_return (const char *fname)
+{
+  OCTAVE_PROBE1 (save__return, fname);
+}
+
+#endif
+
 bool
 is_octave_data_file (const std::string& fname)
 {
@@ -720,6 +737,12 @@ Force Octave to assume the file is in Octave's text format.
   else
     i--;
 
+#if defined (ENABLE_PROBES)
+  OCTAVE_PROBE1 (load__entry, orig_fname.c_str ());
+  octave::unwind_protect frame;
+  frame.add_fcn (probe_load_return, orig_fname.c_str ());
+#endif
+
   octave::mach_info::float_format flt_fmt = octave::mach_info::flt_fmt_unknown;
 
   bool swap = false;
@@ -1602,6 +1625,12 @@ the file @file{data} in Octave's binary format.
 
   octave_value_list retval;
 
+#if defined (ENABLE_PROBES)
+  OCTAVE_PROBE1 (save__entry, argv[i].c_str ());
+  octave::unwind_protect frame;
+  frame.add_fcn (probe_save_return, argv[i].c_str ());
+#endif
+
   if (argv[i] == "-")
     {
       i++;
@@ -0,0 +1,214 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <string>
+
+#include "lo-ieee.h"
+#include "oct-mem-stats.h"
+#include "physmem-wrappers.h"
+
+#include "defun.h"
+#include "oct-map.h"
+#include "ov.h"
+#include "ovl.h"
+#include "pager.h"
+
+// Return the resident memory of the Octave process in bytes, or NaN if
+// it is not known.
+
+static double
+process_resident_bytes (void)
+{
+  std::ifstream is ("/proc/self/status");
+
+  std::string key;
+
+  while (is >> key)
+    {
+      if (key == "VmRSS:")
+        {
+          double kb;
+
+          if (is >> kb)
+            return kb * 1024;
+
+          break;
+        }
+
+      is.ignore (std::numeric_limits<std::streamsize>::max (), '\n');
+    }
+
+  return octave_NaN;
+}
+
+static void
+print_bytes (std::ostream& os, const char *label, double bytes)
+{
+  os << "  " << std::left << std::setw (40) << label << std::right;
+
+  if (lo_ieee_isnan (bytes))
+    os << std::setw (12) << "unknown";
+  else
+    os << std::fixed << std::setprecision (1) << std::setw (12)
+       << bytes / (1024 * 1024) << " MiB";
+
+  os << "\n";
+}
+
+DEFUN (memory, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn  {} {} memory ()
+@deftypefnx {} {[@var{userdata}, @var{systemdata}] =} memory ()
+Display or return information about the memory used by Octave.
+
+If called with no output arguments, print a summary of the memory used by
+the data of Octave's arrays and values and of the memory of the Octave
+process and of the system.
+
+The structure @var{userdata} contains the following fields, all in bytes
+except @code{NumCopies}:
+
+@table @code
+@item MaxPossibleArrayBytes
+@itemx MemAvailableAllArrays
+The physical memory that is available for new data.
+
+@item MemUsedMATLAB
+The resident memory of the Octave process.
+
+@item MemUsedArrays
+The memory currently used for the data of arrays and for values.
+
+@item PeakMemUsedArrays
+The largest value of @code{MemUsedArrays} since Octave started.
+
+@item TotalMemAllocated
+@itemx TotalMemFreed
+The memory allocated and freed for arrays and values since Octave started.
+
+@item NumCopies
+@itemx CopiedBytes
+The number of arrays and the number of bytes that were copied because
+their data was shared with another variable when it was modified.
+@end table
+
+The structure @var{systemdata} contains the fields @code{PhysicalMemory}, a
+structure with the fields @code{Available} and @code{Total}, and
+@code{SystemMemory}, a structure with the field @code{Available}.
+
+Values that are not available on the current system are set to NaN@.  Use
+@code{profile} to find the functions and lines that allocate memory.
+@seealso{profile, whos, getrusage}
+@end deftypefn */)
+{
+  if (args.length () != 0)
+    print_usage ();
+
+  double phys_total = octave_physmem_total_wrapper ();
+  double phys_avail = octave_physmem_available_wrapper ();
+  double resident = process_resident_bytes ();
+
+  double live = octave::memory_stats::live ();
+  double peak = octave::memory_stats::peak ();
+  double allocated = octave::memory_stats::allocated ();
+  double freed = octave::memory_stats::freed ();
+  double copies = octave::memory_stats::copies ();
+  double copied = octave::memory_stats::copied ();
+
+  if (nargout == 0)
+    {
+      std::ostream& os = octave_stdout;
+
+      os << "\n";
+      print_bytes (os, "Arrays and values in use:", live);
+      print_bytes (os, "Arrays and values peak:", peak);
+      print_bytes (os, "Total allocated:", allocated);
+      print_bytes (os, "Total freed:", freed);
+      print_bytes (os, "Copied when modifying shared arrays:", copied);
+      os << "  " << std::left << std::setw (40) << "Number of copies:"
+         << std::right << std::setw (12) << copies << "\n\n";
+      print_bytes (os, "Octave process (resident):", resident);
+      print_bytes (os, "Physical memory available:", phys_avail);
+      print_bytes (os, "Physical memory total:", phys_total);
+      os << "\n";
+
+      return ovl ();
+    }
+
+  octave_scalar_map user;
+
+  user.assign ("MaxPossibleArrayBytes", phys_avail);
+  user.assign ("MemAvailableAllArrays", phys_avail);
+  user.assign ("MemUsedMATLAB", resident);
+  user.assign ("MemUsedArrays", live);
+  user.assign ("PeakMemUsedArrays", peak);
+  user.assign ("TotalMemAllocated", allocated);
+  user.assign ("TotalMemFreed", freed);
+  user.assign ("NumCopies", copies);
+  user.assign ("CopiedBytes", copied);
+
+  octave_scalar_map physical;
+
+  physical.assign ("Available", phys_avail);
+  physical.assign ("Total", phys_total);
+
+  octave_scalar_map system_mem;
+
+  system_mem.assign ("Available", phys_avail);
+
+  octave_scalar_map sys;
+
+  sys.assign ("PhysicalMemory", physical);
+  sys.assign ("SystemMemory", system_mem);
+
+  return ovl (user, sys);
+}
+
+/*
+%!test
+%! [u, s] = memory ();
+%! assert (fieldnames (u), {"MaxPossibleArrayBytes"; "MemAvailableAllArrays"; "MemUsedMATLAB"; "MemUsedArrays"; "PeakMemUsedArrays"; "TotalMemAllocated"; "TotalMemFreed"; "NumCopies"; "CopiedBytes"});
+%! assert (fieldnames (s), {"PhysicalMemory"; "SystemMemory"});
+%! assert (u.MemUsedArrays > 0);
+%! assert (u.PeakMemUsedArrays >= u.MemUsedArrays);
+%! assert (u.TotalMemAllocated - u.TotalMemFreed, u.MemUsedArrays);
+
+%!test
+%! u0 = memory ();
+%! x = zeros (1e6, 1);
+%! u1 = memory ();
+%! assert (u1.MemUsedArrays - u0.MemUsedArrays >= 8e6);
+%! y = x;
+%! y(1) = 1;
+%! u2 = memory ();
+%! assert (u2.NumCopies > u1.NumCopies);
+%! assert (u2.CopiedBytes - u1.CopiedBytes >= 8e6);
+
+%!error memory (1)
+*/
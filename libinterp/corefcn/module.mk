@@ -192,6 +192,7 @@ COREFCN_SRC = \
   libinterp/corefcn/mappers.cc \
   libinterp/corefcn/matrix_type.cc \
   libinterp/corefcn/max.cc \
+  libinterp/corefcn/memory.cc \
   libinterp/corefcn/mex.cc \
   libinterp/corefcn/mgorth.cc \
   libinterp/corefcn/nproc.cc \
@@ -223,6 +224,7 @@ COREFCN_SRC = \
   libinterp/corefcn/rcond.cc \
   libinterp/corefcn/regexp.cc \
   libinterp/corefcn/schur.cc \
+  libinterp/corefcn/setfcns.cc \
   libinterp/corefcn/sighandlers.cc \
   libinterp/corefcn/sparse-xdiv.cc \
   libinterp/corefcn/sparse-xpow.cc \
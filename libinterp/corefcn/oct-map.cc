@@ -184,6 +184,16 @@ octave_scalar_map::setfield (const std::string& k, const octave_value& val)
     xvals.push_back (val);
 }
 
+void
+octave_scalar_map::setfield (octave_field_cache& fc, const octave_value& val)
+{
+  octave_idx_type idx = fc.index (xkeys);
+  if (idx >= 0)
+    xvals[idx] = val;
+  else
+    setfield (fc.name (), val);
+}
+
 void
 octave_scalar_map::rmfield (const std::string& k)
 {
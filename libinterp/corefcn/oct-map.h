@@ -147,6 +147,41 @@ public:
   }
 };
 
+// A field name together with the index of that field in the set of
+// fields in which it was last looked up.  Looking the name up again in
+// the same set of fields (as determined by octave_fields::is_same) does
+// not require a search.  Keeping a reference to the fields also means
+// that they can't be changed in place while they are cached.
+
+class OCTINTERP_API
+octave_field_cache
+{
+public:
+
+  octave_field_cache (const std::string& name = "")
+    : xname (name), xfields (), xindex (-1) { }
+
+  const std::string& name (void) const { return xname; }
+
+  // get index of field in FIELDS.  return -1 if not exist
+  octave_idx_type index (const octave_fields& fields)
+  {
+    if (! fields.is_same (xfields))
+      {
+        xindex = fields.getfield (xname);
+        xfields = fields;
+      }
+
+    return xindex;
+  }
+
+private:
+
+  std::string xname;
+  octave_fields xfields;
+  octave_idx_type xindex;
+};
+
 class OCTINTERP_API
 octave_scalar_map
 {
@@ -218,8 +253,17 @@ public:
   // get contents of a given field.  empty value if not exist.
   octave_value getfield (const std::string& key) const;
 
+  // get contents of a given field using a cached index.  empty value
+  // if not exist.
+  octave_value getfield (octave_field_cache& fc) const
+  {
+    octave_idx_type idx = fc.index (xkeys);
+    return (idx >= 0) ? xvals[idx] : octave_value ();
+  }
+
   // set contents of a given field.  add if not exist.
   void setfield (const std::string& key, const octave_value& val);
+  void setfield (octave_field_cache& fc, const octave_value& val);
   void assign (const std::string& k, const octave_value& val)
   { setfield (k, val); }
 
@@ -27,6 +27,7 @@ along with Octave; see the file COPYING.  If not, see
 
 #include <cassert>
 #include <cctype>
+#include <cstdio>
 #include <cstring>
 
 #include <deque>
@@ -35,6 +36,7 @@ along with Octave; see the file COPYING.  If not, see
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "Array.h"
 #include "Cell.h"
@@ -43,6 +45,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "lo-mappers.h"
 #include "lo-utils.h"
 #include "oct-locbuf.h"
+#include "oct-probes.h"
 #include "quit.h"
 #include "singleton-cleanup.h"
 #include "str-vec.h"
@@ -4008,13 +4011,32 @@ octave_base_stream::do_gets (octave_idx_type max_len, bool& err,
     {
       std::istream& is = *isp;
 
-      std::ostringstream buf;
+      std::string line;
 
-      int c = 0;
       int char_count = 0;
 
-      if (max_len != 0)
+      // For files read through the C stdio library, scan for line
+      // endings a block at a time.
+
+      c_file_ptr_buf *fb = dynamic_cast<c_file_ptr_buf *> (is.rdbuf ());
+
+      if (fb && is && max_len != 0 && fb->seekable ())
         {
+          bool at_eof = false;
+          bool read_err = false;
+
+          char_count = fb->read_line (line, max_len, strip_newline,
+                                      at_eof, read_err);
+
+          if (read_err)
+            is.setstate (std::ios::badbit);
+          else if (at_eof)
+            is.setstate (std::ios::eofbit | std::ios::failbit);
+        }
+      else if (max_len != 0)
+        {
+          int c = 0;
+
           while (is && (c = is.get ()) != std::istream::traits_type::eof ())
             {
               char_count++;
@@ -4023,7 +4045,7 @@ octave_base_stream::do_gets (octave_idx_type max_len, bool& err,
               if (c == '\r')
                 {
                   if (! strip_newline)
-                    buf << static_cast<char> (c);
+                    line += static_cast<char> (c);
 
                   c = is.get ();
 
@@ -4034,7 +4056,7 @@ octave_base_stream::do_gets (octave_idx_type max_len, bool& err,
                           char_count++;
 
                           if (! strip_newline)
-                            buf << static_cast<char> (c);
+                            line += static_cast<char> (c);
                         }
                       else
                         is.putback (c);
@@ -4045,12 +4067,12 @@ octave_base_stream::do_gets (octave_idx_type max_len, bool& err,
               else if (c == '\n')
                 {
                   if (! strip_newline)
-                    buf << static_cast<char> (c);
+                    line += static_cast<char> (c);
 
                   break;
                 }
               else
-                buf << static_cast<char> (c);
+                line += static_cast<char> (c);
 
               if (max_len > 0 && char_count == max_len)
                 break;
@@ -4068,7 +4090,7 @@ octave_base_stream::do_gets (octave_idx_type max_len, bool& err,
         }
 
       if (is.good () || (is.eof () && char_count > 0))
-        retval = buf.str ();
+        retval = line;
       else
         {
           err = true;
@@ -4152,6 +4174,71 @@ octave_base_stream::skipl (off_t num, bool& err, const std::string& who)
   return cnt;
 }
 
+// Read up to MAX_LINES lines (all remaining lines if MAX_LINES is
+// negative) and return them, without line endings, as a column cell
+// array of strings.  Reaching the end of the file is not an error.
+
+Cell
+octave_base_stream::getlines (octave_idx_type max_lines, bool& err,
+                              const std::string& who)
+{
+  Cell retval;
+
+  err = false;
+
+  std::istream *isp = input_stream ();
+
+  if (! isp)
+    {
+      err = true;
+      invalid_operation (who, "reading");
+    }
+  else
+    {
+      std::istream& is = *isp;
+
+      std::list<std::string> lines;
+
+      octave_idx_type n = 0;
+
+      while (max_lines < 0 || n < max_lines)
+        {
+          octave_quit ();
+
+          if (! is || is.peek () == std::istream::traits_type::eof ())
+            break;
+
+          std::string line = do_gets (-1, err, true, who);
+
+          if (err)
+            break;
+
+          lines.push_back (line);
+
+          n++;
+        }
+
+      if (is.bad ())
+        {
+          err = true;
+          error (who, "read error");
+        }
+
+      if (! err)
+        {
+          retval.resize (dim_vector (n, 1));
+
+          octave_idx_type i = 0;
+
+          for (std::list<std::string>::const_iterator p = lines.begin ();
+               p != lines.end (); p++)
+            retval(i++) = *p;
+        }
+    }
+
+  return retval;
+}
+
 template <typename T>
 std::istream&
 octave_scan_1 (std::istream& is, const scanf_format_elt& fmt, T* valptr)
@@ -5695,6 +5782,370 @@ octave_base_stream::do_numeric_printf_conv (std::ostream& os,
   return retval;
 }
 
+// A printf_format_list compiled for the common case of printing
+// arrays of real numeric values.  Each conversion is expanded once
+// into the C formats that would otherwise be rebuilt for every element
+// (integer, %g fallback, and Inf/NaN variants).  Values are read
+// directly from the numeric data and formatted into a reusable buffer
+// that is written to the stream in large blocks.
+//
+// Only formats without '*' width or precision arguments and without
+// %s, %c, or %p conversions are handled.  All arguments must be
+// non-empty, real, non-sparse numeric or logical arrays whose values
+// are exactly representable as doubles.  Anything else falls back to
+// the general element-by-element code in do_printf.
+
+class
+printf_numeric_plan
+{
+public:
+
+  printf_numeric_plan (printf_format_list& fmt_list,
+                       const octave_value_list& args);
+
+  ~printf_numeric_plan (void) { }
+
+  bool ok (void) const { return valid; }
+
+  operator bool () const { return ok (); }
+
+  int format (std::ostream& os);
+
+private:
+
+  struct plan_elt
+  {
+    plan_elt (void)
+      : text (), int_fmt (), g_fmt (), nonfinite_fmt (), type ('\0'),
+        args (0), plus_flag (false)
+    { }
+
+    // Literal text, or the original C-style format for a conversion.
+    std::string text;
+
+    // Format with the "long" modifier inserted for integer conversions.
+    std::string int_fmt;
+
+    // Format to use for integer conversions of non-integer values.
+    std::string g_fmt;
+
+    // Format to use for Inf and NaN values.
+    std::string nonfinite_fmt;
+
+    char type;
+
+    int args;
+
+    bool plus_flag;
+  };
+
+  void append_text (std::ostream& os, const std::string& s);
+
+  template <typename T>
+  void append_conv (std::ostream& os, const std::string& fmt, T arg);
+
+  void append_value (std::ostream& os, const plan_elt& elt, double val);
+
+  void flush (std::ostream& os);
+
+  bool valid;
+
+  octave_idx_type nconv;
+
+  std::vector<plan_elt> elts;
+
+  std::vector<NDArray> values;
+
+  // Output buffer and the number of characters currently in it.
+  std::vector<char> buf;
+  size_t pos;
+
+  // Total number of characters formatted.
+  size_t count;
+
+  // No copying!
+
+  printf_numeric_plan (const printf_numeric_plan&);
+
+  printf_numeric_plan& operator = (const printf_numeric_plan&);
+};
+
+printf_numeric_plan::printf_numeric_plan (printf_format_list& fmt_list,
+                                          const octave_value_list& args)
+  : valid (false), nconv (fmt_list.num_conversions ()), elts (), values (),
+    buf (), pos (0), count (0)
+{
+  if (nconv <= 0 || args.length () == 0)
+    return;
+
+  for (octave_idx_type i = 0; i < args.length (); i++)
+    {
+      const octave_value& val = args(i);
+
+      if (val.is_empty () || val.is_string () || val.is_sparse_type ()
+          || ! val.is_real_type ()
+          || ! (val.is_double_type () || val.is_single_type ()
+                || val.is_bool_type () || val.is_integer_type ())
+          || val.is_int64_type () || val.is_uint64_type ())
+        return;
+    }
+
+  static std::string llmod
+    = sizeof (long) == sizeof (int64_t) ? "l" : "ll";
+
+  for (const printf_format_elt *elt = fmt_list.first (); elt;
+       elt = fmt_list.next (false))
+    {
+      if (elt->fw == -2 || elt->prec == -2)
+        return;
+
+      plan_elt pe;
+
+      pe.type = elt->type;
+      pe.args = elt->args;
+      pe.text = elt->text ? elt->text : "";
+
+      switch (elt->type)
+        {
+        case '%':
+          pe.text = "%";
+          break;
+
+        case 'd': case 'i': case 'o': case 'x': case 'X': case 'u':
+          pe.int_fmt = pe.text;
+          pe.int_fmt.replace (pe.int_fmt.rfind (elt->type), 1,
+                              llmod + elt->type);
+          pe.g_fmt = switch_to_g_format (elt);
+          // Fall through...
+
+        case 'f': case 'e': case 'E': case 'g': case 'G':
+          {
+            pe.plus_flag = elt->flags.find ('+') != std::string::npos;
+
+            std::string tfmt = pe.text;
+            std::string::size_type i1, i2;
+
+            tfmt.replace ((i1 = tfmt.rfind (elt->type)), 1, 1, 's');
+
+            if ((i2 = tfmt.rfind ('.')) != std::string::npos && i2 < i1)
+              tfmt.erase (i2, i1-i2);
+
+            pe.nonfinite_fmt = tfmt;
+          }
+          break;
+
+        default:
+          if (elt->args > 0)
+            return;
+          break;
+        }
+
+      elts.push_back (pe);
+    }
+
+  fmt_list.first ();
+
+  if (elts.empty ())
+    return;
+
+  values.reserve (args.length ());
+
+  for (octave_idx_type i = 0; i < args.length (); i++)
+    values.push_back (args(i).array_value ());
+
+  buf.resize (65536);
+
+  valid = true;
+}
+
+void
+printf_numeric_plan::flush (std::ostream& os)
+{
+  if (pos > 0)
+    {
+      os.write (&buf[0], pos);
+      pos = 0;
+    }
+}
+
+void
+printf_numeric_plan::append_text (std::ostream& os, const std::string& s)
+{
+  size_t len = s.length ();
+
+  if (len > buf.size () - pos)
+    {
+      flush (os);
+
+      if (len > buf.size ())
+        {
+          os << s;
+          count += len;
+          return;
+        }
+    }
+
+  std::copy (s.begin (), s.end (), buf.begin () + pos);
+
+  pos += len;
+  count += len;
+}
+
+template <typename T>
+void
+printf_numeric_plan::append_conv (std::ostream& os, const std::string& fmt,
+                                  T arg)
+{
+  size_t avail = buf.size () - pos;
+
+  int n = snprintf (&buf[pos], avail, fmt.c_str (), arg);
+
+  if (n < 0)
+    return;
+
+  if (static_cast<size_t> (n) >= avail)
+    {
+      flush (os);
+
+      if (static_cast<size_t> (n) >= buf.size ())
+        buf.resize (n + 1);
+
+      n = snprintf (&buf[0], buf.size (), fmt.c_str (), arg);
+
+      if (n < 0)
+        return;
+    }
+
+  pos += n;
+  count += n;
+}
+
+void
+printf_numeric_plan::append_value (std::ostream& os, const plan_elt& elt,
+                                   double val)
+{
+  if (lo_ieee_isnan (val) || lo_ieee_isinf (val))
+    {
+      const char *tval;
+
+      if (lo_ieee_isinf (val))
+        {
+          if (elt.plus_flag)
+            tval = (val < 0 ? "-Inf" : "+Inf");
+          else
+            tval = (val < 0 ? "-Inf" : "Inf");
+        }
+      else
+        {
+          if (elt.plus_flag)
+            tval = (lo_ieee_is_NA (val) ? "+NA" : "+NaN");
+          else
+            tval = (lo_ieee_is_NA (val) ? "NA" : "NaN");
+        }
+
+      append_conv (os, elt.nonfinite_fmt, tval);
+
+      return;
+    }
+
+  switch (elt.type)
+    {
+    case 'd': case 'i':
+      {
+        uint64_t limit = std::numeric_limits<int64_t>::max ();
+
+        if (val == octave::math::round (val) && val <= limit)
+          append_conv (os, elt.int_fmt, octave_int64 (val).value ());
+        else
+          append_conv (os, elt.g_fmt, val);
+      }
+      break;
+
+    case 'o': case 'x': case 'X': case 'u':
+      {
+        uint64_t limit = std::numeric_limits<uint64_t>::max ();
+
+        if (val == octave::math::round (val) && val >= 0 && val <= limit)
+          append_conv (os, elt.int_fmt, octave_uint64 (val).value ());
+        else
+          append_conv (os, elt.g_fmt, val);
+      }
+      break;
+
+    default:
+      append_conv (os, elt.text, val);
+      break;
+    }
+}
+
+int
+printf_numeric_plan::format (std::ostream& os)
+{
+  size_t n_elts = elts.size ();
+  size_t n_vals = values.size ();
+
+  size_t k = 0;
+
+  size_t val_idx = 0;
+  const double *data = values[0].data ();
+  octave_idx_type n = values[0].numel ();
+  octave_idx_type j = 0;
+
+  bool exhausted = false;
+
+  for (;;)
+    {
+      const plan_elt& elt = elts[k];
+
+      if (elt.args == 0)
+        append_text (os, elt.text);
+      else
+        {
+          if (exhausted)
+            break;
+
+          append_value (os, elt, data[j++]);
+
+          if (j == n)
+            {
+              if (++val_idx < n_vals)
+                {
+                  data = values[val_idx].data ();
+                  n = values[val_idx].numel ();
+                  j = 0;
+                }
+              else
+                exhausted = true;
+            }
+        }
+
+      if (pos >= buf.size () / 2)
+        {
+          flush (os);
+
+          if (! os)
+            break;
+
+          octave_quit ();
+        }
+
+      if (++k == n_elts)
+        {
+          if (nconv > 0 && ! exhausted)
+            k = 0;
+          else
+            break;
+        }
+
+      if (exhausted && elts[k].args > 0)
+        break;
+    }
+
+  flush (os);
+
+  return count;
+}
+
 int
 octave_base_stream::do_printf (printf_format_list& fmt_list,
                                const octave_value_list& args,
@@ -5712,6 +6163,18 @@ octave_base_stream::do_printf (printf_format_list& fmt_list,
     {
       std::ostream& os = *osp;
 
+      printf_numeric_plan plan (fmt_list, args);
+
+      if (plan)
+        {
+          retval = plan.format (os);
+
+          if (! os)
+            error ("%s: write error", who.c_str ());
+
+          return retval;
+        }
+
       const printf_format_elt *elt = fmt_list.first ();
 
       printf_value_cache val_cache (args, who);
@@ -6034,6 +6497,48 @@ octave_stream::skipl (const octave_value& tc_count, bool& err,
   return skipl (count, err, who);
 }
 
+Cell
+octave_stream::getlines (octave_idx_type max_lines, bool& err,
+                         const std::string& who)
+{
+  Cell retval;
+
+  if (stream_ok ())
+    retval = rep->getlines (max_lines, err, who);
+
+  return retval;
+}
+
+Cell
+octave_stream::getlines (const octave_value& tc_max_lines, bool& err,
+                         const std::string& who)
+{
+  err = false;
+
+  int conv_err = 0;
+
+  octave_idx_type max_lines = -1;
+
+  if (tc_max_lines.is_defined ())
+    {
+      if (tc_max_lines.is_scalar_type ()
+          && octave::math::isinf (tc_max_lines.scalar_value ()))
+        max_lines = -1;
+      else
+        {
+          max_lines = convert_to_valid_int (tc_max_lines, conv_err);
+
+          if (conv_err || max_lines < 0)
+            {
+              err = true;
+              ::error ("%s: invalid number of lines specified", who.c_str ());
+            }
+        }
+    }
+
+  return getlines (max_lines, err, who);
+}
+
 int
 octave_stream::seek (off_t offset, int origin)
 {
@@ -6609,6 +7114,8 @@ octave_stream::read (const Array<double>& size, octave_idx_type block_size,
 
       retval = finalize_read (input_buf_list, input_buf_elts, count,
                               nr, nc, input_type, output_type, ffmt);
+
+      OCTAVE_PROBE2 (stream__read, file_number (), char_count);
     }
 
   return retval;
@@ -6800,6 +7307,8 @@ octave_stream::write_bytes (const void *data, size_t nbytes)
 
       if (os)
         {
+          OCTAVE_PROBE2 (stream__write, file_number (), nbytes);
+
           os.write (static_cast<const char *> (data), nbytes);
 
           if (os)
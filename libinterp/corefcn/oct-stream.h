@@ -189,6 +189,9 @@ private:
                     const std::string& who /* = "gets" */);
   off_t skipl (off_t count, bool& err, const std::string& who /* = "skipl" */);
 
+  Cell getlines (octave_idx_type max_lines, bool& err,
+                 const std::string& who /* = "getlines" */);
+
   octave_value do_scanf (scanf_format_list& fmt_list, octave_idx_type nr,
                          octave_idx_type nc,
                          bool one_elt_size_spec, octave_idx_type& count,
@@ -267,6 +270,11 @@ public:
   off_t skipl (const octave_value& count, bool& err,
                const std::string& who /* = "skipl" */);
 
+  Cell getlines (octave_idx_type max_lines, bool& err,
+                 const std::string& who /* = "getlines" */);
+  Cell getlines (const octave_value& max_lines, bool& err,
+                 const std::string& who /* = "getlines" */);
+
   int seek (off_t offset, int origin);
   int seek (const octave_value& offset, const octave_value& origin);
 
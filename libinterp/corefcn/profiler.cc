@@ -27,15 +27,19 @@ along with Octave; see the file COPYING.  If not, see
 
 #include <iostream>
 
+#include "oct-mem-stats.h"
+#include "oct-perf-counters.h"
+#include "time-wrappers.h"
+
 #include "defun.h"
-#include "oct-time.h"
 #include "ov-struct.h"
 #include "pager.h"
 #include "profiler.h"
+#include "sighandlers.h"
 
 profile_data_accumulator::stats::stats ()
   : time (0.0), calls (0), recursive (false),
-    parents (), children ()
+    parents (), children (), lines (), mem ()
 {}
 
 octave_value
@@ -55,8 +59,30 @@ profile_data_accumulator::stats::function_set_value (const function_set& list)
   return retval;
 }
 
+octave_value
+profile_data_accumulator::line_map_value (const line_map& lines)
+{
+  Matrix retval (lines.size (), 7);
+
+  octave_idx_type i = 0;
+  for (line_map::const_iterator p = lines.begin (); p != lines.end (); ++p)
+    {
+      retval(i,0) = p->first;
+      retval(i,1) = p->second.calls;
+      retval(i,2) = p->second.time;
+      retval(i,3) = p->second.mem.allocated;
+      retval(i,4) = p->second.mem.freed;
+      retval(i,5) = p->second.mem.peak;
+      retval(i,6) = p->second.mem.copies;
+      ++i;
+    }
+
+  return retval;
+}
+
 profile_data_accumulator::tree_node::tree_node (tree_node* p, octave_idx_type f)
-  : parent (p), fcn_id (f), children (), time (0.0), calls (0)
+  : parent (p), fcn_id (f), children (), time (0.0), calls (0),
+    lines (), current_line (0), mem ()
 {}
 
 profile_data_accumulator::tree_node::~tree_node ()
@@ -66,7 +92,7 @@ profile_data_accumulator::tree_node::~tree_node ()
 }
 
 profile_data_accumulator::tree_node*
-profile_data_accumulator::tree_node::enter (octave_idx_type fcn)
+profile_data_accumulator::tree_node::child (octave_idx_type fcn)
 {
   tree_node* retval;
 
@@ -79,6 +105,17 @@ profile_data_accumulator::tree_node::enter (octave_idx_type fcn)
   else
     retval = pos->second;
 
+  return retval;
+}
+
+profile_data_accumulator::tree_node*
+profile_data_accumulator::tree_node::enter (octave_idx_type fcn)
+{
+  tree_node* retval = child (fcn);
+
+  // Time until the first statement is not attributed to any line.
+  retval->current_line = 0;
+
   ++retval->calls;
   return retval;
 }
@@ -94,6 +131,22 @@ profile_data_accumulator::tree_node::exit (octave_idx_type /* fcn */)
   return parent;
 }
 
+void
+profile_data_accumulator::tree_node::add_samples (unsigned n, double dt,
+                                                  int line)
+{
+  time += dt;
+  calls += n;
+
+  if (line > 0)
+    {
+      line_stats& stats = lines[line];
+
+      stats.time += dt;
+      stats.calls += n;
+    }
+}
+
 void
 profile_data_accumulator::tree_node::build_flat (flat_profile& data) const
 {
@@ -104,6 +157,16 @@ profile_data_accumulator::tree_node::build_flat (flat_profile& data) const
 
       entry.time += time;
       entry.calls += calls;
+      entry.mem.add (mem);
+
+      for (line_map::const_iterator p = lines.begin (); p != lines.end (); ++p)
+        {
+          line_stats& line = entry.lines[p->first];
+
+          line.time += p->second.time;
+          line.calls += p->second.calls;
+          line.mem.add (p->second.mem);
+        }
 
       assert (parent);
       if (parent->fcn_id != 0)
@@ -174,9 +237,18 @@ profile_data_accumulator::tree_node::get_hierarchical (double* total) const
   return retval;
 }
 
+const size_t profile_data_accumulator::max_history_events = 1 << 22;
+
+const sig_atomic_t profile_data_accumulator::tick_mask;
+
+volatile sig_atomic_t profile_data_accumulator::sample_ticks = 0;
+
 profile_data_accumulator::profile_data_accumulator ()
   : known_functions (), fcn_index (),
-    enabled (false), call_tree (0), last_time (-1.0)
+    enabled (false), call_tree (0), active_fcn (0), last_time (-1.0),
+    history (), start_time (-1.0), sample_interval (0.0), frames (),
+    ticks_seen (0), saved_sigprof_handler (0), last_allocated (0),
+    last_freed (0), last_copies (0)
 {}
 
 profile_data_accumulator::~profile_data_accumulator ()
@@ -185,6 +257,18 @@ profile_data_accumulator::~profile_data_accumulator ()
     delete call_tree;
 }
 
+void
+profile_data_accumulator::set_sample_interval (double interval)
+{
+  if (is_active ())
+    error ("profiler: can't change the sampling interval while active");
+
+  if (interval < 0)
+    error ("profiler: sampling interval must not be negative");
+
+  sample_interval = interval;
+}
+
 void
 profile_data_accumulator::set_active (bool value)
 {
@@ -197,9 +281,20 @@ profile_data_accumulator::set_active (bool value)
       // Let the top-node be the active one.  This ensures we have a clean
       // fresh start collecting times.
       active_fcn = call_tree;
+
+      add_current_memory ();
+
+      if (start_time < 0.0)
+        start_time = query_time ();
+
+      if (sample_interval > 0 && ! enabled)
+        start_sampling ();
     }
   else
     {
+      if (is_sampling ())
+        stop_sampling ();
+
       // Make sure we start with fresh timing if we're re-enabled later.
       last_time = -1.0;
     }
@@ -207,6 +302,23 @@ profile_data_accumulator::set_active (bool value)
   enabled = value;
 }
 
+octave_idx_type
+profile_data_accumulator::function_index (const std::string& fcn)
+{
+  octave_idx_type fcn_idx;
+  fcn_index_map::iterator pos = fcn_index.find (fcn);
+  if (pos == fcn_index.end ())
+    {
+      known_functions.push_back (fcn);
+      fcn_idx = known_functions.size ();
+      fcn_index[fcn] = fcn_idx;
+    }
+  else
+    fcn_idx = pos->second;
+
+  return fcn_idx;
+}
+
 void
 profile_data_accumulator::enter_function (const std::string& fcn)
 {
@@ -219,21 +331,15 @@ profile_data_accumulator::enter_function (const std::string& fcn)
   if (active_fcn != call_tree)
     add_current_time ();
 
+  add_current_memory ();
+
   // Map the function's name to its index.
-  octave_idx_type fcn_idx;
-  fcn_index_map::iterator pos = fcn_index.find (fcn);
-  if (pos == fcn_index.end ())
-    {
-      known_functions.push_back (fcn);
-      fcn_idx = known_functions.size ();
-      fcn_index[fcn] = fcn_idx;
-    }
-  else
-    fcn_idx = pos->second;
+  octave_idx_type fcn_idx = function_index (fcn);
 
   active_fcn = active_fcn->enter (fcn_idx);
   last_time = query_time ();
 
+  add_history_event (false, fcn_idx);
 }
 
 void
@@ -246,9 +352,13 @@ profile_data_accumulator::exit_function (const std::string& fcn)
 
   // Usually, if we are disabled this function is not even called.  But the
   // call disabling the profiler is an exception.  So also check here
-  // and only record the time if enabled.
-  if (is_active ())
-    add_current_time ();
+  // and only record the time if enabled.  Blocks entered before the
+  // profiler was switched to sampling mode have no time to record.
+  if (is_active () && ! is_sampling ())
+    {
+      add_current_time ();
+      add_current_memory ();
+    }
 
   fcn_index_map::iterator pos = fcn_index.find (fcn);
   // FIXME: This assert statements doesn't make sense if profile() is called
@@ -259,6 +369,96 @@ profile_data_accumulator::exit_function (const std::string& fcn)
   // If this was an "inner call", we resume executing the parent function
   // up the stack.  So note the start-time for this!
   last_time = query_time ();
+
+  add_history_event (true, pos->second);
+}
+
+void
+profile_data_accumulator::time_statement (int line)
+{
+  // Statements at the top level are not part of any function.
+  if (active_fcn == call_tree || line <= 0)
+    return;
+
+  // Read the clock only once per statement.
+  const double t = query_time ();
+
+  active_fcn->add_time (t - last_time);
+  add_current_memory ();
+  active_fcn->enter_line (line);
+
+  last_time = t;
+}
+
+void
+profile_data_accumulator::sigprof_handler (int)
+{
+  sample_ticks = (sample_ticks + 1) & tick_mask;
+}
+
+void
+profile_data_accumulator::take_samples (void)
+{
+  const sig_atomic_t ticks = sample_ticks;
+
+  unsigned n = ((static_cast<unsigned> (ticks)
+                - static_cast<unsigned> (ticks_seen))
+               & static_cast<unsigned> (tick_mask));
+
+  ticks_seen = ticks;
+
+  // Ticks may still arrive after sampling was stopped.
+  if (! is_sampling ())
+    return;
+
+  tree_node *node = call_tree;
+
+  for (std::vector<sample_frame>::const_iterator p = frames.begin ();
+       p != frames.end (); ++p)
+    {
+      std::string fcn = p->name (p->obj);
+
+      // See the note about bug #39524 in the enter class.
+      if (! fcn.empty ())
+        node = node->child (function_index (fcn));
+    }
+
+  // Time spent at the top level is not part of any function.
+  if (node != call_tree)
+    node->add_samples (n, n * sample_interval, frames.back ().line);
+}
+
+void
+profile_data_accumulator::start_sampling (void)
+{
+  long usec = static_cast<long> (sample_interval * 1e6 + 0.5);
+
+  if (usec < 1)
+    usec = 1;
+
+  ticks_seen = sample_ticks;
+
+  saved_sigprof_handler = octave::set_signal_handler ("SIGPROF",
+                                                      sigprof_handler);
+
+  if (octave_set_profiling_timer_wrapper (usec) < 0)
+    {
+      octave::set_signal_handler ("SIGPROF", saved_sigprof_handler);
+
+      error ("profiler: sampling is not supported on this system");
+    }
+}
+
+void
+profile_data_accumulator::stop_sampling (void)
+{
+  // Count the ticks of the profiler call itself.
+  if (sample_ticks != ticks_seen)
+    take_samples ();
+
+  octave_set_profiling_timer_wrapper (0);
+
+  octave::set_signal_handler ("SIGPROF", saved_sigprof_handler);
 }
 
 void
@@ -270,6 +470,9 @@ profile_data_accumulator::reset (void)
   known_functions.clear ();
   fcn_index.clear ();
 
+  history.clear ();
+  start_time = -1.0;
+
   if (call_tree)
     {
       delete call_tree;
@@ -298,6 +501,11 @@ profile_data_accumulator::get_flat (void) const
       Cell rv_recursive (n, 1);
       Cell rv_parents (n, 1);
       Cell rv_children (n, 1);
+      Cell rv_lines (n, 1);
+      Cell rv_allocated (n, 1);
+      Cell rv_freed (n, 1);
+      Cell rv_peak (n, 1);
+      Cell rv_copies (n, 1);
 
       for (octave_idx_type i = 0; i != n; ++i)
         {
@@ -307,6 +515,11 @@ profile_data_accumulator::get_flat (void) const
           rv_recursive(i) = octave_value (flat[i].recursive);
           rv_parents(i) = stats::function_set_value (flat[i].parents);
           rv_children(i) = stats::function_set_value (flat[i].children);
+          rv_lines(i) = line_map_value (flat[i].lines);
+          rv_allocated(i) = octave_value (flat[i].mem.allocated);
+          rv_freed(i) = octave_value (flat[i].mem.freed);
+          rv_peak(i) = octave_value (flat[i].mem.peak);
+          rv_copies(i) = octave_value (flat[i].mem.copies);
         }
 
       octave_map m;
@@ -317,6 +530,11 @@ profile_data_accumulator::get_flat (void) const
       m.assign ("IsRecursive", rv_recursive);
       m.assign ("Parents", rv_parents);
       m.assign ("Children", rv_children);
+      m.assign ("ExecutedLines", rv_lines);
+      m.assign ("TotalMemAllocated", rv_allocated);
+      m.assign ("TotalMemFreed", rv_freed);
+      m.assign ("PeakMem", rv_peak);
+      m.assign ("NumCopies", rv_copies);
 
       retval = m;
     }
@@ -330,6 +548,11 @@ profile_data_accumulator::get_flat (void) const
         "IsRecursive",
         "Parents",
         "Children",
+        "ExecutedLines",
+        "TotalMemAllocated",
+        "TotalMemFreed",
+        "PeakMem",
+        "NumCopies",
         0
       };
 
@@ -367,14 +590,36 @@ profile_data_accumulator::get_hierarchical (void) const
   return retval;
 }
 
+octave_value
+profile_data_accumulator::get_history (void) const
+{
+  const octave_idx_type n = history.size ();
+
+  Matrix retval (3, n);
+
+  for (octave_idx_type i = 0; i < n; i++)
+    {
+      const history_event& evt = history[i];
+
+      retval(0,i) = evt.is_exit;
+      retval(1,i) = evt.fcn_id;
+      retval(2,i) = evt.time;
+    }
+
+  return retval;
+}
+
 double
 profile_data_accumulator::query_time (void) const
 {
-  octave::sys::time now;
+  time_t sec;
+  long nsec;
+
+  octave_monotonic_time_wrapper (&sec, &nsec);
 
   // FIXME: is this volatile declaration really needed?
   // See bug #34210 for additional details.
-  volatile double dnow = now.double_value ();
+  volatile double dnow = sec + 1e-9 * nsec;
 
   return dnow;
 }
@@ -389,9 +634,31 @@ profile_data_accumulator::add_current_time (void)
   active_fcn->add_time (t - last_time);
 }
 
+void
+profile_data_accumulator::add_current_memory (void)
+{
+  memory_usage m;
+
+  m.allocated = octave::memory_stats::allocated () - last_allocated;
+  m.freed = octave::memory_stats::freed () - last_freed;
+  m.copies = octave::memory_stats::copies () - last_copies;
+  m.peak = octave::memory_stats::mark_peak ();
+
+  last_allocated = octave::memory_stats::allocated ();
+  last_freed = octave::memory_stats::freed ();
+  last_copies = octave::memory_stats::copies ();
+
+  octave::memory_stats::reset_mark_peak ();
+
+  if (active_fcn && active_fcn != call_tree)
+    active_fcn->add_memory (m);
+}
+
 profile_data_accumulator profiler;
 
-// Enable or disable the profiler data collection.
+// Enable or disable the profiler data collection.  The optional second
+// argument is the sampling interval in seconds, or 0 for timing every
+// call.
 DEFUN (__profiler_enable__, args, ,
        doc: /* -*- texinfo -*-
 @deftypefn {} {} __profiler_enable__ ()
@@ -400,10 +667,25 @@ Undocumented internal function.
 {
   int nargin = args.length ();
 
-  if (nargin > 1)
+  if (nargin > 2)
     print_usage ();
 
-  if (nargin > 0)
+  if (nargin > 1)
+    {
+      bool state = args(0).bool_value ();
+
+      double interval
+        = args(1).xdouble_value ("__profiler_enable__: INTERVAL must be a number");
+
+      if (state)
+        {
+          profiler.set_active (false);
+          profiler.set_sample_interval (interval);
+        }
+
+      profiler.set_active (state);
+    }
+  else if (nargin > 0)
     profiler.set_active (args(0).bool_value ());
 
   return ovl (profiler.is_active ());
@@ -434,9 +716,149 @@ Undocumented internal function.
   if (args.length () > 0)
     warning ("profiler_data: ignoring extra arguments");
 
-  if (nargout > 1)
+  if (nargout > 2)
+    return ovl (profiler.get_flat (), profiler.get_hierarchical (),
+                profiler.get_history ());
+  else if (nargout > 1)
     return ovl (profiler.get_flat (), profiler.get_hierarchical ());
   else
     return ovl (profiler.get_flat ());
 }
 
+
+static octave_scalar_map
+perf_counter_values (void)
+{
+  octave_scalar_map retval;
+
+  for (int i = 0; i < octave::perf_counters::num_counters; i++)
+    {
+      octave::perf_counters::counter_id id
+        = static_cast<octave::perf_counters::counter_id> (i);
+
+      retval.setfield (octave::perf_counters::name (id),
+                       static_cast<double> (octave::perf_counters::value (id)));
+    }
+
+  return retval;
+}
+
+// Query or reset the counters of expensive interpreter events.
+DEFUN (__perf_counters__, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn  {} {@var{c} =} __perf_counters__ ()
+@deftypefnx {} {@var{c} =} __perf_counters__ ("reset")
+Return a structure with the number of times that events which are
+expensive for the interpreter have occurred since Octave was started or
+the counters were last reset.
+
+The fields are
+
+@table @code
+@item cow_copies
+Copies of the data of an array that was shared with another variable
+when it was modified.
+
+@item idx_conversions
+Conversions of numeric values to index vectors.
+
+@item binary_op_conversions
+Conversions of an operand of a binary operator to another type to find
+the operator.
+
+@item load_path_rescans
+Rescans of the directories in the load path.
+
+@item fcn_lookup_misses
+Function lookups that failed before rescanning the load path.
+
+@item chunk_allocations
+Heap allocations of temporary buffers.
+
+@item fftw_plans
+FFTW plans that were created.
+@end table
+
+With the argument @qcode{"reset"}, set all counters to zero, returning
+their previous values if an output is requested.
+
+The counters are meant for tests that check that an operation does not
+do more of this work than expected, which is more reliable than timing
+it.
+@end deftypefn */)
+{
+  int nargin = args.length ();
+
+  if (nargin > 1)
+    print_usage ();
+
+  octave_scalar_map retval = perf_counter_values ();
+
+  if (nargin == 1)
+    {
+      std::string opt
+        = args(0).xstring_value ("__perf_counters__: argument must be a string");
+
+      if (opt != "reset")
+        error ("__perf_counters__: unrecognized option '%s'", opt.c_str ());
+
+      octave::perf_counters::reset ();
+
+      if (nargout == 0)
+        return ovl ();
+    }
+
+  return ovl (retval);
+}
+
+/*
+%!test
+%! c = __perf_counters__ ();
+%! assert (fieldnames (c), {"cow_copies"; "idx_conversions";
+%!                          "binary_op_conversions"; "load_path_rescans";
+%!                          "fcn_lookup_misses"; "chunk_allocations";
+%!                          "fftw_plans"});
+
+%!test
+%! x = zeros (10, 1);
+%! __perf_counters__ ("reset");
+%! y = x;
+%! y(1) = 1;
+%! c = __perf_counters__ ();
+%! assert (c.cow_copies >= 1);
+%! assert (c.idx_conversions >= 1);
+
+%!test
+%! x = zeros (10, 1);
+%! x(1) = 1;
+%! __perf_counters__ ("reset");
+%! x(2) = 2;
+%! c = __perf_counters__ ();
+%! assert (c.cow_copies, 0);
+
+%!test
+%! a = true;
+%! __perf_counters__ ("reset");
+%! b = a + a;
+%! c = __perf_counters__ ();
+%! assert (c.binary_op_conversions >= 1);
+
+%!test
+%! __perf_counters__ ("reset");
+%! try
+%!   __no_such_function_for_perf_counters__ ();
+%! end_try_catch
+%! c = __perf_counters__ ();
+%! assert (c.fcn_lookup_misses >= 1);
+%! assert (c.load_path_rescans >= 1);
+
+%!test
+%! __perf_counters__ ("reset");
+%! c = __perf_counters__ ("reset");
+%! assert (isstruct (c));
+%! c = __perf_counters__ ();
+%! assert (all (structfun (@(x) x, c) < 10));
+
+%!error __perf_counters__ (1, 2)
+%!error <unrecognized option> __perf_counters__ ("foo")
+*/
@@ -26,6 +26,7 @@ along with Octave; see the file COPYING.  If not, see
 
 #include "octave-config.h"
 
+#include <csignal>
 #include <cstddef>
 #include <map>
 #include <set>
@@ -49,11 +50,27 @@ public:
     profile_data_accumulator& acc;
     std::string fcn;
     bool is_active;
+    bool is_sampled;
+
+    static std::string frame_name (const void *obj)
+    {
+      return static_cast<const T *> (obj)->profiler_name ();
+    }
 
   public:
 
-    enter (profile_data_accumulator& a, const T& t) : acc (a)
+    enter (profile_data_accumulator& a, const T& t)
+      : acc (a), is_active (false), is_sampled (false)
     {
+      // In sampling mode, only note the block on the stack.  Its name
+      // is not needed unless a sample is taken while it is active.
+      if (acc.is_sampling ())
+        {
+          acc.push_frame (&t, frame_name);
+          is_sampled = true;
+          return;
+        }
+
       // A profiling block cannot be active if the profiler is not
       is_active = acc.is_active ();
 
@@ -73,7 +90,9 @@ public:
 
     ~enter ()
     {
-      if (is_active)
+      if (is_sampled)
+        acc.pop_frame ();
+      else if (is_active)
         acc.exit_function (fcn);
     }
 
@@ -90,13 +109,86 @@ public:
   bool is_active (void) const { return enabled; }
   void set_active (bool);
 
+  // TRUE if the profiler is active and samples the call stack at
+  // regular intervals instead of timing every call.
+  bool is_sampling (void) const { return enabled && sample_interval > 0; }
+
+  // Choose between timing every call (INTERVAL = 0) and sampling the
+  // call stack every INTERVAL seconds of CPU time.  The profiler must
+  // not be active.
+  void set_sample_interval (double interval);
+
   void reset (void);
 
   octave_value get_flat (void) const;
   octave_value get_hierarchical (void) const;
 
+  // Get the sequence of function entries and exits, as a 3xN matrix
+  // with the type of each event (0 for entry, 1 for exit), the index
+  // of the function and the time of the event.
+  octave_value get_history (void) const;
+
+  // Note that the statement at LINE of the active function is about to
+  // be executed.  The time until the next statement or call is
+  // attributed to that line.
+  void enter_statement (int line)
+  {
+    if (is_sampling ())
+      {
+        if (sample_ticks != ticks_seen)
+          take_samples ();
+
+        if (! frames.empty ())
+          frames.back ().line = line;
+      }
+    else
+      time_statement (line);
+  }
+
 private:
 
+  // The bytes allocated and freed for arrays and values, the number of
+  // arrays that were copied because their data was shared, and the
+  // largest number of bytes in use.
+  struct memory_usage
+  {
+    memory_usage () : allocated (0), freed (0), copies (0), peak (0) { }
+
+    void add (const memory_usage& m)
+    {
+      allocated += m.allocated;
+      freed += m.freed;
+      copies += m.copies;
+
+      if (m.peak > peak)
+        peak = m.peak;
+    }
+
+    size_t allocated;
+    size_t freed;
+    size_t copies;
+    size_t peak;
+  };
+
+  // The time spent executing one line of a function, the number of
+  // times it was executed, and the memory it used.
+  struct line_stats
+  {
+    line_stats () : time (0.0), calls (0), mem () { }
+
+    double time;
+    unsigned calls;
+
+    memory_usage mem;
+  };
+
+  typedef std::map<int, line_stats> line_map;
+
+  // Convert line statistics to an Octave array with one row for each
+  // line containing the line number, number of calls, time, bytes
+  // allocated and freed, peak bytes, and number of copies.
+  static octave_value line_map_value (const line_map&);
+
   // One entry in the flat profile (i.e., a collection of data for a single
   // function).  This is filled in when building the flat profile from the
   // hierarchical call tree.
@@ -113,6 +205,10 @@ private:
     function_set parents;
     function_set children;
 
+    line_map lines;
+
+    memory_usage mem;
+
     // Convert a function_set list to an Octave array of indices.
     static octave_value function_set_value (const function_set&);
   };
@@ -128,7 +224,28 @@ private:
     tree_node (tree_node*, octave_idx_type);
     virtual ~tree_node ();
 
-    void add_time (double dt) { time += dt; }
+    void add_time (double dt)
+    {
+      time += dt;
+
+      if (current_line)
+        current_line->time += dt;
+    }
+
+    void add_memory (const memory_usage& m)
+    {
+      mem.add (m);
+
+      if (current_line)
+        current_line->mem.add (m);
+    }
+
+    // Start executing the statement at LINE.
+    void enter_line (int line)
+    {
+      current_line = &lines[line];
+      ++current_line->calls;
+    }
 
     // Enter a child function.  It is created in the list of children if it
     // wasn't already there.  The now-active child node is returned.
@@ -139,6 +256,14 @@ private:
     // then-active node, which is our parent.
     tree_node* exit (octave_idx_type);
 
+    // Get the node for a child function, creating it if it doesn't
+    // exist yet.
+    tree_node* child (octave_idx_type);
+
+    // Add N samples taken while executing LINE (if positive) of this
+    // function.  In sampling mode, the call counts are sample counts.
+    void add_samples (unsigned n, double dt, int line);
+
     void build_flat (flat_profile&) const;
 
     // Get the hierarchical profile for this node and its children.  If total
@@ -159,6 +284,13 @@ private:
 
     unsigned calls;
 
+    // Time spent on each line, and the line currently executed (if any).
+    line_map lines;
+    line_stats *current_line;
+
+    // Memory used *directly* on this level, like time.
+    memory_usage mem;
+
     // No copying!
     tree_node (const tree_node&);
     tree_node& operator = (const tree_node&);
@@ -182,15 +314,118 @@ private:
   // Store last timestamp we had, when the currently active function was called.
   double last_time;
 
+  // One entry in the function history.
+  struct history_event
+  {
+    history_event (bool x, octave_idx_type f, double t)
+      : is_exit (x), fcn_id (f), time (t) { }
+
+    bool is_exit;
+    octave_idx_type fcn_id;
+    double time;
+  };
+
+  // The history is limited to this many events so that the profiler
+  // can be left running for a long time.
+  static const size_t max_history_events;
+
+  std::vector<history_event> history;
+
+  // Time when data collection started, used as the origin of the times
+  // in the history.
+  double start_time;
+
+  void add_history_event (bool is_exit, octave_idx_type fcn_id)
+  {
+    if (history.size () < max_history_events)
+      history.push_back (history_event (is_exit, fcn_id,
+                                        last_time - start_time));
+  }
+
+  // Get the index of the function with the given name, adding it to the
+  // known functions if it is new.
+  octave_idx_type function_index (const std::string&);
+
   // These are private as only the unwind-protecting inner class enter
   // should be allowed to call them.
   void enter_function (const std::string&);
   void exit_function (const std::string&);
 
-  // Query a timestamp, used for timing calls (obviously).
-  // This is not static because in the future, maybe we want a flag
-  // in the profiler or something to choose between cputime, wall-time,
-  // user-time, system-time, ...
+  void time_statement (int line);
+
+  // In sampling mode, a SIGPROF handler counts the ticks of a CPU time
+  // timer.  Nothing else is safe to do in a signal handler, and the
+  // handler may even run in another thread, so the samples are taken by
+  // the interpreter itself the next time it enters or leaves a profiling
+  // block or starts a statement.  Until then, the ticks belong to the
+  // current state of the stack, so the samples are not biased by
+  // waiting for this point.  Time spent in compiled code is thus
+  // attributed to the innermost builtin function or operator, and calls
+  // cost only a push or pop on the stack below and a comparison of the
+  // tick counts.
+
+  // One profiling block on the stack.  NAME gets the profiler name of
+  // OBJ, and LINE is the last statement started in the block.
+  struct sample_frame
+  {
+    typedef std::string (*name_fcn) (const void *);
+
+    sample_frame (const void *o, name_fcn n) : obj (o), name (n), line (0) { }
+
+    const void *obj;
+    name_fcn name;
+    int line;
+  };
+
+  // Sampling interval in seconds, or 0 for timing every call.
+  double sample_interval;
+
+  std::vector<sample_frame> frames;
+
+  // The number of SIGPROF signals received, modulo tick_mask + 1.  The
+  // signal handler wraps the count itself, because overflowing a
+  // signed integer would be undefined.  sig_atomic_t is a 32-bit int on
+  // all supported systems.
+
+  static const sig_atomic_t tick_mask = (1 << 30) - 1;
+
+  static volatile sig_atomic_t sample_ticks;
+
+  sig_atomic_t ticks_seen;
+
+  // The handler to restore when sampling stops.
+  void (*saved_sigprof_handler) (int);
+
+  static void sigprof_handler (int);
+
+  void push_frame (const void *obj, sample_frame::name_fcn name)
+  {
+    if (sample_ticks != ticks_seen)
+      take_samples ();
+
+    frames.push_back (sample_frame (obj, name));
+  }
+
+  void pop_frame (void)
+  {
+    if (sample_ticks != ticks_seen)
+      take_samples ();
+
+    frames.pop_back ();
+  }
+
+  // Add the ticks counted since the last sample to the node for the
+  // current stack.
+  void take_samples (void);
+
+  void start_sampling (void);
+  void stop_sampling (void);
+
+  // Query a timestamp, used for timing calls (obviously).  This is a
+  // monotonic clock so that times are not affected by changes of the
+  // system time.  This is not static because in the future, maybe we
+  // want a flag in the profiler or something to choose between cputime,
+  // wall-time, user-time, system-time, ...
   double query_time () const;
 
   // Add the time elapsed since last_time to the function we're currently in.
@@ -198,6 +433,15 @@ private:
   // it as a seperate function.
   void add_current_time (void);
 
+  // The memory counters at the last event.
+  size_t last_allocated;
+  size_t last_freed;
+  size_t last_copies;
+
+  // Add the memory used since the last event to the function we're
+  // currently in (if any) and start counting again.
+  void add_current_memory (void);
+
   // No copying!
   profile_data_accumulator (const profile_data_accumulator&);
   profile_data_accumulator& operator = (const profile_data_accumulator&);
@@ -1129,6 +1129,21 @@ are zero or more @qcode{'b'} characters at positions 1 and end-of-string.
 %! assert (regexprep ('s', '(s)', 'x\$1y'), 'x$1y');
 %! assert (regexprep ('s', '(s)', 'x\\$1y'), 'x\sy');
 
+## Compiled patterns are reused only with the same compile options
+%!test
+%! assert (isempty (regexp ("ABC", "b")));
+%! assert (regexpi ("ABC", "b"), 2);
+%! assert (isempty (regexp ("ABC", "b")));
+%! assert (regexp ("a\nb", "a.b"), 1);
+%! assert (isempty (regexp ("a\nb", "a.b", "dotexceptnewline")));
+%!test
+%! for i = 1:2
+%!   nm = regexp ("short test", '(?<word1>\w*t)\s*(?<word2>\w*t)', "names");
+%!   assert (nm.word1, "short");
+%!   assert (nm.word2, "test");
+%! endfor
+%!assert (regexp ({"ab", "cab", "b"}, "ab"), {1, 2, zeros(1, 0)})
+
 */
 
 DEFUN (regexpi, args, nargout,
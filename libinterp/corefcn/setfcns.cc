@@ -0,0 +1,807 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+// Hash-based kernels for the set functions unique, ismember,
+// intersect, and setdiff.  Instead of sorting all of the input, equal
+// keys are collected into groups using a hash table.  Only the
+// (usually much smaller) set of distinct values is sorted, and then
+// only if sorted output is requested.
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <string>
+#include <vector>
+
+#include "Array.h"
+#include "dNDArray.h"
+#include "lo-mappers.h"
+#include "oct-hash-table.h"
+
+#include "defun.h"
+#include "error.h"
+#include "ov.h"
+#include "ovl.h"
+#include "utils.h"
+
+template <typename T>
+static inline bool
+key_is_nan (const T&)
+{
+  return false;
+}
+
+template <>
+inline bool
+key_is_nan (const double& x)
+{
+  return octave::math::isnan (x);
+}
+
+template <>
+inline bool
+key_is_nan (const float& x)
+{
+  return octave::math::isnan (x);
+}
+
+// Keys that are the elements of an array.
+
+template <typename T>
+class
+elem_keys
+{
+public:
+
+  elem_keys (const Array<T>& a) : arr (a), data (arr.data ()) { }
+
+  octave_idx_type numel (void) const { return arr.numel (); }
+
+  // NaN is not equal to anything, including itself.
+  bool is_valid (octave_idx_type i) const { return ! key_is_nan (data[i]); }
+
+  size_t hash (octave_idx_type i) const
+  {
+    return octave::hash_value (data[i]);
+  }
+
+  bool equal (octave_idx_type i, const elem_keys& other,
+              octave_idx_type j) const
+  {
+    return data[i] == other.data[j];
+  }
+
+private:
+
+  Array<T> arr;
+
+  const T *data;
+};
+
+// Keys that are the rows of a matrix.
+
+template <typename T>
+class
+row_keys
+{
+public:
+
+  row_keys (const Array<T>& a)
+    : arr (a), data (arr.data ()), nr (arr.rows ()),
+      nc (nr > 0 ? arr.numel () / nr : 0)
+  { }
+
+  octave_idx_type numel (void) const { return nr; }
+
+  bool is_valid (octave_idx_type i) const
+  {
+    for (octave_idx_type k = 0; k < nc; k++)
+      {
+        if (key_is_nan (data[i+k*nr]))
+          return false;
+      }
+
+    return true;
+  }
+
+  size_t hash (octave_idx_type i) const
+  {
+    size_t h = 0;
+
+    for (octave_idx_type k = 0; k < nc; k++)
+      h = octave::hash_combine (h, octave::hash_value (data[i+k*nr]));
+
+    return h;
+  }
+
+  bool equal (octave_idx_type i, const row_keys& other,
+              octave_idx_type j) const
+  {
+    if (nc != other.nc)
+      return false;
+
+    for (octave_idx_type k = 0; k < nc; k++)
+      {
+        if (! (data[i+k*nr] == other.data[j+k*other.nr]))
+          return false;
+      }
+
+    return true;
+  }
+
+private:
+
+  Array<T> arr;
+
+  const T *data;
+
+  octave_idx_type nr;
+
+  octave_idx_type nc;
+};
+
+// Keys are collected into groups of equal keys.  Groups are numbered
+// in the order of their first occurrence.
+
+class
+key_groups
+{
+public:
+
+  key_groups (void) : table (), first (), rep (), group () { }
+
+  octave_idx_type numel (void) const { return first.size (); }
+
+  // Groups of valid keys.
+  octave::idx_hash_table table;
+
+  // Index of the first key in each group.
+  std::vector<octave_idx_type> first;
+
+  // Index of the first or last key in each group, as requested.
+  std::vector<octave_idx_type> rep;
+
+  // Group of each key.
+  Array<octave_idx_type> group;
+};
+
+template <typename KEYS>
+class
+key_group_equal
+{
+public:
+
+  key_group_equal (const KEYS& k, octave_idx_type i, const KEYS& gk,
+                   const key_groups& g)
+    : keys (k), idx (i), group_keys (gk), groups (g)
+  { }
+
+  bool operator () (octave_idx_type g) const
+  {
+    return keys.equal (idx, group_keys, groups.first[g]);
+  }
+
+private:
+
+  const KEYS& keys;
+
+  octave_idx_type idx;
+
+  const KEYS& group_keys;
+
+  const key_groups& groups;
+};
+
+template <typename KEYS>
+static void
+group_keys (const KEYS& keys, bool keep_first, key_groups& groups)
+{
+  octave_idx_type n = keys.numel ();
+
+  groups.group.resize (dim_vector (n, 1));
+
+  octave_idx_type *group = groups.group.fortran_vec ();
+
+  for (octave_idx_type i = 0; i < n; i++)
+    {
+      octave_idx_type g = groups.numel ();
+
+      if (keys.is_valid (i))
+        {
+          octave_idx_type k
+            = groups.table.insert (keys.hash (i), g,
+                                   key_group_equal<KEYS> (keys, i, keys,
+                                                          groups));
+
+          if (k >= 0)
+            {
+              group[i] = k;
+
+              if (! keep_first)
+                groups.rep[k] = i;
+
+              continue;
+            }
+        }
+
+      groups.first.push_back (i);
+      groups.rep.push_back (i);
+
+      group[i] = g;
+    }
+}
+
+// Return the group of KEYS_GROUPS that each of KEYS belongs to, or -1
+// if there is no equal key.
+
+template <typename KEYS>
+static Array<octave_idx_type>
+lookup_keys (const KEYS& keys, const KEYS& group_keys,
+             const key_groups& groups)
+{
+  octave_idx_type n = keys.numel ();
+
+  Array<octave_idx_type> retval (dim_vector (n, 1), -1);
+
+  octave_idx_type *result = retval.fortran_vec ();
+
+  for (octave_idx_type i = 0; i < n; i++)
+    {
+      if (keys.is_valid (i))
+        result[i] = groups.table.find (keys.hash (i),
+                                       key_group_equal<KEYS> (keys, i,
+                                                              group_keys,
+                                                              groups));
+    }
+
+  return retval;
+}
+
+
+// The work common to all of the set functions.  Optionally group the
+// keys of A and, if B is given, group the keys of B and find the group
+// of B that each key of A belongs to.
+
+class
+set_job
+{
+public:
+
+  set_job (bool grp_a, bool kf_a, bool kf_b)
+    : group_a (grp_a), keep_first_a (kf_a), keep_first_b (kf_b),
+      groups_a (), groups_b (), a_in_b ()
+  { }
+
+  template <typename KEYS>
+  void run (const KEYS& ka, const KEYS *kb)
+  {
+    if (group_a)
+      group_keys (ka, keep_first_a, groups_a);
+
+    if (kb)
+      {
+        group_keys (*kb, keep_first_b, groups_b);
+
+        a_in_b = lookup_keys (ka, *kb, groups_b);
+      }
+  }
+
+  bool group_a;
+
+  bool keep_first_a;
+
+  bool keep_first_b;
+
+  key_groups groups_a;
+
+  key_groups groups_b;
+
+  Array<octave_idx_type> a_in_b;
+};
+
+template <typename ARRAY_T>
+static void
+run_array_set_job (const octave_value& a, const octave_value& b,
+                   bool by_rows, set_job& job)
+{
+  typedef typename ARRAY_T::element_type T;
+
+  ARRAY_T aa = octave_value_extract<ARRAY_T> (a);
+
+  if (by_rows)
+    {
+      row_keys<T> ka (aa);
+
+      if (b.is_defined ())
+        {
+          row_keys<T> kb (octave_value_extract<ARRAY_T> (b));
+
+          job.run (ka, &kb);
+        }
+      else
+        job.run (ka, static_cast<const row_keys<T> *> (0));
+    }
+  else
+    {
+      elem_keys<T> ka (aa);
+
+      if (b.is_defined ())
+        {
+          elem_keys<T> kb (octave_value_extract<ARRAY_T> (b));
+
+          job.run (ka, &kb);
+        }
+      else
+        job.run (ka, static_cast<const elem_keys<T> *> (0));
+    }
+}
+
+static void
+run_set_job (const char *who, const octave_value& a, const octave_value& b,
+             bool by_rows, set_job& job)
+{
+  if (b.is_defined () && a.class_name () != b.class_name ())
+    error ("%s: A and B must be of the same class", who);
+
+  if (a.is_sparse_type () || a.is_complex_type ()
+      || (b.is_defined () && (b.is_sparse_type () || b.is_complex_type ())))
+    error ("%s: sparse and complex arrays are not supported", who);
+
+  if (by_rows && (a.ndims () > 2 || (b.is_defined () && b.ndims () > 2)))
+    error ("%s: A and B must be 2-dimensional matrices for \"rows\"", who);
+
+  if (a.is_double_type ())
+    run_array_set_job<NDArray> (a, b, by_rows, job);
+  else if (a.is_single_type ())
+    run_array_set_job<FloatNDArray> (a, b, by_rows, job);
+  else if (a.is_bool_type ())
+    run_array_set_job<boolNDArray> (a, b, by_rows, job);
+  else if (a.is_string ())
+    run_array_set_job<charNDArray> (a, b, by_rows, job);
+  else if (a.is_int8_type ())
+    run_array_set_job<int8NDArray> (a, b, by_rows, job);
+  else if (a.is_int16_type ())
+    run_array_set_job<int16NDArray> (a, b, by_rows, job);
+  else if (a.is_int32_type ())
+    run_array_set_job<int32NDArray> (a, b, by_rows, job);
+  else if (a.is_int64_type ())
+    run_array_set_job<int64NDArray> (a, b, by_rows, job);
+  else if (a.is_uint8_type ())
+    run_array_set_job<uint8NDArray> (a, b, by_rows, job);
+  else if (a.is_uint16_type ())
+    run_array_set_job<uint16NDArray> (a, b, by_rows, job);
+  else if (a.is_uint32_type ())
+    run_array_set_job<uint32NDArray> (a, b, by_rows, job);
+  else if (a.is_uint64_type ())
+    run_array_set_job<uint64NDArray> (a, b, by_rows, job);
+  else if (a.is_cellstr () && (b.is_undefined () || b.is_cellstr ()))
+    {
+      if (by_rows)
+        error ("%s: cells not supported with \"rows\"", who);
+
+      elem_keys<std::string> ka (a.cellstr_value ());
+
+      if (b.is_defined ())
+        {
+          elem_keys<std::string> kb (b.cellstr_value ());
+
+          job.run (ka, &kb);
+        }
+      else
+        job.run (ka, static_cast<const elem_keys<std::string> *> (0));
+    }
+  else
+    error ("%s: A must be an array or cell array of strings", who);
+}
+
+// Return the values of X (or rows of X if BY_ROWS is true) selected by
+// the zero-based indices IDX.
+
+static octave_value
+select_keys (octave_value x, bool by_rows,
+             const Array<octave_idx_type>& idx)
+{
+  if (by_rows)
+    return x.do_index_op (ovl (idx_vector (idx), idx_vector::colon));
+  else
+    return x.do_index_op (ovl (idx_vector (idx)));
+}
+
+// Return the order of the groups SEL of X, either the order of their
+// first occurrence or the order of their sorted values.
+
+static Array<octave_idx_type>
+order_groups (const octave_value& x, bool by_rows, const key_groups& g,
+              const Array<octave_idx_type>& sel, bool stable)
+{
+  octave_idx_type n = sel.numel ();
+
+  Array<octave_idx_type> retval (dim_vector (n, 1));
+
+  if (stable)
+    {
+      // Groups are numbered in order of first occurrence.
+      for (octave_idx_type k = 0; k < n; k++)
+        retval(k) = k;
+    }
+  else
+    {
+      Array<octave_idx_type> first (dim_vector (n, 1));
+
+      for (octave_idx_type k = 0; k < n; k++)
+        first(k) = g.first[sel(k)];
+
+      octave_value u = select_keys (x, by_rows, first);
+
+      if (by_rows)
+        retval = u.sort_rows_idx (ASCENDING);
+      else
+        u.reshape (dim_vector (n, 1)).sort (retval, 0, ASCENDING);
+    }
+
+  return retval;
+}
+
+static octave_value
+set_result (const octave_value& x, bool by_rows, bool row_vec,
+            const Array<octave_idx_type>& idx)
+{
+  octave_idx_type n = idx.numel ();
+
+  dim_vector dv;
+
+  if (by_rows)
+    dv = dim_vector (n, x.columns ());
+  else
+    dv = row_vec ? dim_vector (1, n) : dim_vector (n, 1);
+
+  return select_keys (x, by_rows, idx).reshape (dv);
+}
+
+static NDArray
+one_based_index (const Array<octave_idx_type>& idx, bool row_vec)
+{
+  octave_idx_type n = idx.numel ();
+
+  NDArray retval (row_vec ? dim_vector (1, n) : dim_vector (n, 1));
+
+  for (octave_idx_type k = 0; k < n; k++)
+    retval(k) = idx(k) + 1;
+
+  return retval;
+}
+
+static bool
+is_row_vector (const octave_value& x)
+{
+  return x.ndims () == 2 && x.rows () == 1;
+}
+
+// Select the groups of A that are (or are not) matched in B, in the
+// requested order, and return the representative element of each.
+
+static Array<octave_idx_type>
+select_groups (const octave_value& a, bool by_rows, const set_job& job,
+               bool matched, bool stable, Array<octave_idx_type>& b_rep)
+{
+  const key_groups& ga = job.groups_a;
+
+  octave_idx_type ng = ga.numel ();
+
+  std::vector<octave_idx_type> tmp;
+
+  for (octave_idx_type k = 0; k < ng; k++)
+    {
+      if ((job.a_in_b(ga.first[k]) >= 0) == matched)
+        tmp.push_back (k);
+    }
+
+  octave_idx_type n = tmp.size ();
+
+  Array<octave_idx_type> sel (dim_vector (n, 1));
+
+  for (octave_idx_type k = 0; k < n; k++)
+    sel(k) = tmp[k];
+
+  Array<octave_idx_type> perm = order_groups (a, by_rows, ga, sel, stable);
+
+  Array<octave_idx_type> retval (dim_vector (n, 1));
+
+  b_rep.resize (dim_vector (n, 1));
+
+  for (octave_idx_type k = 0; k < n; k++)
+    {
+      octave_idx_type g = sel(perm(k));
+
+      retval(k) = ga.rep[g];
+
+      if (matched)
+        b_rep(k) = job.groups_b.rep[job.a_in_b(ga.first[g])];
+    }
+
+  return retval;
+}
+
+DEFUN (__unique__, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {[@var{y}, @var{i}, @var{j}] =} __unique__ (@var{x}, @var{by_rows}, @var{first}, @var{stable})
+Undocumented internal function.
+@end deftypefn */)
+{
+  if (args.length () != 4)
+    print_usage ();
+
+  octave_value x = args(0);
+
+  bool by_rows = args(1).xbool_value ("__unique__: BY_ROWS must be a logical value");
+  bool first = args(2).xbool_value ("__unique__: FIRST must be a logical value");
+  bool stable = args(3).xbool_value ("__unique__: STABLE must be a logical value");
+
+  set_job job (true, first, first);
+
+  run_set_job ("unique", x, octave_value (), by_rows, job);
+
+  const key_groups& g = job.groups_a;
+
+  octave_idx_type ng = g.numel ();
+
+  Array<octave_idx_type> all (dim_vector (ng, 1));
+
+  for (octave_idx_type k = 0; k < ng; k++)
+    all(k) = k;
+
+  Array<octave_idx_type> perm = order_groups (x, by_rows, g, all, stable);
+
+  Array<octave_idx_type> yidx (dim_vector (ng, 1));
+
+  for (octave_idx_type k = 0; k < ng; k++)
+    yidx(k) = g.rep[perm(k)];
+
+  bool row_vec = ! by_rows && is_row_vector (x);
+
+  octave_value_list retval (nargout > 1 ? nargout : 1);
+
+  retval(0) = set_result (x, by_rows, row_vec, yidx);
+
+  if (nargout > 1)
+    retval(1) = one_based_index (yidx, row_vec);
+
+  if (nargout > 2)
+    {
+      Array<octave_idx_type> inv (dim_vector (ng, 1));
+
+      for (octave_idx_type k = 0; k < ng; k++)
+        inv(perm(k)) = k;
+
+      octave_idx_type n = g.group.numel ();
+
+      Array<octave_idx_type> jidx (dim_vector (n, 1));
+
+      for (octave_idx_type k = 0; k < n; k++)
+        jidx(k) = inv(g.group(k));
+
+      retval(2) = one_based_index (jidx, row_vec);
+    }
+
+  return retval;
+}
+
+/*
+%!test
+%! [y, i, j] = __unique__ ([3, 1, 3, NaN, 2, 1, NaN], false, false, false);
+%! assert (y, [1, 2, 3, NaN, NaN]);
+%! assert (i, [6, 5, 3, 4, 7]);
+%! assert (j, [3, 1, 3, 4, 2, 1, 5]);
+
+%!test
+%! [y, i, j] = __unique__ ([3; 1; 3; 2; 1], false, true, true);
+%! assert (y, [3; 1; 2]);
+%! assert (i, [1; 2; 4]);
+%! assert (j, [1; 2; 1; 3; 2]);
+
+%!test
+%! [y, i, j] = __unique__ ({"b", "a", "b"}, false, true, false);
+%! assert (y, {"a", "b"});
+%! assert (i, [2, 1]);
+%! assert (j, [2, 1, 2]);
+
+%!test
+%! [y, i, j] = __unique__ (int8 ([2 1; 1 2; 2 1]), true, false, false);
+%! assert (y, int8 ([1 2; 2 1]));
+%! assert (i, [2; 3]);
+%! assert (j, [2; 1; 2]);
+
+%!assert (__unique__ ([0, -0], false, false, false), 0)
+%!error <must be an array or cell array of strings>
+%! __unique__ ({1}, false, false, false)
+%!error <same class> __ismember__ (1, single (1), false)
+*/
+
+DEFUN (__ismember__, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {[@var{tf}, @var{s_idx}] =} __ismember__ (@var{a}, @var{s}, @var{by_rows})
+Undocumented internal function.
+@end deftypefn */)
+{
+  if (args.length () != 3)
+    print_usage ();
+
+  octave_value a = args(0);
+  octave_value s = args(1);
+
+  bool by_rows = args(2).xbool_value ("__ismember__: BY_ROWS must be a logical value");
+
+  // Matching indices refer to the last occurrence in S.
+
+  set_job job (false, false, false);
+
+  run_set_job ("ismember", a, s, by_rows, job);
+
+  dim_vector dv = by_rows ? dim_vector (a.rows (), 1) : a.dims ();
+
+  octave_idx_type n = dv.numel ();
+
+  boolNDArray tf (dv);
+  NDArray s_idx (dv);
+
+  for (octave_idx_type k = 0; k < n; k++)
+    {
+      octave_idx_type g = job.a_in_b(k);
+
+      tf(k) = g >= 0;
+      s_idx(k) = g >= 0 ? job.groups_b.rep[g] + 1 : 0;
+    }
+
+  if (nargout > 1)
+    return ovl (tf, s_idx);
+  else
+    return ovl (tf);
+}
+
+/*
+%!test
+%! [tf, s_idx] = __ismember__ ([1, 6, NaN, 7], [1 2 3 4 5 1 6 1 NaN], false);
+%! assert (tf, [true, true, false, false]);
+%! assert (s_idx, [8, 7, 0, 0]);
+
+%!test
+%! [tf, s_idx] = __ismember__ ([1:3; 5:7; 4:6], [0:2; 1:3; 2:4; 3:5; 4:6], true);
+%! assert (tf, [true; false; true]);
+%! assert (s_idx, [2; 0; 5]);
+
+%!assert (__ismember__ ({"a", "b"; "c", "d"}, {"d", "a"}, false),
+%!        [true, false; false, true])
+*/
+
+DEFUN (__intersect__, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {[@var{c}, @var{ia}, @var{ib}] =} __intersect__ (@var{a}, @var{b}, @var{by_rows}, @var{stable})
+Undocumented internal function.
+@end deftypefn */)
+{
+  if (args.length () != 4)
+    print_usage ();
+
+  octave_value a = args(0);
+  octave_value b = args(1);
+
+  bool by_rows = args(2).xbool_value ("__intersect__: BY_ROWS must be a logical value");
+  bool stable = args(3).xbool_value ("__intersect__: STABLE must be a logical value");
+
+  set_job job (true, stable, stable);
+
+  run_set_job ("intersect", a, b, by_rows, job);
+
+  Array<octave_idx_type> ib_idx;
+
+  Array<octave_idx_type> ia_idx
+    = select_groups (a, by_rows, job, true, stable, ib_idx);
+
+  bool row_vec = ! by_rows && is_row_vector (a) && is_row_vector (b);
+
+  octave_value_list retval (nargout > 1 ? nargout : 1);
+
+  retval(0) = set_result (a, by_rows, row_vec, ia_idx);
+
+  if (nargout > 1)
+    retval(1) = one_based_index (ia_idx, ! by_rows && is_row_vector (a));
+
+  if (nargout > 2)
+    retval(2) = one_based_index (ib_idx, ! by_rows && is_row_vector (b));
+
+  return retval;
+}
+
+/*
+%!test
+%! a = [3 2 4 5 7 6 5 1 0 13 13 NaN];
+%! b = [3 5 12 1 1 7 NaN];
+%! [c, ia, ib] = __intersect__ (a, b, false, false);
+%! assert (c, [1 3 5 7]);
+%! assert (ia, [8 1 7 5]);
+%! assert (ib, [5 1 2 6]);
+%! [c, ia, ib] = __intersect__ (a, b, false, true);
+%! assert (c, [3 5 7 1]);
+%! assert (ia, [1 4 5 8]);
+%! assert (ib, [1 2 6 4]);
+
+%!test
+%! [c, ia, ib] = __intersect__ ([1,1,2;1,4,5;2,1,7], [1,4,5;2,3,4;1,1,2;9,8,7], true, false);
+%! assert (c, [1,1,2;1,4,5]);
+%! assert (ia, [1;2]);
+%! assert (ib, [3;1]);
+
+%!assert (size (__intersect__ (1:4, (2:5)', false, false)), [3 1])
+*/
+
+DEFUN (__setdiff__, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {[@var{c}, @var{ia}] =} __setdiff__ (@var{a}, @var{b}, @var{by_rows}, @var{stable})
+Undocumented internal function.
+@end deftypefn */)
+{
+  if (args.length () != 4)
+    print_usage ();
+
+  octave_value a = args(0);
+  octave_value b = args(1);
+
+  bool by_rows = args(2).xbool_value ("__setdiff__: BY_ROWS must be a logical value");
+  bool stable = args(3).xbool_value ("__setdiff__: STABLE must be a logical value");
+
+  set_job job (true, stable, stable);
+
+  run_set_job ("setdiff", a, b, by_rows, job);
+
+  Array<octave_idx_type> unused;
+
+  Array<octave_idx_type> ia_idx
+    = select_groups (a, by_rows, job, false, stable, unused);
+
+  bool row_vec = ! by_rows && is_row_vector (a);
+
+  octave_value_list retval (nargout > 1 ? nargout : 1);
+
+  retval(0) = set_result (a, by_rows, row_vec, ia_idx);
+
+  if (nargout > 1)
+    retval(1) = one_based_index (ia_idx, row_vec);
+
+  return retval;
+}
+
+/*
+%!test
+%! [c, ia] = __setdiff__ ([3, 1, 4, 1, 5, NaN], [1, 2, 3, 4], false, false);
+%! assert (c, [5, NaN]);
+%! assert (ia, [5, 6]);
+
+%!test
+%! [c, ia] = __setdiff__ ([5; 3; 9; 5; 1], [3; 4], false, true);
+%! assert (c, [5; 9; 1]);
+%! assert (ia, [1; 3; 5]);
+
+%!assert (__setdiff__ ([1, 1; 2, 2; 3, 3; 4, 4], [1, 1; 2, 2; 4, 4], true, false),
+%!        [3, 3])
+%!assert (__setdiff__ ({"b", "a", "c"}, {"a"}, false, false), {"b", "c"})
+*/
@@ -31,6 +31,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "file-stat.h"
 #include "oct-env.h"
 #include "oct-time.h"
+#include "oct-perf-counters.h"
 #include "singleton-cleanup.h"
 
 #include "debug.h"
@@ -209,6 +210,8 @@ load_out_of_date_fcn (const std::string& ff, const std::string& dir_name,
   return retval;
 }
 
+size_t fcn_table_generation = 1;
+
 bool
 out_of_date_check (octave_value& function,
                    const std::string& dispatch_type,
@@ -708,6 +711,9 @@ symbol_table::fcn_info::fcn_info_rep::find (const octave_value_list& args,
       // the last prompt or chdir, so try updating the load path and
       // searching again.
 
+      octave::perf_counters::increment
+        (octave::perf_counters::fcn_lookup_misses);
+
       load_path::update ();
 
       retval = xfind (args, local_funcs);
@@ -910,6 +916,9 @@ symbol_table::fcn_info::fcn_info_rep::builtin_find (void)
       // the last prompt or chdir, so try updating the load path and
       // searching again.
 
+      octave::perf_counters::increment
+        (octave::perf_counters::fcn_lookup_misses);
+
       load_path::update ();
 
       retval = x_builtin_find ();
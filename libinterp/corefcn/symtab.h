@@ -2947,6 +2947,11 @@ private:
   }
 };
 
+// Incremented whenever functions must be checked again for changes to
+// their files.  Until then, checking a function that has already been
+// checked without looking for relative file names does nothing.
+extern OCTINTERP_API size_t fcn_table_generation;
+
 extern bool out_of_date_check (octave_value& function,
                                const std::string& dispatch_type = "",
                                bool check_relative = true);
@@ -2536,6 +2536,79 @@ without the dash as well.
   return ovl ();
 }
 
+DEFUN (pack, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {} pack ()
+Free the unused memory held by the arrays in the workspace.
+
+Appending to an array in a loop, as in @code{x(end+1) = @var{v}},
+reserves extra space so that the next appends don't need to copy the
+array.  The extra space is released when the array is copied to another
+variable, but an array that is only appended to keeps it.  @code{pack}
+releases it for all variables in the current workspace and all global
+variables.
+
+This function is also provided for compatibility with @sc{matlab}.  Unlike
+in @sc{matlab}, the variables are not saved and reloaded.
+@seealso{clear, memory}
+@end deftypefn */)
+{
+  if (args.length () != 0)
+    print_usage ();
+
+  std::list<symbol_table::symbol_record> vars
+    = symbol_table::all_variables ();
+
+  for (std::list<symbol_table::symbol_record>::iterator p = vars.begin ();
+       p != vars.end (); p++)
+    p->varref ().maybe_economize ();
+
+  // The copy of a global value shares its representation with the
+  // stored value, so economizing the copy economizes both.
+
+  std::list<std::string> globals = symbol_table::global_variable_names ();
+
+  for (std::list<std::string>::const_iterator p = globals.begin ();
+       p != globals.end (); p++)
+    {
+      octave_value val = symbol_table::global_varval (*p);
+
+      val.maybe_economize ();
+    }
+
+  return ovl ();
+}
+
+/*
+%!test
+%! x = [];
+%! c = {};
+%! for i = 1:2000
+%!   x(end+1) = i;
+%!   c{end+1} = i;
+%! endfor
+%! pack ();
+%! assert (x, 1:2000);
+%! assert (c, num2cell (1:2000));
+%! x(end+1) = 2001;
+%! assert (x, 1:2001);
+
+%!test
+%! global __pack_global__
+%! __pack_global__ = [];
+%! unwind_protect
+%!   for i = 1:2000
+%!     __pack_global__(end+1) = i;
+%!   endfor
+%!   pack ();
+%!   assert (__pack_global__, 1:2000);
+%! unwind_protect_cleanup
+%!   clear -global __pack_global__
+%! end_unwind_protect
+
+%!error pack (1)
+*/
+
 DEFUN (whos_line_format, args, nargout,
        doc: /* -*- texinfo -*-
 @deftypefn  {} {@var{val} =} whos_line_format ()
@@ -31,6 +31,7 @@ OCTAVE_VALUE_INC = \
   libinterp/octave-value/ov-classdef.h \
   libinterp/octave-value/ov-colon.h \
   libinterp/octave-value/ov-complex.h \
+  libinterp/octave-value/ov-containers-map.h \
   libinterp/octave-value/ov-cs-list.h \
   libinterp/octave-value/ov-cx-diag.h \
   libinterp/octave-value/ov-cx-mat.h \
@@ -90,6 +91,7 @@ OCTAVE_VALUE_SRC = \
   libinterp/octave-value/ov-classdef.cc \
   libinterp/octave-value/ov-colon.cc \
   libinterp/octave-value/ov-complex.cc \
+  libinterp/octave-value/ov-containers-map.cc \
   libinterp/octave-value/ov-cs-list.cc \
   libinterp/octave-value/ov-cx-diag.cc \
   libinterp/octave-value/ov-cx-mat.cc \
@@ -35,6 +35,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "Range.h"
 #include "data-conv.h"
 #include "mx-base.h"
+#include "oct-mem-stats.h"
 #include "str-vec.h"
 
 #include "error.h"
@@ -214,6 +215,26 @@ public:
 
   virtual ~octave_base_value (void) { }
 
+  // Count the memory used by values along with that of the arrays
+  // they contain.  The size of the object is known when it is deleted
+  // because the destructor is virtual.
+
+  static void *operator new (size_t size)
+  {
+    void *retval = ::operator new (size);
+
+    octave::memory_stats::allocate (size);
+
+    return retval;
+  }
+
+  static void operator delete (void *p, size_t size)
+  {
+    octave::memory_stats::release (size);
+
+    ::operator delete (p);
+  }
+
   // Unconditional clone.  Always clones.
   virtual octave_base_value *
   clone (void) const { return new octave_base_value (*this); }
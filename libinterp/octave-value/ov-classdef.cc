@@ -1818,14 +1818,55 @@ value_cdef_object::~value_cdef_object (void)
 cdef_class::cdef_class_rep::cdef_class_rep (const std::list<cdef_class>&
                                             superclasses)
   : cdef_meta_object_rep (), member_count (0), handle_class (false),
-    object_count (0), meta (false)
+    object_count (0), meta (false), method_cache (), property_cache (),
+    object_layout (), cache_generation (-1)
 {
   put ("SuperClasses", to_ov (superclasses));
   implicit_ctor_list = superclasses;
 }
 
+octave_idx_type cdef_class::cdef_class_rep::member_generation = 0;
+
+void
+cdef_class::cdef_class_rep::validate_cache (void)
+{
+  if (cache_generation != member_generation)
+    {
+      clear_cache ();
+      cache_generation = member_generation;
+    }
+}
+
+void
+cdef_class::cdef_class_rep::clear_cache (void)
+{
+  method_cache.clear ();
+  property_cache.clear ();
+  object_layout = octave_fields ();
+}
+
 cdef_method
 cdef_class::cdef_class_rep::find_method (const std::string& nm, bool local)
+{
+  if (local)
+    return lookup_method (nm, true);
+
+  validate_cache ();
+
+  method_iterator it = method_cache.find (nm);
+
+  if (it == method_cache.end ())
+    {
+      cdef_method meth = lookup_method (nm, false);
+
+      it = method_cache.insert (std::make_pair (nm, meth)).first;
+    }
+
+  return it->second;
+}
+
+cdef_method
+cdef_class::cdef_class_rep::lookup_method (const std::string& nm, bool local)
 {
   method_iterator it = method_map.find (nm);
 
@@ -1984,6 +2025,8 @@ cdef_class::cdef_class_rep::install_method (const cdef_method& meth)
 
   member_count++;
 
+  member_generation++;
+
   if (meth.is_constructor ())
     {
       // Analyze the constructor code to determine what superclass
@@ -2098,6 +2141,23 @@ cdef_class::cdef_class_rep::find_methods (std::map<std::string,
 
 cdef_property
 cdef_class::cdef_class_rep::find_property (const std::string& nm)
+{
+  validate_cache ();
+
+  property_iterator it = property_cache.find (nm);
+
+  if (it == property_cache.end ())
+    {
+      cdef_property prop = lookup_property (nm);
+
+      it = property_cache.insert (std::make_pair (nm, prop)).first;
+    }
+
+  return it->second;
+}
+
+cdef_property
+cdef_class::cdef_class_rep::lookup_property (const std::string& nm)
 {
   property_iterator it = property_map.find (nm);
 
@@ -2132,6 +2192,8 @@ cdef_class::cdef_class_rep::install_property (const cdef_property& prop)
   property_map[prop.get_name ()] = prop;
 
   member_count++;
+
+  member_generation++;
 }
 
 Cell
@@ -2388,9 +2450,36 @@ cdef_class::cdef_class_rep::meta_subsref (const std::string& type,
 void
 cdef_class::cdef_class_rep::meta_release (void)
 {
+  member_generation++;
+
   cdef_manager::unregister_class (wrap ());
 }
 
+octave_fields
+cdef_class::cdef_class_rep::get_object_layout (void)
+{
+  validate_cache ();
+
+  if (object_layout.nfields () == 0)
+    {
+      std::map<std::string, cdef_property> props
+        = get_property_map (cdef_class::property_all);
+
+      std::list<std::string> names;
+
+      for (property_const_iterator it = props.begin ();
+           it != props.end (); ++it)
+        {
+          if (! it->second.get ("Dependent").bool_value ())
+            names.push_back (it->first);
+        }
+
+      object_layout = octave_fields (string_vector (names));
+    }
+
+  return object_layout;
+}
+
 void
 cdef_class::cdef_class_rep::initialize_object (cdef_object& obj)
 {
@@ -2534,6 +2623,11 @@ cdef_class::cdef_class_rep::construct_object (const octave_value_list& args)
         obj = cdef_object (new value_cdef_object ());
       obj.set_class (wrap ());
 
+      // Lay out the slots for the property values in the same way for
+      // all objects of this class.
+
+      obj.init_slots (get_object_layout ());
+
       initialize_object (obj);
 
       run_constructor (obj, args);
@@ -2905,7 +2999,9 @@ cdef_property::cdef_property_rep::get_value (const cdef_object& obj,
 {
   octave_value retval;
 
-  if (do_check_access && ! check_get_access ())
+  cache_attributes ();
+
+  if (do_check_access && ! public_get_access && ! check_get_access ())
     err_property_access (who, wrap (), false);
 
   if (! obj.is_constructed ())
@@ -2917,12 +3013,12 @@ cdef_property::cdef_property_rep::get_value (const cdef_object& obj,
                cls.get_name ().c_str ());
     }
 
-  octave_value get_fcn = get ("GetMethod");
+  octave_value get_fcn = get_method;
 
   // FIXME: should check whether we're already in get accessor method
 
   if (get_fcn.is_empty () || is_method_executing (get_fcn, obj))
-    retval = obj.get (get ("Name").string_value ());
+    retval = obj.get_slot (slot);
   else
     {
       octave_value_list args;
@@ -2960,7 +3056,9 @@ cdef_property::cdef_property_rep::set_value (cdef_object& obj,
                                              bool do_check_access,
                                              const std::string& who)
 {
-  if (do_check_access && ! check_set_access ())
+  cache_attributes ();
+
+  if (do_check_access && ! public_set_access && ! check_set_access ())
     err_property_access (who, wrap (), true);
 
   if (! obj.is_constructed ())
@@ -2972,10 +3070,10 @@ cdef_property::cdef_property_rep::set_value (cdef_object& obj,
                cls.get_name ().c_str ());
     }
 
-  octave_value set_fcn = get ("SetMethod");
+  octave_value set_fcn = set_method;
 
   if (set_fcn.is_empty () || is_method_executing (set_fcn, obj))
-    obj.put (get ("Name").string_value (), val);
+    obj.put_slot (slot, val);
   else
     {
       octave_value_list args;
@@ -3000,6 +3098,27 @@ cdef_property::cdef_property_rep::set_value (cdef_object& obj,
     }
 }
 
+static bool
+is_public_access (const octave_value& acc)
+{
+  return acc.is_string () && acc.string_value () == "public";
+}
+
+void
+cdef_property::cdef_property_rep::cache_attributes (void) const
+{
+  if (! attr_cache_valid)
+    {
+      constant = get ("Constant").bool_value ();
+      public_get_access = is_public_access (get ("GetAccess"));
+      public_set_access = is_public_access (get ("SetAccess"));
+      get_method = get ("GetMethod");
+      set_method = get ("SetMethod");
+
+      attr_cache_valid = true;
+    }
+}
+
 bool
 cdef_property::cdef_property_rep::check_get_access (void) const
 {
@@ -3077,10 +3196,12 @@ cdef_method::cdef_method_rep::execute (const octave_value_list& args,
 {
   octave_value_list retval;
 
-  if (do_check_access && ! check_access ())
+  cache_attributes ();
+
+  if (do_check_access && ! public_access && ! check_access ())
     err_method_access (who, wrap ());
 
-  if (get ("Abstract").bool_value ())
+  if (abstract_method)
     error ("%s: cannot execute abstract method",
            get ("Name").string_value ().c_str ());
 
@@ -3100,10 +3221,12 @@ cdef_method::cdef_method_rep::execute (const cdef_object& obj,
 {
   octave_value_list retval;
 
-  if (do_check_access && ! check_access ())
+  cache_attributes ();
+
+  if (do_check_access && ! public_access && ! check_access ())
     err_method_access (who, wrap ());
 
-  if (get ("Abstract").bool_value ())
+  if (abstract_method)
     error ("%s: cannot execute abstract method",
            get ("Name").string_value ().c_str ());
 
@@ -3134,6 +3257,19 @@ cdef_method::cdef_method_rep::is_constructor (void) const
   return false;
 }
 
+void
+cdef_method::cdef_method_rep::cache_attributes (void) const
+{
+  if (! attr_cache_valid)
+    {
+      static_method = get ("Static").bool_value ();
+      abstract_method = get ("Abstract").bool_value ();
+      public_access = is_public_access (get ("Access"));
+
+      attr_cache_valid = true;
+    }
+}
+
 bool
 cdef_method::cdef_method_rep::check_access (void) const
 {
@@ -102,6 +102,14 @@ public:
     err_invalid_object ("get");
   }
 
+  virtual void put_slot (octave_field_cache& fc, const octave_value& val)
+  { put (fc.name (), val); }
+
+  virtual octave_value get_slot (octave_field_cache& fc) const
+  { return get (fc.name ()); }
+
+  virtual void init_slots (const octave_fields&) { }
+
   virtual octave_value_list
   subsref (const std::string&, const std::list<octave_value_list>&,
            int, size_t&, const cdef_class&, bool)
@@ -251,6 +259,14 @@ public:
   octave_value get (const std::string& pname) const
   { return rep->get (pname); }
 
+  void put_slot (octave_field_cache& fc, const octave_value& val)
+  { rep->put_slot (fc, val); }
+
+  octave_value get_slot (octave_field_cache& fc) const
+  { return rep->get_slot (fc); }
+
+  void init_slots (const octave_fields& layout) { rep->init_slots (layout); }
+
   octave_value_list
   subsref (const std::string& type, const std::list<octave_value_list>& idx,
            int nargout, size_t& skip, const cdef_class& context,
@@ -415,6 +431,29 @@ public:
     return val(0, 0);
   }
 
+  // Property values are stored in slots of MAP.  Objects of the same
+  // class share the same layout of slots, so the index of a slot that
+  // is cached by a property is valid for all of them.
+
+  void put_slot (octave_field_cache& fc, const octave_value& val)
+  { map.setfield (fc, val); }
+
+  octave_value get_slot (octave_field_cache& fc) const
+  {
+    octave_value retval = map.getfield (fc);
+
+    // An undefined value is either a missing slot or a slot that has
+    // not been set yet.  Let get sort them out and report the error.
+
+    if (retval.is_undefined ())
+      retval = get (fc.name ());
+
+    return retval;
+  }
+
+  void init_slots (const octave_fields& layout)
+  { map = octave_scalar_map (layout); }
+
   octave_value_list
   subsref (const std::string& type, const std::list<octave_value_list>& idx,
            int nargout, size_t& skip, const cdef_class& context,
@@ -614,7 +653,8 @@ private:
   public:
     cdef_class_rep (void)
       : cdef_meta_object_rep (), member_count (0), handle_class (false),
-        object_count (0), meta (false) { }
+        object_count (0), meta (false), method_cache (), property_cache (),
+        object_layout (), cache_generation (-1) { }
 
     cdef_class_rep (const std::list<cdef_class>& superclasses);
 
@@ -690,6 +730,8 @@ private:
           member_count = 0;
           method_map.clear ();
           property_map.clear ();
+          clear_cache ();
+          member_generation++;
         }
       else
         delete this;
@@ -716,6 +758,16 @@ private:
       return cdef_class (this);
     }
 
+    cdef_method lookup_method (const std::string& nm, bool local);
+
+    cdef_property lookup_property (const std::string& nm);
+
+    void validate_cache (void);
+
+    void clear_cache (void);
+
+    octave_fields get_object_layout (void);
+
   private:
     // The @-directory were this class is loaded from.
     // (not used yet)
@@ -745,6 +797,18 @@ private:
     // TRUE if this class is a built-in meta class.
     bool meta;
 
+    // The results of find_method and find_property, including failed
+    // lookups, and the layout of the property values of objects of
+    // this class.  They are valid as long as CACHE_GENERATION is equal
+    // to MEMBER_GENERATION, which changes whenever a method or property
+    // is installed in, or a class is removed from, any class.
+    std::map<std::string, cdef_method> method_cache;
+    std::map<std::string, cdef_property> property_cache;
+    octave_fields object_layout;
+    octave_idx_type cache_generation;
+
+    static octave_idx_type member_generation;
+
     // Utility iterator typedef's.
     typedef std::map<std::string,cdef_method>::iterator method_iterator;
     typedef std::map<std::string,cdef_method>::const_iterator method_const_iterator;
@@ -757,7 +821,8 @@ private:
         method_map (c.method_map), property_map (c.property_map),
         member_count (c.member_count), handle_class (c.handle_class),
         implicit_ctor_list (c.implicit_ctor_list),
-        object_count (c.object_count), meta (c.meta) { }
+        object_count (c.object_count), meta (c.meta), method_cache (),
+        property_cache (), object_layout (), cache_generation (-1) { }
   };
 
 public:
@@ -922,17 +987,33 @@ private:
   {
   public:
     cdef_property_rep (void)
-      : cdef_meta_object_rep () { }
+      : cdef_meta_object_rep (), slot (), attr_cache_valid (false),
+        constant (false), public_get_access (false),
+        public_set_access (false), get_method (), set_method () { }
 
     cdef_object_rep* copy (void) const { return new cdef_property_rep (*this); }
 
     bool is_property (void) const { return true; }
 
+    void put (const std::string& pname, const octave_value& val)
+    {
+      cdef_meta_object_rep::put (pname, val);
+      attr_cache_valid = false;
+    }
+
     std::string get_name (void) const { return get("Name").string_value (); }
 
-    void set_name (const std::string& nm) { put ("Name", nm); }
+    void set_name (const std::string& nm)
+    {
+      put ("Name", nm);
+      slot = octave_field_cache (nm);
+    }
 
-    bool is_constant (void) const { return get("Constant").bool_value (); }
+    bool is_constant (void) const
+    {
+      cache_attributes ();
+      return constant;
+    }
 
     octave_value get_value (bool do_check_access = true,
                             const std::string& who = "");
@@ -951,15 +1032,31 @@ private:
 
   private:
     cdef_property_rep (const cdef_property_rep& p)
-      : cdef_meta_object_rep (p) { }
+      : cdef_meta_object_rep (p), slot (p.slot), attr_cache_valid (false),
+        constant (false), public_get_access (false),
+        public_set_access (false), get_method (), set_method () { }
 
     bool is_recursive_set (const cdef_object& obj) const;
 
+    void cache_attributes (void) const;
+
     cdef_property wrap (void)
     {
       refcount++;
       return cdef_property (this);
     }
+
+    // The slot of objects in which the property value is stored.
+    octave_field_cache slot;
+
+    // Attributes that are needed on every access to the property
+    // value.  They are reset whenever an attribute is changed.
+    mutable bool attr_cache_valid;
+    mutable bool constant;
+    mutable bool public_get_access;
+    mutable bool public_set_access;
+    mutable octave_value get_method;
+    mutable octave_value set_method;
   };
 
 public:
@@ -1031,18 +1128,30 @@ private:
   {
   public:
     cdef_method_rep (void)
-      : cdef_meta_object_rep (), function (), dispatch_type ()
+      : cdef_meta_object_rep (), function (), dispatch_type (),
+        attr_cache_valid (false), static_method (false),
+        abstract_method (false), public_access (false)
     { }
 
     cdef_object_rep* copy (void) const { return new cdef_method_rep(*this); }
 
     bool is_method (void) const { return true; }
 
+    void put (const std::string& pname, const octave_value& val)
+    {
+      cdef_meta_object_rep::put (pname, val);
+      attr_cache_valid = false;
+    }
+
     std::string get_name (void) const { return get("Name").string_value (); }
 
     void set_name (const std::string& nm) { put ("Name", nm); }
 
-    bool is_static (void) const { return get("Static").bool_value (); }
+    bool is_static (void) const
+    {
+      cache_attributes ();
+      return static_method;
+    }
 
     octave_value get_function (void) const { return function; }
 
@@ -1076,11 +1185,15 @@ private:
   private:
     cdef_method_rep (const cdef_method_rep& m)
       : cdef_meta_object_rep (m), function (m.function),
-        dispatch_type (m.dispatch_type)
+        dispatch_type (m.dispatch_type), attr_cache_valid (false),
+        static_method (false), abstract_method (false),
+        public_access (false)
     { }
 
     void check_method (void);
 
+    void cache_attributes (void) const;
+
     cdef_method wrap (void)
     {
       refcount++;
@@ -1093,6 +1206,13 @@ private:
     // When non-empty, the method is externally defined and this member
     // is used to cache the dispatch type to look for the method.
     std::string dispatch_type;
+
+    // Attributes that are needed on every call of the method.  They
+    // are reset whenever an attribute is changed.
+    mutable bool attr_cache_valid;
+    mutable bool static_method;
+    mutable bool abstract_method;
+    mutable bool public_access;
   };
 
 public:
@@ -0,0 +1,1261 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "caseless-str.h"
+#include "lo-mappers.h"
+#include "oct-hash-table.h"
+#include "oct-refcount.h"
+
+#include "Cell.h"
+#include "defun.h"
+#include "error.h"
+#include "errwarn.h"
+#include "ov-containers-map.h"
+#include "ovl.h"
+#include "symtab.h"
+#include "utils.h"
+
+static bool
+valid_key_type (const std::string& type)
+{
+  return (type == "char" || type == "double" || type == "single"
+          || type == "int32" || type == "uint32"
+          || type == "int64" || type == "uint64");
+}
+
+static bool
+valid_value_type (const std::string& type)
+{
+  return (type == "any" || type == "char" || type == "logical"
+          || type == "double" || type == "single"
+          || type == "int8" || type == "uint8"
+          || type == "int16" || type == "uint16"
+          || type == "int32" || type == "uint32"
+          || type == "int64" || type == "uint64");
+}
+
+// Convert the real scalar VAL to the numeric or logical class TYPE.
+
+static octave_value
+convert_scalar (const octave_value& val, const std::string& type)
+{
+  if (type == "double")
+    return octave_value (val.double_value ());
+  else if (type == "single")
+    return octave_value (val.float_value ());
+  else if (type == "logical")
+    return octave_value (val.bool_value ());
+  else if (type == "int8")
+    return octave_value (val.int8_scalar_value ());
+  else if (type == "uint8")
+    return octave_value (val.uint8_scalar_value ());
+  else if (type == "int16")
+    return octave_value (val.int16_scalar_value ());
+  else if (type == "uint16")
+    return octave_value (val.uint16_scalar_value ());
+  else if (type == "int32")
+    return octave_value (val.int32_scalar_value ());
+  else if (type == "uint32")
+    return octave_value (val.uint32_scalar_value ());
+  else if (type == "int64")
+    return octave_value (val.int64_scalar_value ());
+  else if (type == "uint64")
+    return octave_value (val.uint64_scalar_value ());
+
+  panic_impossible ();
+
+  return octave_value ();
+}
+
+static bool
+is_string_key (const octave_value& key)
+{
+  return key.is_string () && key.rows () <= 1;
+}
+
+static bool
+is_numeric_key (const octave_value& key)
+{
+  return key.is_numeric_type () && key.is_real_type () && key.numel () == 1;
+}
+
+// A key and its hash code.  Keys of the types int64 and uint64 are
+// stored exactly in INUM as the bits of the integer, because a double
+// cannot represent all of their values.
+
+class
+map_key
+{
+public:
+
+  map_key (void) : str (), num (0), inum (0), hash (0) { }
+
+  std::string str;
+
+  double num;
+
+  uint64_t inum;
+
+  size_t hash;
+};
+
+template <typename T>
+class
+key_equal
+{
+public:
+
+  key_equal (const std::vector<T>& k, const T& x)
+    : keys (k), key (x)
+  { }
+
+  bool operator () (octave_idx_type i) const { return keys[i] == key; }
+
+private:
+
+  const std::vector<T>& keys;
+
+  const T& key;
+};
+
+// Compare keys of type T stored in a vector of type S.
+
+template <typename T, typename S = T>
+class
+key_index_less
+{
+public:
+
+  key_index_less (const std::vector<S>& k) : keys (k) { }
+
+  bool operator () (octave_idx_type i, octave_idx_type j) const
+  {
+    return static_cast<T> (keys[i]) < static_cast<T> (keys[j]);
+  }
+
+private:
+
+  const std::vector<S>& keys;
+};
+
+// The keys and values of a map, shared by all copies of the map.
+// Keys and values are stored in insertion order, except that removing
+// an entry moves the last entry into its place.  The hash table maps
+// keys to their position.
+
+class
+containers_map_rep
+{
+public:
+
+  containers_map_rep (const std::string& kt, const std::string& vt)
+    : count (1), key_type (kt), value_type (vt),
+      numeric_keys (kt != "char"),
+      integer_keys (kt == "int64" || kt == "uint64"),
+      str_keys (), num_keys (), int_keys (), vals (), table ()
+  { }
+
+  octave_idx_type numel (void) const { return vals.size (); }
+
+  map_key make_key (const octave_value& key) const
+  {
+    map_key retval;
+
+    if (integer_keys)
+      {
+        if (! is_numeric_key (key))
+          error ("containers.Map: specified key type does not match the type of this container");
+
+        if (! key.is_integer_type ())
+          {
+            double x = key.double_value ();
+
+            if (octave::math::isnan (x) || x != octave::math::round (x))
+              error ("containers.Map: specified key type does not match the type of this container");
+          }
+
+        if (key_type == "int64")
+          retval.inum
+            = static_cast<uint64_t> (key.int64_scalar_value ().value ());
+        else
+          retval.inum = key.uint64_scalar_value ().value ();
+
+        retval.hash = octave::hash_mix (retval.inum);
+      }
+    else if (numeric_keys)
+      {
+        if (! is_numeric_key (key))
+          error ("containers.Map: specified key type does not match the type of this container");
+
+        retval.num = key.double_value ();
+
+        if (octave::math::isnan (retval.num))
+          error ("containers.Map: NaN is not a valid key");
+
+        retval.hash = octave::hash_value (retval.num);
+      }
+    else
+      {
+        if (! is_string_key (key))
+          error ("containers.Map: specified key type does not match the type of this container");
+
+        retval.str = key.string_value ();
+        retval.hash = octave::hash_value (retval.str);
+      }
+
+    return retval;
+  }
+
+  size_t stored_key_hash (octave_idx_type idx) const
+  {
+    if (integer_keys)
+      return octave::hash_mix (int_keys[idx]);
+    else if (numeric_keys)
+      return octave::hash_value (num_keys[idx]);
+    else
+      return octave::hash_value (str_keys[idx]);
+  }
+
+  octave_idx_type find (const map_key& key) const
+  {
+    if (integer_keys)
+      return table.find (key.hash, key_equal<uint64_t> (int_keys, key.inum));
+    else if (numeric_keys)
+      return table.find (key.hash, key_equal<double> (num_keys, key.num));
+    else
+      return table.find (key.hash, key_equal<std::string> (str_keys, key.str));
+  }
+
+  void err_missing_key (const map_key& key) const
+  {
+    if (integer_keys)
+      {
+        std::ostringstream buf;
+
+        if (key_type == "int64")
+          buf << static_cast<int64_t> (key.inum);
+        else
+          buf << key.inum;
+
+        error ("containers.Map: the key <%s> does not exist",
+               buf.str ().c_str ());
+      }
+    else if (numeric_keys)
+      error ("containers.Map: the key <%g> does not exist", key.num);
+    else
+      error ("containers.Map: the key <%s> does not exist",
+             key.str.c_str ());
+  }
+
+  octave_idx_type find_existing (const octave_value& key) const
+  {
+    map_key k = make_key (key);
+
+    octave_idx_type idx = find (k);
+
+    if (idx < 0)
+      err_missing_key (k);
+
+    return idx;
+  }
+
+  octave_value convert_value (const octave_value& val) const
+  {
+    if (value_type == "any")
+      return val;
+    else if (value_type == "char")
+      {
+        if (! (val.is_string () && val.rows () <= 1))
+          error ("containers.Map: specified value type does not match the type of this container");
+
+        return val;
+      }
+    else
+      {
+        if (! ((val.is_numeric_type () || val.is_bool_type ())
+               && val.is_real_type () && val.numel () == 1))
+          error ("containers.Map: specified value type does not match the type of this container");
+
+        return convert_scalar (val, value_type);
+      }
+  }
+
+  void insert (const octave_value& key, const octave_value& val)
+  {
+    map_key k = make_key (key);
+
+    octave_value v = convert_value (val);
+
+    octave_idx_type n = numel ();
+
+    octave_idx_type idx;
+
+    if (integer_keys)
+      idx = table.insert (k.hash, n, key_equal<uint64_t> (int_keys, k.inum));
+    else if (numeric_keys)
+      idx = table.insert (k.hash, n, key_equal<double> (num_keys, k.num));
+    else
+      idx = table.insert (k.hash, n, key_equal<std::string> (str_keys, k.str));
+
+    if (idx >= 0)
+      vals[idx] = v;
+    else
+      {
+        if (integer_keys)
+          int_keys.push_back (k.inum);
+        else if (numeric_keys)
+          num_keys.push_back (k.num);
+        else
+          str_keys.push_back (k.str);
+
+        vals.push_back (v);
+      }
+  }
+
+  void remove (const octave_value& key)
+  {
+    map_key k = make_key (key);
+
+    octave_idx_type idx;
+
+    if (integer_keys)
+      idx = table.remove (k.hash, key_equal<uint64_t> (int_keys, k.inum));
+    else if (numeric_keys)
+      idx = table.remove (k.hash, key_equal<double> (num_keys, k.num));
+    else
+      idx = table.remove (k.hash, key_equal<std::string> (str_keys, k.str));
+
+    if (idx < 0)
+      err_missing_key (k);
+
+    octave_idx_type last = numel () - 1;
+
+    if (idx != last)
+      {
+        table.reindex (stored_key_hash (last), last, idx);
+
+        if (integer_keys)
+          int_keys[idx] = int_keys[last];
+        else if (numeric_keys)
+          num_keys[idx] = num_keys[last];
+        else
+          str_keys[idx].swap (str_keys[last]);
+
+        vals[idx] = vals[last];
+      }
+
+    if (integer_keys)
+      int_keys.pop_back ();
+    else if (numeric_keys)
+      num_keys.pop_back ();
+    else
+      str_keys.pop_back ();
+
+    vals.pop_back ();
+  }
+
+  octave_value key_value (octave_idx_type idx) const
+  {
+    if (integer_keys)
+      {
+        if (key_type == "int64")
+          {
+            int64_t x = static_cast<int64_t> (int_keys[idx]);
+
+            return octave_value (octave_int64 (x));
+          }
+        else
+          return octave_value (octave_uint64 (int_keys[idx]));
+      }
+    else if (numeric_keys)
+      return convert_scalar (octave_value (num_keys[idx]), key_type);
+    else
+      return octave_value (str_keys[idx]);
+  }
+
+  size_t key_byte_size (octave_idx_type idx) const
+  {
+    if (integer_keys)
+      return sizeof (uint64_t);
+    else if (numeric_keys)
+      return sizeof (double);
+    else
+      return str_keys[idx].length ();
+  }
+
+  // Indices of the entries sorted by key.
+
+  std::vector<octave_idx_type> sorted_order (void) const
+  {
+    octave_idx_type n = numel ();
+
+    std::vector<octave_idx_type> retval (n);
+
+    for (octave_idx_type i = 0; i < n; i++)
+      retval[i] = i;
+
+    if (integer_keys && key_type == "int64")
+      std::sort (retval.begin (), retval.end (),
+                 key_index_less<int64_t, uint64_t> (int_keys));
+    else if (integer_keys)
+      std::sort (retval.begin (), retval.end (),
+                 key_index_less<uint64_t> (int_keys));
+    else if (numeric_keys)
+      std::sort (retval.begin (), retval.end (),
+                 key_index_less<double> (num_keys));
+    else
+      std::sort (retval.begin (), retval.end (),
+                 key_index_less<std::string> (str_keys));
+
+    return retval;
+  }
+
+  octave_refcount<int> count;
+
+  std::string key_type;
+
+  std::string value_type;
+
+  bool numeric_keys;
+
+  bool integer_keys;
+
+  std::vector<std::string> str_keys;
+
+  std::vector<double> num_keys;
+
+  std::vector<uint64_t> int_keys;
+
+  std::vector<octave_value> vals;
+
+  octave::idx_hash_table table;
+
+private:
+
+  // No copying!
+
+  containers_map_rep (const containers_map_rep&);
+
+  containers_map_rep& operator = (const containers_map_rep&);
+};
+
+DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_containers_map,
+                                     "containers.Map", "containers.Map");
+
+octave_containers_map::octave_containers_map (void)
+  : octave_base_value (), rep (new containers_map_rep ("char", "any"))
+{ }
+
+octave_containers_map::octave_containers_map (const std::string& key_type,
+                                              const std::string& value_type)
+  : octave_base_value (), rep (new containers_map_rep (key_type, value_type))
+{ }
+
+octave_containers_map::octave_containers_map (const octave_containers_map& m)
+  : octave_base_value (), rep (m.rep)
+{
+  rep->count++;
+}
+
+octave_containers_map::~octave_containers_map (void)
+{
+  if (--rep->count == 0)
+    delete rep;
+}
+
+dim_vector
+octave_containers_map::dims (void) const
+{
+  return dim_vector (rep->numel (), 1);
+}
+
+size_t
+octave_containers_map::byte_size (void) const
+{
+  size_t retval = 0;
+
+  octave_idx_type n = rep->numel ();
+
+  for (octave_idx_type i = 0; i < n; i++)
+    {
+      retval += rep->key_byte_size (i);
+
+      retval += rep->vals[i].byte_size ();
+    }
+
+  return retval;
+}
+
+octave_value_list
+octave_containers_map::subsref (const std::string& type,
+                                const std::list<octave_value_list>& idx,
+                                int nargout)
+{
+  octave_value_list retval;
+
+  int skip = 1;
+
+  switch (type[0])
+    {
+    case '(':
+      {
+        const octave_value_list& key = idx.front ();
+
+        if (key.length () != 1)
+          error ("containers.Map: only '()' indexing with exactly one key is supported");
+
+        retval = ovl (lookup (key(0)));
+      }
+      break;
+
+    case '.':
+      {
+        std::string name = idx.front ()(0).string_value ();
+
+        octave_value_list args;
+
+        if (type.length () > 1 && type[1] == '('
+            && (name == "keys" || name == "values" || name == "isKey"
+                || name == "remove" || name == "length"))
+          {
+            std::list<octave_value_list>::const_iterator p = idx.begin ();
+            args = *++p;
+            skip++;
+          }
+
+        int nargin = args.length ();
+
+        if (name == "Count")
+          retval = ovl (static_cast<double> (numel ()));
+        else if (name == "KeyType")
+          retval = ovl (key_type ());
+        else if (name == "ValueType")
+          retval = ovl (value_type ());
+        else if (name == "keys" && nargin == 0)
+          retval = ovl (keys ());
+        else if (name == "values" && nargin == 0)
+          retval = ovl (values ());
+        else if (name == "values" && nargin == 1)
+          {
+            if (! args(0).is_cell ())
+              error ("containers.Map: KEYS must be a cell array");
+
+            retval = ovl (values (args(0).cell_value ()));
+          }
+        else if (name == "isKey" && nargin == 1)
+          {
+            if (args(0).is_cell ())
+              retval = ovl (is_key (args(0).cell_value ()));
+            else
+              retval = ovl (is_key (args(0)));
+          }
+        else if (name == "remove" && nargin == 1)
+          {
+            if (args(0).is_cell ())
+              {
+                Cell keys = args(0).cell_value ();
+
+                for (octave_idx_type i = 0; i < keys.numel (); i++)
+                  remove (keys(i));
+              }
+            else
+              remove (args(0));
+
+            count++;
+            retval = ovl (octave_value (this));
+          }
+        else if (name == "length" && nargin == 0)
+          retval = ovl (static_cast<double> (numel ()));
+        else
+          error ("containers.Map: invalid use of a containers.Map object: '%s'",
+                 name.c_str ());
+      }
+      break;
+
+    default:
+      error ("containers.Map: '%c' indexing is not supported", type[0]);
+    }
+
+  if (idx.size () > 1 && type.length () > 1)
+    retval = retval(0).next_subsref (nargout, type, idx, skip);
+
+  return retval;
+}
+
+octave_value
+octave_containers_map::subsasgn (const std::string& type,
+                                 const std::list<octave_value_list>& idx,
+                                 const octave_value& rhs)
+{
+  if (type[0] != '(')
+    error ("containers.Map: only '()' assignment is supported");
+
+  const octave_value_list& key = idx.front ();
+
+  if (key.length () != 1)
+    error ("containers.Map: only '()' indexing with exactly one key is supported");
+
+  if (type.length () == 1)
+    insert (key(0), rhs);
+  else
+    {
+      // Nested assignment such as M(KEY).FIELD = RHS.
+
+      std::string next_type = type.substr (1);
+
+      std::list<octave_value_list> next_idx (idx);
+      next_idx.erase (next_idx.begin ());
+
+      map_key k = rep->make_key (key(0));
+
+      octave_idx_type i = rep->find (k);
+
+      octave_value tmp;
+
+      if (i >= 0)
+        {
+          tmp = rep->vals[i];
+
+          // Drop the stored reference so that TMP may be modified in
+          // place.
+          rep->vals[i] = octave_value ();
+        }
+      else
+        tmp = octave_value::empty_conv (next_type, rhs);
+
+      try
+        {
+          tmp.assign (octave_value::op_asn_eq, next_type, next_idx, rhs);
+        }
+      catch (...)
+        {
+          // The assignment leaves TMP unchanged if it fails, so put
+          // the old value back.
+          if (i >= 0)
+            rep->vals[i] = tmp;
+
+          throw;
+        }
+
+      insert (key(0), tmp);
+    }
+
+  count++;
+  return octave_value (this);
+}
+
+std::string
+octave_containers_map::key_type (void) const
+{
+  return rep->key_type;
+}
+
+std::string
+octave_containers_map::value_type (void) const
+{
+  return rep->value_type;
+}
+
+bool
+octave_containers_map::is_key (const octave_value& key) const
+{
+  // A key of the wrong type is not an error here, it simply is not
+  // present in the map.
+
+  if (rep->numeric_keys ? ! is_numeric_key (key) : ! is_string_key (key))
+    return false;
+
+  if (rep->numeric_keys && ! key.is_integer_type ())
+    {
+      double x = key.double_value ();
+
+      if (octave::math::isnan (x)
+          || (rep->integer_keys && x != octave::math::round (x)))
+        return false;
+    }
+
+  return rep->find (rep->make_key (key)) >= 0;
+}
+
+boolNDArray
+octave_containers_map::is_key (const Cell& keys) const
+{
+  boolNDArray retval (keys.dims ());
+
+  for (octave_idx_type i = 0; i < keys.numel (); i++)
+    retval(i) = is_key (keys(i));
+
+  return retval;
+}
+
+octave_value
+octave_containers_map::lookup (const octave_value& key) const
+{
+  return rep->vals[rep->find_existing (key)];
+}
+
+void
+octave_containers_map::insert (const octave_value& key,
+                               const octave_value& val)
+{
+  rep->insert (key, val);
+}
+
+void
+octave_containers_map::remove (const octave_value& key)
+{
+  rep->remove (key);
+}
+
+Cell
+octave_containers_map::keys (void) const
+{
+  std::vector<octave_idx_type> order = rep->sorted_order ();
+
+  octave_idx_type n = order.size ();
+
+  Cell retval (1, n);
+
+  for (octave_idx_type i = 0; i < n; i++)
+    retval(i) = rep->key_value (order[i]);
+
+  return retval;
+}
+
+Cell
+octave_containers_map::values (void) const
+{
+  std::vector<octave_idx_type> order = rep->sorted_order ();
+
+  octave_idx_type n = order.size ();
+
+  Cell retval (1, n);
+
+  for (octave_idx_type i = 0; i < n; i++)
+    retval(i) = rep->vals[order[i]];
+
+  return retval;
+}
+
+Cell
+octave_containers_map::values (const Cell& keys) const
+{
+  Cell retval (keys.dims ());
+
+  for (octave_idx_type i = 0; i < keys.numel (); i++)
+    retval(i) = lookup (keys(i));
+
+  return retval;
+}
+
+bool
+octave_containers_map::save_ascii (std::ostream& /* os */)
+{
+  warning ("save: unable to save containers.Map objects, skipping");
+
+  return true;
+}
+
+bool
+octave_containers_map::load_ascii (std::istream& /* is */)
+{
+  // Silently skip object that was not saved
+  return true;
+}
+
+bool
+octave_containers_map::save_binary (std::ostream& /* os */,
+                                    bool& /* save_as_floats */)
+{
+  warning ("save: unable to save containers.Map objects, skipping");
+
+  return true;
+}
+
+bool
+octave_containers_map::load_binary (std::istream& /* is */, bool /* swap */,
+                                    octave::mach_info::float_format /* fmt */)
+{
+  // Silently skip object that was not saved
+  return true;
+}
+
+bool
+octave_containers_map::save_hdf5 (octave_hdf5_id /* loc_id */,
+                                  const char * /* name */,
+                                  bool /* save_as_floats */)
+{
+  warning ("save: unable to save containers.Map objects, skipping");
+
+  return true;
+}
+
+bool
+octave_containers_map::load_hdf5 (octave_hdf5_id /* loc_id */,
+                                  const char * /* name */)
+{
+  // Silently skip object that was not saved
+  return true;
+}
+
+void
+octave_containers_map::print (std::ostream& os, bool pr_as_read_syntax)
+{
+  print_raw (os, pr_as_read_syntax);
+  newline (os);
+}
+
+void
+octave_containers_map::print_raw (std::ostream& os, bool) const
+{
+  indent (os);
+  os << "containers.Map object with properties:";
+  newline (os);
+  newline (os);
+
+  increment_indent_level ();
+
+  indent (os);
+  os << "Count     : " << numel ();
+  newline (os);
+
+  indent (os);
+  os << "KeyType   : " << key_type ();
+  newline (os);
+
+  indent (os);
+  os << "ValueType : " << value_type ();
+  newline (os);
+
+  decrement_indent_level ();
+}
+
+static octave_containers_map&
+get_containers_map (const octave_value& arg, const char *who)
+{
+  if (arg.type_id () != octave_containers_map::static_type_id ())
+    error ("%s: M must be a containers.Map object", who);
+
+  return dynamic_cast<octave_containers_map&> (*arg.internal_rep ());
+}
+
+// Infer the key type of a map from the keys KEYS given to the
+// constructor.
+
+static std::string
+infer_key_type (const octave_value_list& keys)
+{
+  octave_idx_type n = keys.length ();
+
+  if (n == 0 || is_string_key (keys(0)))
+    return "char";
+
+  std::string retval = keys(0).class_name ();
+
+  for (octave_idx_type i = 1; i < n; i++)
+    {
+      if (keys(i).class_name () != retval)
+        return "double";
+    }
+
+  return valid_key_type (retval) ? retval : "double";
+}
+
+// Infer the value type of a map from the values VALS given to the
+// constructor.  If the values are all strings or all real scalars of
+// the same class, use that class.  Otherwise, allow any value.
+
+static std::string
+infer_value_type (const octave_value_list& vals)
+{
+  octave_idx_type n = vals.length ();
+
+  if (n == 0)
+    return "any";
+
+  bool all_strings = true;
+
+  for (octave_idx_type i = 0; i < n; i++)
+    {
+      if (! is_string_key (vals(i)))
+        {
+          all_strings = false;
+          break;
+        }
+    }
+
+  if (all_strings)
+    return "char";
+
+  std::string retval = vals(0).class_name ();
+
+  if (retval == "char" || ! valid_value_type (retval))
+    return "any";
+
+  for (octave_idx_type i = 0; i < n; i++)
+    {
+      const octave_value& val = vals(i);
+
+      if (val.class_name () != retval || ! val.is_real_type ()
+          || val.numel () != 1)
+        return "any";
+    }
+
+  return retval;
+}
+
+// Split the keys or values given to the constructor into a list.
+
+static octave_value_list
+map_elements (octave_value arg, bool split)
+{
+  octave_value_list retval;
+
+  if (! split)
+    retval = ovl (arg);
+  else if (arg.is_cell ())
+    retval = octave_value_list (arg.cell_value ());
+  else
+    {
+      octave_idx_type n = arg.numel ();
+
+      retval.resize (n);
+
+      for (octave_idx_type i = 0; i < n; i++)
+        retval(i) = arg.do_index_op (ovl (octave_value (i + 1)));
+    }
+
+  return retval;
+}
+
+static bool
+is_map_option (const octave_value& arg)
+{
+  if (! arg.is_string ())
+    return false;
+
+  caseless_str opt = arg.string_value ();
+
+  return (opt.compare ("KeyType") || opt.compare ("ValueType")
+          || opt.compare ("UniformValues"));
+}
+
+// The functions keys, values, isKey, and remove are methods of maps.
+// They are installed as legacy dispatch functions for the type
+// containers.Map so that calling them with a map as the first argument
+// works without defining global functions with these generic names.
+
+static void
+install_map_methods (void)
+{
+  static bool installed = false;
+
+  if (! installed)
+    {
+      symbol_table::add_dispatch ("keys", "containers.Map",
+                                  "__containers_map_keys__");
+      symbol_table::add_dispatch ("values", "containers.Map",
+                                  "__containers_map_values__");
+      symbol_table::add_dispatch ("isKey", "containers.Map",
+                                  "__containers_map_isKey__");
+      symbol_table::add_dispatch ("remove", "containers.Map",
+                                  "__containers_map_remove__");
+
+      installed = true;
+    }
+}
+
+DEFUN (__containers_map__, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {@var{m} =} __containers_map__ (@dots{})
+Undocumented internal function.
+@end deftypefn */)
+{
+  int nargin = args.length ();
+
+  std::string key_type;
+  std::string value_type;
+  bool uniform = true;
+
+  octave_value_list keys;
+  octave_value_list vals;
+
+  int opt_start = 0;
+
+  if (nargin >= 2 && ! is_map_option (args(0)))
+    {
+      octave_value k = args(0);
+      octave_value v = args(1);
+
+      bool split = k.is_cell () || (! k.is_string () && k.numel () != 1);
+
+      if (split && ! (v.is_cell () || k.is_cell ()))
+        error ("containers.Map: the number of keys and values must match");
+
+      keys = map_elements (k, split);
+      vals = map_elements (v, split);
+
+      if (keys.length () != vals.length ())
+        error ("containers.Map: the number of keys and values must match");
+
+      opt_start = 2;
+    }
+
+  if ((nargin - opt_start) % 2 != 0)
+    print_usage ();
+
+  for (int i = opt_start; i < nargin; i += 2)
+    {
+      caseless_str opt = args(i).xstring_value ("containers.Map: option must be a string");
+
+      if (opt.compare ("KeyType") && opt_start == 0)
+        key_type = args(i+1).xstring_value ("containers.Map: KeyType must be a string");
+      else if (opt.compare ("ValueType") && opt_start == 0)
+        value_type = args(i+1).xstring_value ("containers.Map: ValueType must be a string");
+      else if (opt.compare ("UniformValues"))
+        uniform = args(i+1).xbool_value ("containers.Map: UniformValues must be a logical value");
+      else
+        error ("containers.Map: invalid option '%s'", opt.c_str ());
+    }
+
+  if (key_type.empty ())
+    key_type = infer_key_type (keys);
+  else if (! valid_key_type (key_type))
+    error ("containers.Map: unsupported KeyType '%s'", key_type.c_str ());
+
+  if (value_type.empty ())
+    value_type = uniform ? infer_value_type (vals) : "any";
+  else if (! valid_value_type (value_type))
+    error ("containers.Map: unsupported ValueType '%s'", value_type.c_str ());
+
+  install_map_methods ();
+
+  octave_containers_map *m = new octave_containers_map (key_type, value_type);
+
+  octave_value retval (m);
+
+  for (octave_idx_type i = 0; i < keys.length (); i++)
+    m->insert (keys(i), vals(i));
+
+  return retval;
+}
+
+DEFUN (__containers_map_keys__, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {@var{k} =} __containers_map_keys__ (@var{m})
+Undocumented internal function.
+@end deftypefn */)
+{
+  if (args.length () != 1)
+    print_usage ();
+
+  return ovl (get_containers_map (args(0), "keys").keys ());
+}
+
+DEFUN (__containers_map_values__, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn  {} {@var{v} =} __containers_map_values__ (@var{m})
+@deftypefnx {} {@var{v} =} __containers_map_values__ (@var{m}, @var{keys})
+Undocumented internal function.
+@end deftypefn */)
+{
+  int nargin = args.length ();
+
+  if (nargin < 1 || nargin > 2)
+    print_usage ();
+
+  const octave_containers_map& m = get_containers_map (args(0), "values");
+
+  if (nargin == 1)
+    return ovl (m.values ());
+
+  if (! args(1).is_cell ())
+    error ("values: KEYS must be a cell array");
+
+  return ovl (m.values (args(1).cell_value ()));
+}
+
+DEFUN (__containers_map_isKey__, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {@var{tf} =} __containers_map_isKey__ (@var{m}, @var{key})
+Undocumented internal function.
+@end deftypefn */)
+{
+  if (args.length () != 2)
+    print_usage ();
+
+  const octave_containers_map& m = get_containers_map (args(0), "isKey");
+
+  if (args(1).is_cell ())
+    return ovl (m.is_key (args(1).cell_value ()));
+  else
+    return ovl (m.is_key (args(1)));
+}
+
+DEFUN (__containers_map_remove__, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {@var{m} =} __containers_map_remove__ (@var{m}, @var{key})
+Undocumented internal function.
+@end deftypefn */)
+{
+  if (args.length () != 2)
+    print_usage ();
+
+  octave_containers_map& m = get_containers_map (args(0), "remove");
+
+  if (args(1).is_cell ())
+    {
+      Cell keys = args(1).cell_value ();
+
+      for (octave_idx_type i = 0; i < keys.numel (); i++)
+        m.remove (keys(i));
+    }
+  else
+    m.remove (args(1));
+
+  return ovl (args(0));
+}
+
+/*
+%!test
+%! m = __containers_map__ ();
+%! assert (m.Count, 0);
+%! assert (m.KeyType, "char");
+%! assert (m.ValueType, "any");
+%! assert (class (m), "containers.Map");
+%! assert (keys (m), cell (1, 0));
+
+%!test
+%! m = __containers_map__ ({"b", "a", "c"}, {2, 1, 3});
+%! assert (m.Count, 3);
+%! assert (m.ValueType, "double");
+%! assert (keys (m), {"a", "b", "c"});
+%! assert (values (m), {1, 2, 3});
+%! assert (values (m, {"c"; "a"}), {3; 1});
+%! assert (m("b"), 2);
+%! assert (isKey (m, "a"));
+%! assert (isKey (m, {"a", "x"; "c", 1}), [true, false; true, false]);
+
+%!test
+%! m = __containers_map__ ("KeyType", "double", "ValueType", "any");
+%! for i = 1:100
+%!   m(i) = sprintf ("%d", i);
+%! endfor
+%! assert (m.Count, 100);
+%! remove (m, 50);
+%! m.remove ({1, 100});
+%! assert (m.Count, 97);
+%! assert (isKey (m, {1, 2, 50, 99, 100}), [false, true, false, true, false]);
+%! assert (m(99), "99");
+%! k = keys (m);
+%! assert (k{1}, 2);
+%! assert (k{end}, 99);
+
+## Reference semantics
+%!test
+%! m1 = __containers_map__ ();
+%! m2 = m1;
+%! m2("x") = 1;
+%! assert (m1.Count, 1);
+%! assert (m1("x"), 1);
+
+## Nested assignment
+%!test
+%! m = __containers_map__ ();
+%! m("s") = struct ("a", 1);
+%! m("s").a = 2;
+%! m("t").b = 3;
+%! assert (m("s").a, 2);
+%! assert (m("t"), struct ("b", 3));
+
+## A failed nested assignment keeps the old value
+%!test
+%! m = __containers_map__ ();
+%! m("s") = struct ("a", 1);
+%! m("v") = [1, 2, 3];
+%! fail ('m("v")(0) = 1');
+%! fail ('m("s").a(0) = 2');
+%! assert (m("v"), [1, 2, 3]);
+%! assert (m("s"), struct ("a", 1));
+
+%!test
+%! m = __containers_map__ ([1, 2, 3], {"one", "two", "three"});
+%! assert (m.KeyType, "double");
+%! assert (m.ValueType, "char");
+%! assert (m(2), "two");
+
+%!test
+%! m = __containers_map__ ("KeyType", "int32", "ValueType", "double");
+%! m(int32 (7)) = int8 (3);
+%! assert (keys (m), {int32(7)});
+%! assert (m(7), 3);
+
+## 64-bit integer keys are stored exactly
+%!test
+%! m = __containers_map__ ("KeyType", "int64", "ValueType", "double");
+%! m(intmax ("int64")) = 1;
+%! m(intmax ("int64") - 1) = 2;
+%! m(int64 (-5)) = 3;
+%! assert (m.Count, 3);
+%! assert (m(intmax ("int64")), 1);
+%! assert (m(intmax ("int64") - 1), 2);
+%! assert (keys (m), {int64(-5), intmax("int64")-1, intmax("int64")});
+%! assert (isKey (m, {1.5, -5}), [false, true]);
+%! remove (m, intmax ("int64"));
+%! assert (m(intmax ("int64") - 1), 2);
+%!test
+%! m = __containers_map__ ("KeyType", "uint64", "ValueType", "any");
+%! m(intmax ("uint64")) = "a";
+%! m(intmax ("uint64") - 1) = "b";
+%! assert (m.Count, 2);
+%! assert (m(intmax ("uint64")), "a");
+%! assert (class (keys (m){1}), "uint64");
+%!error <does not match>
+%! m = __containers_map__ ("KeyType", "int64", "ValueType", "any");
+%! m(1.5) = 1;
+
+%!error <does not exist> m = __containers_map__ (); m("x")
+%!error <does not match> m = __containers_map__ (); m(1) = 2
+%!error <does not match>
+%! m = __containers_map__ ("KeyType", "char", "ValueType", "double");
+%! m("a") = "b";
+%!error <unsupported KeyType> __containers_map__ ("KeyType", "cell")
+%!error <must be a containers.Map object> __containers_map_keys__ (struct ())
+
+## The methods are not global functions
+%!test
+%! m = __containers_map__ ();
+%! keys (m);
+%! assert (exist ("keys"), 0);
+%! assert (exist ("remove"), 0);
+%!error <does not exist> remove (__containers_map__ (), "x")
+*/
@@ -0,0 +1,145 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if ! defined (octave_ov_containers_map_h)
+#define octave_ov_containers_map_h 1
+
+#include "octave-config.h"
+
+#include <iosfwd>
+#include <list>
+#include <string>
+
+#include "boolNDArray.h"
+
+#include "ov-base.h"
+#include "ov.h"
+#include "ovl.h"
+
+class Cell;
+
+class containers_map_rep;
+
+// An associative array with char or numeric keys, stored in a hash
+// table.  Maps have reference semantics: copies of a map share the
+// same keys and values, so a change made through one copy is visible
+// through all of them.
+
+class octave_containers_map : public octave_base_value
+{
+public:
+
+  octave_containers_map (void);
+
+  octave_containers_map (const std::string& key_type,
+                         const std::string& value_type);
+
+  octave_containers_map (const octave_containers_map& m);
+
+  ~octave_containers_map (void);
+
+  octave_base_value *clone (void) const
+  {
+    return new octave_containers_map (*this);
+  }
+
+  octave_base_value *empty_clone (void) const
+  {
+    return new octave_containers_map ();
+  }
+
+  bool is_defined (void) const { return true; }
+
+  bool is_constant (void) const { return true; }
+
+  dim_vector dims (void) const;
+
+  using octave_base_value::numel;
+
+  octave_idx_type numel (const octave_value_list&) { return 1; }
+
+  size_t byte_size (void) const;
+
+  octave_value_list
+  subsref (const std::string& type, const std::list<octave_value_list>& idx,
+           int nargout);
+
+  octave_value
+  subsref (const std::string& type, const std::list<octave_value_list>& idx)
+  {
+    octave_value_list retval = subsref (type, idx, 1);
+    return (retval.length () > 0 ? retval(0) : octave_value ());
+  }
+
+  octave_value subsasgn (const std::string& type,
+                         const std::list<octave_value_list>& idx,
+                         const octave_value& rhs);
+
+  std::string key_type (void) const;
+
+  std::string value_type (void) const;
+
+  bool is_key (const octave_value& key) const;
+
+  boolNDArray is_key (const Cell& keys) const;
+
+  octave_value lookup (const octave_value& key) const;
+
+  void insert (const octave_value& key, const octave_value& val);
+
+  void remove (const octave_value& key);
+
+  Cell keys (void) const;
+
+  Cell values (void) const;
+
+  Cell values (const Cell& keys) const;
+
+  bool save_ascii (std::ostream& os);
+
+  bool load_ascii (std::istream& is);
+
+  bool save_binary (std::ostream& os, bool& save_as_floats);
+
+  bool load_binary (std::istream& is, bool swap,
+                    octave::mach_info::float_format fmt);
+
+  bool save_hdf5 (octave_hdf5_id loc_id, const char *name, bool save_as_floats);
+
+  bool load_hdf5 (octave_hdf5_id loc_id, const char *name);
+
+  void print (std::ostream& os, bool pr_as_read_syntax = false);
+
+  void print_raw (std::ostream& os, bool pr_as_read_syntax = false) const;
+
+private:
+
+  containers_map_rep *rep;
+
+  // No assignment.
+
+  octave_containers_map& operator = (const octave_containers_map&);
+
+  DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA
+};
+
+#endif
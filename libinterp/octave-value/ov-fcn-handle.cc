@@ -75,7 +75,8 @@ const std::string octave_fcn_handle::anonymous ("@<anonymous>");
 
 octave_fcn_handle::octave_fcn_handle (const octave_value& f,
                                       const std::string& n)
-  : fcn (f), nm (n), has_overloads (false)
+  : fcn (f), nm (n), has_overloads (false), fcn_checked (0),
+    builtin_overloads_checked ()
 {
   octave_user_function *uf = fcn.user_function_value (true);
 
@@ -149,7 +150,7 @@ octave_fcn_handle::do_multi_index_op (int nargout,
 {
   octave_value_list retval;
 
-  out_of_date_check (fcn, "", false);
+  check_out_of_date (fcn, fcn_checked);
 
   if (has_overloads)
     {
@@ -163,7 +164,8 @@ octave_fcn_handle::do_multi_index_op (int nargout,
       // Retrieve overload.
       if (btyp != btyp_unknown)
         {
-          out_of_date_check (builtin_overloads[btyp], dispatch_type, false);
+          check_out_of_date (builtin_overloads[btyp],
+                             builtin_overloads_checked[btyp]);
           ov_fcn = builtin_overloads[btyp];
         }
       else
@@ -227,6 +229,21 @@ octave_fcn_handle::do_multi_index_op (int nargout,
   return retval;
 }
 
+// Checking a function for changes to its file again gives the same
+// result until fcn_table_generation changes, so handles that are
+// called many times only do it once per generation.
+
+void
+octave_fcn_handle::check_out_of_date (octave_value& f, size_t& checked)
+{
+  if (checked != fcn_table_generation)
+    {
+      out_of_date_check (f, "", false);
+
+      checked = fcn_table_generation;
+    }
+}
+
 dim_vector
 octave_fcn_handle::dims (void) const
 {
@@ -2123,4 +2140,18 @@ octave_fcn_binder::do_multi_index_op (int nargout,
 %!test
 %! x = [1,2;3,4];
 %! assert (__f (@(i) x(:,i), 1), [1;3]);
+
+%!test
+%! f = @(x) deal (x, 2*x);
+%! [a, b] = f (1);
+%! c = f (3);
+%! [d, e] = f (5);
+%! assert ([a, b, c, d, e], [1, 2, 3, 5, 10]);
+
+%!test
+%! f = @sin;
+%! x = f (1);
+%! rehash ();
+%! assert (f (1), x);
+%! assert (f (single (1)), single (x));
 */
@@ -50,19 +50,25 @@ public:
   static const std::string anonymous;
 
   octave_fcn_handle (void)
-    : fcn (), nm (), has_overloads (false), overloads () { }
+    : fcn (), nm (), has_overloads (false), overloads (), fcn_checked (0),
+      builtin_overloads_checked () { }
 
   octave_fcn_handle (const std::string& n)
-    : fcn (), nm (n), has_overloads (false), overloads () { }
+    : fcn (), nm (n), has_overloads (false), overloads (), fcn_checked (0),
+      builtin_overloads_checked () { }
 
   octave_fcn_handle (const octave_value& f,  const std::string& n = anonymous);
 
   octave_fcn_handle (const octave_fcn_handle& fh)
     : octave_base_value (fh), fcn (fh.fcn), nm (fh.nm),
-      has_overloads (fh.has_overloads), overloads ()
+      has_overloads (fh.has_overloads), overloads (),
+      fcn_checked (fh.fcn_checked)
   {
     for (int i = 0; i < btyp_num_types; i++)
-      builtin_overloads[i] = fh.builtin_overloads[i];
+      {
+        builtin_overloads[i] = fh.builtin_overloads[i];
+        builtin_overloads_checked[i] = fh.builtin_overloads_checked[i];
+      }
 
     overloads = fh.overloads;
   }
@@ -125,6 +131,7 @@ public:
       {
         has_overloads = true;
         builtin_overloads[btyp] = ov_fcn;
+        builtin_overloads_checked[btyp] = 0;
       }
 
   }
@@ -162,6 +169,8 @@ private:
 
   bool set_fcn (const std::string &octaveroot, const std::string& fpath);
 
+  void check_out_of_date (octave_value& f, size_t& checked);
+
   DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA
 
 protected:
@@ -181,6 +190,11 @@ protected:
   // Overloads for other classes.
   str_ov_map overloads;
 
+  // The values of fcn_table_generation when FCN and the overloads for
+  // builtin types were last checked for changes to their files.
+  size_t fcn_checked;
+  size_t builtin_overloads_checked[btyp_num_types];
+
   friend octave_value make_fcn_handle (const std::string &, bool);
 };
 
@@ -1826,6 +1826,20 @@ octave_java::register_type (void)
 #endif
 }
 
+bool
+octave_java::is_vm_running (void)
+{
+#if defined (HAVE_JAVA)
+
+  return jvm != 0;
+
+#else
+
+  return false;
+
+#endif
+}
+
 dim_vector
 octave_java::dims (void) const
 {
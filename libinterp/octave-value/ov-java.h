@@ -175,6 +175,9 @@ public:
   static std::string static_class_name (void) { return "<unknown>"; }
   static void register_type (void);
 
+  // TRUE if a Java VM has been started in this process.
+  static bool is_vm_running (void);
+
 private:
 
   static int t_id;
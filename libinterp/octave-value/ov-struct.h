@@ -197,6 +197,14 @@ public:
                         const std::list<octave_value_list>& idx,
                         bool auto_add);
 
+  // Get or set a field using a cached field index.  getfield returns
+  // an undefined value if the field does not exist.
+  octave_value getfield (octave_field_cache& fc) const
+  { return map.getfield (fc); }
+
+  void setfield (octave_field_cache& fc, const octave_value& val)
+  { map.setfield (fc, val); }
+
   static octave_value numeric_conv (const octave_value& val,
                                     const std::string& type);
 
@@ -29,7 +29,9 @@ along with Octave; see the file COPYING.  If not, see
 
 #include "defun.h"
 #include "error.h"
+#include "oct-map.h"
 #include "ov-typeinfo.h"
+#include "ovl.h"
 
 const int
 octave_value_typeinfo::init_tab_sz (16);
@@ -223,6 +225,9 @@ octave_value_typeinfo::do_register_type (const std::string& t_name,
       type_conv_ops.resize (dim_vector (len, len), 0);
 
       widening_ops.resize (dim_vector (len, len), 0);
+
+      // The keys of the cache depend on the size of the tables.
+      conv_cache.clear ();
     }
 
   types (i) = t_name;
@@ -327,6 +332,9 @@ octave_value_typeinfo::do_register_binary_op (octave_value::binary_op op,
   binary_ops.checkelem (static_cast<int> (op), t1, t2)
     = reinterpret_cast<void *> (f);
 
+  // The conversions that were found before may no longer be needed.
+  conv_cache.clear ();
+
   return false;
 }
 
@@ -594,6 +602,41 @@ octave_value_typeinfo::do_lookup_widening_op (int t, int t_result)
   return reinterpret_cast<octave_base_value::type_conv_fcn> (f);
 }
 
+bool
+octave_value_typeinfo::do_lookup_binary_op_conv (octave_value::binary_op op,
+                                                 int t1, int t2,
+                                                 binary_op_conv& conv)
+{
+  std::map<long, binary_op_conv>::const_iterator p
+    = conv_cache.find (binary_op_key (op, t1, t2));
+
+  if (p == conv_cache.end ())
+    {
+      conv_cache_misses++;
+      return false;
+    }
+
+  conv_cache_hits++;
+  conv = p->second;
+  return true;
+}
+
+void
+octave_value_typeinfo::do_cache_binary_op_conv (octave_value::binary_op op,
+                                                int t1, int t2,
+                                                const binary_op_conv& conv)
+{
+  conv_cache[binary_op_key (op, t1, t2)] = conv;
+}
+
+void
+octave_value_typeinfo::do_clear_binary_op_conv_cache (void)
+{
+  conv_cache.clear ();
+  conv_cache_hits = 0;
+  conv_cache_misses = 0;
+}
+
 string_vector
 octave_value_typeinfo::do_installed_type_names (void)
 {
@@ -723,3 +766,59 @@ currently installed data types.
 ## Test input validation
 %!error typeinfo ("foo", 1)
 */
+
+DEFUN (__dispatch_stats__, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn  {} {@var{stats} =} __dispatch_stats__ ()
+@deftypefnx {} {} __dispatch_stats__ ("clear")
+Return statistics about the cache of conversions used for binary operators
+on types for which no operator function is defined.
+
+@var{stats} is a structure with the fields @code{hits}, @code{misses}, and
+@code{entries}.  With the argument @qcode{"clear"}, empty the cache and
+reset the counts.
+@end deftypefn */)
+{
+  int nargin = args.length ();
+
+  if (nargin > 1)
+    print_usage ();
+
+  if (nargin == 1)
+    {
+      std::string opt = args(0).xstring_value ("__dispatch_stats__: OPT must be a string");
+
+      if (opt != "clear")
+        error ("__dispatch_stats__: unrecognized option '%s'", opt.c_str ());
+
+      octave_value_typeinfo::clear_binary_op_conv_cache ();
+
+      return ovl ();
+    }
+
+  octave_scalar_map m;
+
+  m.assign ("hits", octave_value_typeinfo::binary_op_conv_hits ());
+  m.assign ("misses", octave_value_typeinfo::binary_op_conv_misses ());
+  m.assign ("entries", octave_value_typeinfo::binary_op_conv_entries ());
+
+  return ovl (m);
+}
+
+/*
+%!test
+%! __dispatch_stats__ ("clear");
+%! a = int32 ([1, 2, 3]);
+%! for i = 1:5
+%!   b = a + (1:3);
+%!   c = true + 2;
+%! endfor
+%! s = __dispatch_stats__ ();
+%! assert (b, int32 ([2, 4, 6]));
+%! assert (c, 3);
+%! assert (s.entries >= 2);
+%! assert (s.hits >= 8);
+%! assert (s.misses, s.entries);
+
+%!error <unrecognized option> __dispatch_stats__ ("foo")
+*/
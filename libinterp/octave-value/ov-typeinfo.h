@@ -25,6 +25,7 @@ along with Octave; see the file COPYING.  If not, see
 
 #include "octave-config.h"
 
+#include <map>
 #include <string>
 
 #include "Array.h"
@@ -61,6 +62,27 @@ public:
   typedef octave_value (*assignany_op_fcn)
     (octave_base_value&, const octave_value_list&, const octave_value&);
 
+  // The numeric conversions that do_binary_op applies to the operands
+  // of a binary operator if no function is registered for their types.
+  // If DEMOTE is false, the operator is applied to the converted
+  // operands as usual.  Otherwise, the function registered for the
+  // types of the converted operands is used.
+
+  class
+  binary_op_conv
+  {
+  public:
+
+    binary_op_conv (octave_base_value::type_conv_fcn f1 = 0,
+                    octave_base_value::type_conv_fcn f2 = 0,
+                    bool d = false)
+      : cf1 (f1), cf2 (f2), demote (d) { }
+
+    octave_base_value::type_conv_fcn cf1;
+    octave_base_value::type_conv_fcn cf2;
+    bool demote;
+  };
+
   static bool instance_ok (void);
 
   static int register_type (const std::string&, const std::string&,
@@ -186,6 +208,42 @@ public:
     return instance->do_lookup_widening_op (t, t_result);
   }
 
+  // Cache of the conversions found by do_binary_op.
+
+  static bool
+  lookup_binary_op_conv (octave_value::binary_op op, int t1, int t2,
+                         binary_op_conv& conv)
+  {
+    return instance->do_lookup_binary_op_conv (op, t1, t2, conv);
+  }
+
+  static void
+  cache_binary_op_conv (octave_value::binary_op op, int t1, int t2,
+                        const binary_op_conv& conv)
+  {
+    instance->do_cache_binary_op_conv (op, t1, t2, conv);
+  }
+
+  static octave_idx_type binary_op_conv_hits (void)
+  {
+    return instance->conv_cache_hits;
+  }
+
+  static octave_idx_type binary_op_conv_misses (void)
+  {
+    return instance->conv_cache_misses;
+  }
+
+  static octave_idx_type binary_op_conv_entries (void)
+  {
+    return instance->conv_cache.size ();
+  }
+
+  static void clear_binary_op_conv_cache (void)
+  {
+    instance->do_clear_binary_op_conv_cache ();
+  }
+
   static string_vector installed_type_names (void)
   {
     return instance->do_installed_type_names ();
@@ -208,7 +266,8 @@ protected:
       assignany_ops (dim_vector (octave_value::num_assign_ops, init_tab_sz), 0),
       pref_assign_conv (dim_vector (init_tab_sz, init_tab_sz), -1),
       type_conv_ops (dim_vector (init_tab_sz, init_tab_sz), 0),
-      widening_ops (dim_vector (init_tab_sz, init_tab_sz), 0)  { }
+      widening_ops (dim_vector (init_tab_sz, init_tab_sz), 0),
+      conv_cache (), conv_cache_hits (0), conv_cache_misses (0)  { }
 
   ~octave_value_typeinfo (void) { }
 
@@ -252,6 +311,13 @@ private:
 
   Array<void *> widening_ops;
 
+  // Conversions found by do_binary_op, indexed by binary_op_key.
+  std::map<long, binary_op_conv> conv_cache;
+
+  octave_idx_type conv_cache_hits;
+
+  octave_idx_type conv_cache_misses;
+
   int do_register_type (const std::string&, const std::string&,
                         const octave_value&);
 
@@ -320,6 +386,19 @@ private:
 
   string_vector do_installed_type_names (void);
 
+  long binary_op_key (octave_value::binary_op op, int t1, int t2) const
+  {
+    return (static_cast<long> (op) * types.numel () + t1) * types.numel () + t2;
+  }
+
+  bool do_lookup_binary_op_conv (octave_value::binary_op, int, int,
+                                 binary_op_conv&);
+
+  void do_cache_binary_op_conv (octave_value::binary_op, int, int,
+                                const binary_op_conv&);
+
+  void do_clear_binary_op_conv_cache (void);
+
   // No copying!
 
   octave_value_typeinfo (const octave_value_typeinfo&);
@@ -26,6 +26,7 @@ along with Octave; see the file COPYING.  If not, see
 
 #include <sstream>
 
+#include "oct-probes.h"
 #include "str-vec.h"
 
 #include <defaults.h>
@@ -189,7 +190,8 @@ octave_user_function::octave_user_function
     anonymous_function (false), nested_function (false),
     class_constructor (none), class_method (false),
     parent_scope (-1), local_scope (sid),
-    curr_unwind_protect_frame (0)
+    curr_unwind_protect_frame (0), nargin_record (), nargout_record (),
+    saved_warning_states_record (), ignored_record ()
 #if defined (HAVE_LLVM)
     , jit_info (0)
 #endif
@@ -456,6 +458,16 @@ octave_user_function::do_multi_index_op (int nargout,
   return do_multi_index_op (nargout, args, 0);
 }
 
+#if defined (ENABLE_PROBES)
+
+static void
+probe_function_return (const char *name)
+{
+  OCTAVE_PROBE1 (function__return, name);
+}
+
+#endif
+
 octave_value_list
 octave_user_function::do_multi_index_op (int nargout,
                                          const octave_value_list& _args,
@@ -579,6 +591,11 @@ octave_user_function::do_multi_index_op (int nargout,
   frame.protect_var (tree_evaluator::statement_context);
   tree_evaluator::statement_context = tree_evaluator::function;
 
+#if defined (ENABLE_PROBES)
+  OCTAVE_PROBE2 (function__entry, my_name.c_str (), file_name.c_str ());
+  frame.add_fcn (probe_function_return, my_name.c_str ());
+#endif
+
   BEGIN_PROFILER_BLOCK (octave_user_function)
 
   if (is_special_expr ())
@@ -706,25 +723,40 @@ octave_user_function::bind_automatic_vars
       symbol_table::mark_automatic (".argn.");
     }
 
-  symbol_table::force_assign (".nargin.", nargin);
-  symbol_table::force_assign (".nargout.", nargout);
+  if (anonymous_function)
+    {
+      init_automatic_var_records ();
 
-  symbol_table::mark_hidden (".nargin.");
-  symbol_table::mark_hidden (".nargout.");
+      nargin_record.assign (nargin);
+      nargout_record.assign (nargout);
 
-  symbol_table::mark_automatic (".nargin.");
-  symbol_table::mark_automatic (".nargout.");
+      saved_warning_states_record.assign (octave_value ());
+    }
+  else
+    {
+      symbol_table::force_assign (".nargin.", nargin);
+      symbol_table::force_assign (".nargout.", nargout);
+
+      symbol_table::mark_hidden (".nargin.");
+      symbol_table::mark_hidden (".nargout.");
 
-  symbol_table::assign (".saved_warning_states.");
+      symbol_table::mark_automatic (".nargin.");
+      symbol_table::mark_automatic (".nargout.");
 
-  symbol_table::mark_automatic (".saved_warning_states.");
-  symbol_table::mark_automatic (".saved_warning_states.");
+      symbol_table::assign (".saved_warning_states.");
+
+      symbol_table::mark_automatic (".saved_warning_states.");
+      symbol_table::mark_automatic (".saved_warning_states.");
+    }
 
   if (takes_varargs ())
     symbol_table::assign ("varargin", va_args.cell_value ());
 
   // Force .ignored. variable to be undefined by default.
-  symbol_table::assign (".ignored.");
+  if (anonymous_function)
+    ignored_record.assign (octave_value ());
+  else
+    symbol_table::assign (".ignored.");
 
   if (lvalue_list)
     {
@@ -755,10 +787,39 @@ octave_user_function::bind_automatic_vars
   symbol_table::mark_automatic (".ignored.");
 }
 
+// Anonymous functions are often called many times from functions like
+// cellfun, so look up the records of their automatic variables once
+// instead of by name on every call.  The records are looked up again
+// if they have been removed from the symbol table.
+
+void
+octave_user_function::init_automatic_var_records (void)
+{
+  if (nargin_record.scope () == local_scope && nargin_record.is_valid ()
+      && nargout_record.is_valid ()
+      && saved_warning_states_record.is_valid ()
+      && ignored_record.is_valid ())
+    return;
+
+  nargin_record = symbol_table::insert (".nargin.");
+  nargout_record = symbol_table::insert (".nargout.");
+  saved_warning_states_record = symbol_table::insert (".saved_warning_states.");
+  ignored_record = symbol_table::insert (".ignored.");
+
+  nargin_record.mark_hidden ();
+  nargout_record.mark_hidden ();
+
+  nargin_record.mark_automatic ();
+  nargout_record.mark_automatic ();
+  saved_warning_states_record.mark_automatic ();
+}
+
 void
 octave_user_function::restore_warning_states (void)
 {
-  octave_value val = symbol_table::varval (".saved_warning_states.");
+  octave_value val = (anonymous_function
+                      ? saved_warning_states_record.varval ()
+                      : symbol_table::varval (".saved_warning_states."));
 
   if (val.is_defined ())
     {
@@ -499,6 +499,14 @@ private:
   // pointer to the current unwind_protect frame of this function.
   octave::unwind_protect *curr_unwind_protect_frame;
 
+  // For anonymous functions, the records of the automatic variables
+  // that are set on every call, so that they are only looked up by
+  // name once.
+  symbol_table::symbol_record nargin_record;
+  symbol_table::symbol_record nargout_record;
+  symbol_table::symbol_record saved_warning_states_record;
+  symbol_table::symbol_record ignored_record;
+
 #if defined (HAVE_LLVM)
   jit_function_info *jit_info;
 #endif
@@ -515,6 +523,8 @@ private:
 
   void restore_warning_states (void);
 
+  void init_automatic_var_records (void);
+
   // No copying!
 
   octave_user_function (const octave_user_function& fn);
@@ -26,7 +26,9 @@ along with Octave; see the file COPYING.  If not, see
 #endif
 
 #include "data-conv.h"
+#include "lo-mappers.h"
 #include "quit.h"
+#include "oct-perf-counters.h"
 #include "str-vec.h"
 
 #include "ovl.h"
@@ -67,6 +69,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "ov-class.h"
 #include "ov-classdef.h"
 #include "ov-oncleanup.h"
+#include "ov-containers-map.h"
 #include "ov-cs-list.h"
 #include "ov-colon.h"
 #include "ov-builtin.h"
@@ -115,6 +118,56 @@ octave_value::nil_rep (void)
   return &nr;
 }
 
+// Small nonnegative integers, such as loop counters and indices, and
+// the logical values true and false are stored in reps that are
+// allocated once and then shared.  A rep is never modified in place
+// while it is shared, and these reps always hold an extra reference,
+// so they are never modified or deleted.
+
+static const int small_int_rep_count = 1024;
+
+static octave_base_value **
+make_small_int_reps (void)
+{
+  octave_base_value **reps = new octave_base_value * [small_int_rep_count];
+
+  for (int i = 0; i < small_int_rep_count; i++)
+    reps[i] = new octave_scalar (i);
+
+  return reps;
+}
+
+octave_base_value *
+octave_value::scalar_rep (double d)
+{
+  static octave_base_value **small_int_reps = make_small_int_reps ();
+
+  if (d >= 0 && d < small_int_rep_count && d == static_cast<int> (d)
+      && ! (d == 0 && octave::math::signbit (d)))
+    {
+      octave_base_value *retval = small_int_reps[static_cast<int> (d)];
+
+      retval->count++;
+
+      return retval;
+    }
+  else
+    return new octave_scalar (d);
+}
+
+octave_base_value *
+octave_value::bool_rep (bool b)
+{
+  static octave_base_value *false_rep = new octave_bool (false);
+  static octave_base_value *true_rep = new octave_bool (true);
+
+  octave_base_value *retval = b ? true_rep : false_rep;
+
+  retval->count++;
+
+  return retval;
+}
+
 std::string
 octave_value::unary_op_as_string (unary_op op)
 {
@@ -472,56 +525,56 @@ octave_value::binary_op_to_assign_op (binary_op op)
 }
 
 octave_value::octave_value (short int i)
-  : rep (new octave_scalar (i))
+  : rep (scalar_rep (i))
 {
 }
 
 octave_value::octave_value (unsigned short int i)
-  : rep (new octave_scalar (i))
+  : rep (scalar_rep (i))
 {
 }
 
 octave_value::octave_value (int i)
-  : rep (new octave_scalar (i))
+  : rep (scalar_rep (i))
 {
 }
 
 octave_value::octave_value (unsigned int i)
-  : rep (new octave_scalar (i))
+  : rep (scalar_rep (i))
 {
 }
 
 octave_value::octave_value (long int i)
-  : rep (new octave_scalar (i))
+  : rep (scalar_rep (i))
 {
 }
 
 octave_value::octave_value (unsigned long int i)
-  : rep (new octave_scalar (i))
+  : rep (scalar_rep (i))
 {
 }
 
 #if defined (OCTAVE_HAVE_LONG_LONG_INT)
 octave_value::octave_value (long long int i)
-  : rep (new octave_scalar (i))
+  : rep (scalar_rep (i))
 {
 }
 #endif
 
 #if defined (OCTAVE_HAVE_UNSIGNED_LONG_LONG_INT)
 octave_value::octave_value (unsigned long long int i)
-  : rep (new octave_scalar (i))
+  : rep (scalar_rep (i))
 {
 }
 #endif
 
 octave_value::octave_value (octave::sys::time t)
-  : rep (new octave_scalar (t.double_value ()))
+  : rep (scalar_rep (t.double_value ()))
 {
 }
 
 octave_value::octave_value (double d)
-  : rep (new octave_scalar (d))
+  : rep (scalar_rep (d))
 {
 }
 
@@ -749,7 +802,7 @@ octave_value::octave_value (const PermMatrix& p)
 }
 
 octave_value::octave_value (bool b)
-  : rep (new octave_bool (b))
+  : rep (bool_rep (b))
 {
 }
 
@@ -1961,12 +2014,64 @@ err_binary_op (const std::string& on, const std::string& tn1,
          on.c_str (), tn1.c_str (), tn2.c_str ());
 }
 
+// The value of a rep that is known to be an octave_scalar, without a
+// virtual function call.
+
+static inline double
+scalar_double_value (const octave_base_value *rep)
+{
+  const octave_scalar *s = static_cast<const octave_scalar *> (rep);
+
+  return s->octave_scalar::double_value ();
+}
+
 OCTAVE_NORETURN static void
 err_binary_op_conv (const std::string& on)
 {
   error ("type conversion failed for binary operator '%s'", on.c_str ());
 }
 
+// Find the conversions to apply to the operands V1 and V2 of the
+// binary operator OP if no function is registered for their types.
+// Numeric conversions are preferred to demotions, and converting only
+// one of the operands is preferred to converting both.
+
+static octave_value_typeinfo::binary_op_conv
+find_binary_op_conv (octave_value::binary_op op,
+                     const octave_value& v1, const octave_value& v2)
+{
+  int t1 = v1.type_id ();
+  int t2 = v2.type_id ();
+
+  octave_base_value::type_conv_info cf1 = v1.numeric_conversion_function ();
+  octave_base_value::type_conv_info cf2 = v2.numeric_conversion_function ();
+
+  // Try biased (one-sided) conversions first.
+  if (cf2.type_id () >= 0
+      && octave_value_typeinfo::lookup_binary_op (op, t1, cf2.type_id ()))
+    cf1 = 0;
+  else if (cf1.type_id () >= 0
+           && octave_value_typeinfo::lookup_binary_op (op, cf1.type_id (), t2))
+    cf2 = 0;
+
+  if (cf1 || cf2)
+    return octave_value_typeinfo::binary_op_conv (cf1, cf2, false);
+
+  //demote double -> single and try again
+  cf1 = v1.numeric_demotion_function ();
+  cf2 = v2.numeric_demotion_function ();
+
+  // Try biased (one-sided) conversions first.
+  if (cf2.type_id () >= 0
+      && octave_value_typeinfo::lookup_binary_op (op, t1, cf2.type_id ()))
+    cf1 = 0;
+  else if (cf1.type_id () >= 0
+           && octave_value_typeinfo::lookup_binary_op (op, cf1.type_id (), t2))
+    cf2 = 0;
+
+  return octave_value_typeinfo::binary_op_conv (cf1, cf2, true);
+}
+
 octave_value
 do_binary_op (octave_value::binary_op op,
               const octave_value& v1, const octave_value& v2)
@@ -1976,6 +2081,64 @@ do_binary_op (octave_value::binary_op op,
   int t1 = v1.type_id ();
   int t2 = v2.type_id ();
 
+  // Operations on two double scalars are common enough in loops and
+  // conditions to be done here without looking them up in the type
+  // info table.  The results are the same as those of the functions in
+  // op-s-s.cc.
+
+  if (t1 == octave_scalar::static_type_id ()
+      && t2 == octave_scalar::static_type_id ())
+    {
+      double a = scalar_double_value (v1.rep);
+      double b = scalar_double_value (v2.rep);
+
+      switch (op)
+        {
+        case octave_value::op_add:
+          return octave_value (a + b);
+
+        case octave_value::op_sub:
+          return octave_value (a - b);
+
+        case octave_value::op_mul:
+        case octave_value::op_el_mul:
+          return octave_value (a * b);
+
+        case octave_value::op_div:
+        case octave_value::op_el_div:
+          if (b == 0.0)
+            warn_divide_by_zero ();
+          return octave_value (a / b);
+
+        case octave_value::op_ldiv:
+        case octave_value::op_el_ldiv:
+          if (a == 0.0)
+            warn_divide_by_zero ();
+          return octave_value (b / a);
+
+        case octave_value::op_lt:
+          return octave_value (a < b);
+
+        case octave_value::op_le:
+          return octave_value (a <= b);
+
+        case octave_value::op_eq:
+          return octave_value (a == b);
+
+        case octave_value::op_ge:
+          return octave_value (a >= b);
+
+        case octave_value::op_gt:
+          return octave_value (a > b);
+
+        case octave_value::op_ne:
+          return octave_value (a != b);
+
+        default:
+          break;
+        }
+    }
+
   if (t1 == octave_class::static_type_id ()
       || t2 == octave_class::static_type_id ()
       || t1 == octave_classdef::static_type_id ()
@@ -2002,100 +2165,58 @@ do_binary_op (octave_value::binary_op op,
         retval = f (*v1.rep, *v2.rep);
       else
         {
-          octave_value tv1;
-          octave_base_value::type_conv_info cf1 =
-            v1.numeric_conversion_function ();
-
-          octave_value tv2;
-          octave_base_value::type_conv_info cf2 =
-            v2.numeric_conversion_function ();
-
-          // Try biased (one-sided) conversions first.
-          if (cf2.type_id () >= 0
-              && octave_value_typeinfo::lookup_binary_op (op, t1,
-                                                          cf2.type_id ()))
-            cf1 = 0;
-          else if (cf1.type_id () >= 0
-                   && octave_value_typeinfo::lookup_binary_op (op,
-                                                               cf1.type_id (),
-                                                               t2))
-            cf2 = 0;
-
-          if (cf1)
+          // Finding the conversions involves several virtual function
+          // calls and table lookups, so they are cached.
+
+          octave_value_typeinfo::binary_op_conv conv;
+
+          if (! octave_value_typeinfo::lookup_binary_op_conv (op, t1, t2,
+                                                              conv))
             {
-              octave_base_value *tmp = cf1 (*v1.rep);
+              conv = find_binary_op_conv (op, v1, v2);
+
+              octave_value_typeinfo::cache_binary_op_conv (op, t1, t2, conv);
+            }
+
+          octave_value tv1 = v1;
+          octave_value tv2 = v2;
+
+          if (conv.cf1)
+            {
+              octave::perf_counters::increment
+                (octave::perf_counters::binary_op_conversions);
+
+              octave_base_value *tmp = conv.cf1 (*v1.rep);
 
               if (! tmp)
                 err_binary_op_conv (octave_value::binary_op_as_string (op));
 
               tv1 = octave_value (tmp);
-              t1 = tv1.type_id ();
             }
-          else
-            tv1 = v1;
 
-          if (cf2)
+          if (conv.cf2)
             {
-              octave_base_value *tmp = cf2 (*v2.rep);
+              octave::perf_counters::increment
+                (octave::perf_counters::binary_op_conversions);
+
+              octave_base_value *tmp = conv.cf2 (*v2.rep);
 
               if (! tmp)
                 err_binary_op_conv (octave_value::binary_op_as_string (op));
 
               tv2 = octave_value (tmp);
-              t2 = tv2.type_id ();
             }
-          else
-            tv2 = v2;
 
-          if (cf1 || cf2)
-            {
-              retval = do_binary_op (op, tv1, tv2);
-            }
+          if (! conv.demote)
+            retval = do_binary_op (op, tv1, tv2);
           else
             {
-              //demote double -> single and try again
-              cf1 = tv1.numeric_demotion_function ();
-
-              cf2 = tv2.numeric_demotion_function ();
-
-              // Try biased (one-sided) conversions first.
-              if (cf2.type_id () >= 0
-                  && octave_value_typeinfo::lookup_binary_op (op, t1,
-                                                              cf2.type_id ()))
-                cf1 = 0;
-              else if (cf1.type_id () >= 0
-                       && octave_value_typeinfo::lookup_binary_op (op,
-                                                                   cf1.type_id (),
-                                                                   t2))
-                cf2 = 0;
-
-              if (cf1)
-                {
-                  octave_base_value *tmp = cf1 (*tv1.rep);
-
-                  if (! tmp)
-                    err_binary_op_conv (octave_value::binary_op_as_string (op));
-
-                  tv1 = octave_value (tmp);
-                  t1 = tv1.type_id ();
-                }
-
-              if (cf2)
-                {
-                  octave_base_value *tmp = cf2 (*tv2.rep);
-
-                  if (! tmp)
-                    err_binary_op_conv (octave_value::binary_op_as_string (op));
-
-                  tv2 = octave_value (tmp);
-                  t2 = tv2.type_id ();
-                }
-
-              if (! cf1 && ! cf2)
+              if (! conv.cf1 && ! conv.cf2)
                 err_binary_op (octave_value::binary_op_as_string (op),
                                v1.type_name (), v2.type_name ());
 
-              f = octave_value_typeinfo::lookup_binary_op (op, t1, t2);
+              f = octave_value_typeinfo::lookup_binary_op (op, tv1.type_id (),
+                                                           tv2.type_id ());
 
               if (! f)
                 err_binary_op (octave_value::binary_op_as_string (op),
@@ -2405,6 +2526,9 @@ do_unary_op (octave_value::unary_op op, const octave_value& v)
 
   int t = v.type_id ();
 
+  if (t == octave_scalar::static_type_id () && op == octave_value::op_uminus)
+    return octave_value (- scalar_double_value (v.rep));
+
   if (t == octave_class::static_type_id ()
       || t == octave_classdef::static_type_id ())
     {
@@ -2719,6 +2843,7 @@ install_types (void)
   octave_null_sq_str::register_type ();
   octave_lazy_index::register_type ();
   octave_oncleanup::register_type ();
+  octave_containers_map::register_type ();
   octave_java::register_type ();
 }
 
@@ -3126,5 +3251,39 @@ The original variable value is restored when exiting the function.
 
 %!assert (typeinfo (__test_dr__ (false)), "range")
 %!assert (typeinfo (__test_dr__ (true)), "matrix")
-*/
 
+## Small integers and logical scalars share their values
+%!test
+%! a = 1;
+%! b = 1;
+%! b++;
+%! b += 1;
+%! assert ([a, b], [1, 3]);
+%! c = {1, 1, 1};
+%! c{2}++;
+%! assert (c, {1, 2, 1});
+%! x = true;
+%! y = true;
+%! y(2) = false;
+%! assert (x, true);
+%! assert (y, [true, false]);
+%! z = -0;
+%! assert (1 / z, -Inf);
+
+## Operations on double scalars
+%!test
+%! assert (3 + 4, 7);
+%! assert (3 - 4, -1);
+%! assert (3 * 4, 12);
+%! assert (3 / 4, 0.75);
+%! assert (3 \ 6, 2);
+%! assert (3 .* 4, 12);
+%! assert (3 ./ 4, 0.75);
+%! assert (3 .\ 6, 2);
+%! assert (- 3, -3);
+%! assert (class (3 < 4), "logical");
+%! assert ([3 < 4, 3 <= 4, 3 == 4, 3 >= 4, 3 > 4, 3 != 4],
+%!         [true, true, false, false, false, true]);
+%! assert (NaN == NaN, false);
+%! assert (NaN != NaN, true);
+*/
@@ -309,6 +309,15 @@ public:
     rep->count++;
   }
 
+  // Move constructor.  The moved-from value is left without a rep and
+  // may only be destroyed or assigned to.
+
+  octave_value (octave_value&& a) noexcept
+    : rep (a.rep)
+  {
+    a.rep = 0;
+  }
+
   // This should only be called for derived types.
 
   octave_base_value *clone (void) const;
@@ -320,7 +329,7 @@ public:
 
   ~octave_value (void)
   {
-    if (--rep->count == 0)
+    if (rep && --rep->count == 0)
       delete rep;
   }
 
@@ -359,7 +368,7 @@ public:
   {
     if (rep != a.rep)
       {
-        if (--rep->count == 0)
+        if (rep && --rep->count == 0)
           delete rep;
 
         rep = a.rep;
@@ -369,6 +378,20 @@ public:
     return *this;
   }
 
+  octave_value& operator = (octave_value&& a) noexcept
+  {
+    if (this != &a)
+      {
+        if (rep && --rep->count == 0)
+          delete rep;
+
+        rep = a.rep;
+        a.rep = 0;
+      }
+
+    return *this;
+  }
+
   octave_idx_type get_count (void) const { return rep->count; }
 
   octave_base_value::type_conv_info numeric_conversion_function (void) const
@@ -1422,6 +1445,10 @@ private:
 
   static octave_base_value *nil_rep (void);
 
+  static octave_base_value *scalar_rep (double d);
+
+  static octave_base_value *bool_rep (bool b);
+
   assign_op unary_op_to_assign_op (unary_op op);
 
   binary_op op_eq_to_binary_op (assign_op op);
@@ -29,10 +29,10 @@ along with Octave; see the file COPYING.  If not, see
 #include "ovl.h"
 #include "Cell.h"
 
-// We are likely to have a lot of octave_value_list objects to allocate,
-// so make the grow_size large.
+const octave_idx_type octave_value_list::small_capacity;
 
 octave_value_list::octave_value_list (const std::list<octave_value_list>& lst)
+  : small_len (0), data (), names ()
 {
   octave_idx_type n = 0;
   octave_idx_type nel = 0;
@@ -46,21 +46,104 @@ octave_value_list::octave_value_list (const std::list<octave_value_list>& lst)
     }
 
   // Optimize single-element case
-  if (n == 1)
-    data = lst.front ().data;
-  else if (nel > 0)
+  if (n == 1 && lst.front ().small_len < 0)
     {
+      small_len = -1;
+      data = lst.front ().data;
+    }
+  else if (nel <= small_capacity)
+    {
+      octave_value *v = small_data ();
+
+      for (std::list<octave_value_list>::const_iterator p = lst.begin ();
+           p != lst.end (); p++)
+        {
+          for (octave_idx_type i = 0; i < p->length (); i++)
+            new (v + small_len++) octave_value (p->elem (i));
+        }
+    }
+  else
+    {
+      small_len = -1;
       data.resize (dim_vector (1, nel));
+      octave_value *v = data.fortran_vec ();
       octave_idx_type k = 0;
       for (std::list<octave_value_list>::const_iterator p = lst.begin ();
            p != lst.end (); p++)
         {
-          data.assign (idx_vector (k, k + p->length ()), p->data);
-          k += p->length ();
+          for (octave_idx_type i = 0; i < p->length (); i++)
+            v[k++] = p->elem (i);
         }
       assert (k == nel);
     }
+}
 
+void
+octave_value_list::init (octave_idx_type n, const octave_value& val)
+{
+  if (n >= 0 && n <= small_capacity)
+    {
+      octave_value *v = small_data ();
+
+      for (octave_idx_type i = 0; i < n; i++)
+        new (v + i) octave_value (val);
+
+      small_len = n;
+    }
+  else
+    {
+      small_len = -1;
+      data = Array<octave_value> (dim_vector (1, n), val);
+    }
+}
+
+Array<octave_value>
+octave_value_list::array_value (void) const
+{
+  if (small_len < 0)
+    return data;
+
+  Array<octave_value> retval (dim_vector (1, small_len));
+
+  const octave_value *v = small_data ();
+
+  for (octave_idx_type i = 0; i < small_len; i++)
+    retval.xelem (i) = v[i];
+
+  return retval;
+}
+
+void
+octave_value_list::resize (octave_idx_type n, const octave_value& rfv)
+{
+  if (small_len >= 0)
+    {
+      octave_value *v = small_data ();
+
+      if (n >= 0 && n <= small_capacity)
+        {
+          for (octave_idx_type i = small_len; i < n; i++)
+            new (v + i) octave_value (rfv);
+
+          for (octave_idx_type i = n; i < small_len; i++)
+            v[i].~octave_value ();
+
+          small_len = n;
+
+          return;
+        }
+
+      // The list no longer fits in SMALL_BUF, so move the existing
+      // elements to DATA.
+
+      data = array_value ();
+
+      destroy_small ();
+
+      small_len = -1;
+    }
+
+  data.resize (dim_vector (1, n), rfv);
 }
 
 octave_value_list&
@@ -260,10 +343,54 @@ octave_value_list::make_argv (const std::string& fcn_name) const
   return argv;
 }
 
+octave_value_list
+octave_value_list::slice (octave_idx_type offset, octave_idx_type len,
+                          bool tags) const
+{
+  octave_value_list retval;
+
+  if (small_len < 0)
+    {
+      // linear_slice uses begin/end indices instead of offset and length.
+      // Avoid calling with upper bound out of range.
+      // linear_slice handles the case of len < 0.
+
+      retval = data.linear_slice (offset, std::min (offset + len, length ()));
+    }
+  else
+    {
+      octave_value *v = retval.small_data ();
+
+      for (octave_idx_type i = offset; i < offset + len && i < small_len; i++)
+        new (v + retval.small_len++) octave_value (small_data ()[i]);
+    }
+
+  if (tags && len > 0 && names.numel () > 0)
+    retval.names = names.linear_slice (offset, std::min (offset + len,
+                                                         names.numel ()));
+
+  return retval;
+}
+
 void
 octave_value_list::make_storable_values (void)
 {
   octave_idx_type len = length ();
+
+  if (small_len >= 0)
+    {
+      octave_value *v = small_data ();
+
+      for (octave_idx_type i = 0; i < len; i++)
+        {
+          octave_value tmp = v[i].storable_value ();
+          if (! tmp.is_copy_of (v[i]))
+            v[i] = tmp;
+        }
+
+      return;
+    }
+
   const Array<octave_value>& cdata = data;
 
   for (octave_idx_type i = 0; i < len; i++)
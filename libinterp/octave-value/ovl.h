@@ -26,7 +26,10 @@ along with Octave; see the file COPYING.  If not, see
 
 #include "octave-config.h"
 
+#include <new>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <initializer_list>
 
@@ -43,51 +46,106 @@ octave_value_list
 public:
 
   octave_value_list (void)
-    : data (), names () { }
+    : small_len (0), data (), names () { }
 
   explicit octave_value_list (octave_idx_type n)
-    : data (dim_vector (1, n)), names () { }
+    : small_len (0), data (), names ()
+  {
+    init (n, octave_value ());
+  }
 
   octave_value_list (octave_idx_type n, const octave_value& val)
-    : data (dim_vector (1, n), val), names () { }
+    : small_len (0), data (), names ()
+  {
+    init (n, val);
+  }
 
   octave_value_list (const octave_value& tc)
-    : data (dim_vector (1, 1), tc), names () { }
+    : small_len (1), data (), names ()
+  {
+    new (small_data ()) octave_value (tc);
+  }
 
   octave_value_list (const Array<octave_value>& d)
-    : data (d.as_row ()), names () { }
+    : small_len (-1), data (d.as_row ()), names () { }
 
   octave_value_list (const std::initializer_list<octave_value>& args)
-    : data (dim_vector (1, args.size ())), names ()
+    : small_len (0), data (), names ()
   {
-    octave_idx_type i = 0;
-    for (const octave_value& x : args)
-      data(i++) = x;
+    octave_idx_type n = args.size ();
+
+    if (n <= small_capacity)
+      {
+        for (const octave_value& x : args)
+          new (small_data () + small_len++) octave_value (x);
+      }
+    else
+      {
+        small_len = -1;
+        data.resize (dim_vector (1, n));
+
+        octave_idx_type i = 0;
+        for (const octave_value& x : args)
+          data(i++) = x;
+      }
   }
 
   octave_value_list (const Cell& tc)
-    : data (tc.as_row ()), names () { }
+    : small_len (-1), data (tc.as_row ()), names () { }
 
   octave_value_list (const octave_value_list& obj)
-    : data (obj.data), names (obj.names) { }
+    : small_len (obj.small_len), data (obj.data), names (obj.names)
+  {
+    copy_small (obj);
+  }
+
+  // The moved-from list is left empty if its elements were stored
+  // inline and unchanged otherwise.
+
+  octave_value_list (octave_value_list&& obj)
+    : small_len (obj.small_len), data (obj.data), names (obj.names)
+  {
+    move_small (obj);
+  }
 
   // Concatenation constructor.
   octave_value_list (const std::list<octave_value_list>&);
 
-  ~octave_value_list (void) { }
+  ~octave_value_list (void) { destroy_small (); }
 
   octave_value_list& operator = (const octave_value_list& obj)
   {
     if (this != &obj)
       {
+        destroy_small ();
+
+        small_len = obj.small_len;
+        data = obj.data;
+        names = obj.names;
+
+        copy_small (obj);
+      }
+
+    return *this;
+  }
+
+  octave_value_list& operator = (octave_value_list&& obj)
+  {
+    if (this != &obj)
+      {
+        destroy_small ();
+
+        small_len = obj.small_len;
         data = obj.data;
         names = obj.names;
+
+        move_small (obj);
       }
 
     return *this;
   }
 
-  Array<octave_value> array_value (void) const { return data; }
+  Array<octave_value> array_value (void) const;
 
   Cell cell_value (void) const { return array_value (); }
 
@@ -97,14 +155,12 @@ public:
 
   const octave_value& operator () (octave_idx_type n) const { return elem (n); }
 
-  octave_idx_type length (void) const { return data.numel (); }
+  octave_idx_type length (void) const
+  { return small_len < 0 ? data.numel () : small_len; }
 
   bool empty (void) const { return length () == 0; }
 
-  void resize (octave_idx_type n, const octave_value& rfv = octave_value ())
-  {
-    data.resize (dim_vector (1, n), rfv);
-  }
+  void resize (octave_idx_type n, const octave_value& rfv = octave_value ());
 
   octave_value_list& prepend (const octave_value& val);
 
@@ -115,21 +171,7 @@ public:
   octave_value_list& reverse (void);
 
   octave_value_list
-  slice (octave_idx_type offset, octave_idx_type len, bool tags = false) const
-  {
-    // linear_slice uses begin/end indices instead of offset and length.
-    // Avoid calling with upper bound out of range.
-    // linear_slice handles the case of len < 0.
-
-    octave_value_list retval
-      = data.linear_slice (offset, std::min (offset + len, length ()));
-
-    if (tags && len > 0 && names.numel () > 0)
-      retval.names = names.linear_slice (offset, std::min (offset + len,
-                                                           names.numel ()));
-
-    return retval;
-  }
+  slice (octave_idx_type offset, octave_idx_type len, bool tags = false) const;
 
   octave_value_list
   splice (octave_idx_type offset, octave_idx_type len,
@@ -151,28 +193,91 @@ public:
 
   void make_storable_values (void);
 
-  octave_value& xelem (octave_idx_type i) { return data.xelem (i); }
+  octave_value& xelem (octave_idx_type i)
+  { return small_len < 0 ? data.xelem (i) : small_data ()[i]; }
+
+  void clear (void)
+  {
+    if (small_len < 0)
+      data.clear ();
+    else
+      destroy_small ();
 
-  void clear (void) { data.clear (); }
+    small_len = 0;
+  }
 
 private:
 
+  // Lists of up to this many elements (the common case for function
+  // arguments, return values and index lists) store their elements in
+  // SMALL_BUF instead of allocating an Array.
+
+  static const octave_idx_type small_capacity = 4;
+
+  // Number of elements stored in SMALL_BUF, or -1 if the elements are
+  // stored in DATA.
+
+  octave_idx_type small_len;
+
+  std::aligned_storage<sizeof (octave_value),
+                       alignof (octave_value)>::type small_buf[small_capacity];
+
   Array<octave_value> data;
 
   // This list of strings can be used to tag each element of data with a name.
   // By default, it is empty.
   string_vector names;
 
+  octave_value *small_data (void)
+  { return reinterpret_cast<octave_value *> (small_buf); }
+
+  const octave_value *small_data (void) const
+  { return reinterpret_cast<const octave_value *> (small_buf); }
+
+  void init (octave_idx_type n, const octave_value& val);
+
+  void copy_small (const octave_value_list& obj)
+  {
+    octave_value *v = small_data ();
+    const octave_value *src = obj.small_data ();
+
+    for (octave_idx_type i = 0; i < small_len; i++)
+      new (v + i) octave_value (src[i]);
+  }
+
+  void move_small (octave_value_list& obj)
+  {
+    octave_value *v = small_data ();
+    octave_value *src = obj.small_data ();
+
+    for (octave_idx_type i = 0; i < small_len; i++)
+      {
+        new (v + i) octave_value (std::move (src[i]));
+        src[i].~octave_value ();
+      }
+
+    if (small_len > 0)
+      obj.small_len = 0;
+  }
+
+  void destroy_small (void)
+  {
+    octave_value *v = small_data ();
+
+    for (octave_idx_type i = 0; i < small_len; i++)
+      v[i].~octave_value ();
+  }
+
   octave_value& elem (octave_idx_type n)
   {
     if (n >= length ())
       resize (n + 1);
 
-    return data(n);
+    return small_len < 0 ? data(n) : small_data ()[n];
   }
 
   const octave_value& elem (octave_idx_type n) const
-  { return data(n); }
+  { return small_len < 0 ? data(n) : small_data ()[n]; }
 
 };
 
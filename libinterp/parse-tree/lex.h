@@ -28,6 +28,7 @@ along with Octave; see the file COPYING.  If not, see
 #include <deque>
 #include <limits>
 #include <list>
+#include <map>
 #include <set>
 #include <stack>
 
@@ -277,7 +278,8 @@ public:
       help_text (), string_text (), string_line (0), string_column (0),
       fcn_file_name (), fcn_file_full_name (), looking_at_object_index (),
       parsed_function_name (), pending_local_variables (),
-      symtab_context (), nesting_level (), tokens ()
+      command_syntax_checks (), symtab_context (), nesting_level (),
+      tokens ()
   {
     init ();
   }
@@ -440,6 +442,11 @@ public:
   // set of identifiers that might be local variable names.
   std::set<std::string> pending_local_variables;
 
+  // identifiers at the beginning of a statement whose status as a
+  // variable in the current scope decided whether they might be
+  // command-style function calls, and the value found for each.
+  std::map<std::string, bool> command_syntax_checks;
+
   // Track current symbol table scope and context.
   symbol_table_context symtab_context;
 
@@ -81,6 +81,7 @@ object) relevant global values before and after the nested call.
 %{
 
 #include <cctype>
+#include <cstdlib>
 #include <cstring>
 
 #include <iostream>
@@ -2134,6 +2135,7 @@ lexical_feedback::reset (void)
     parsed_function_name.pop ();
 
   pending_local_variables.clear ();
+  command_syntax_checks.clear ();
   symtab_context.clear ();
   nesting_level.reset ();
   tokens.clear ();
@@ -2760,19 +2762,41 @@ octave_base_lexer::handle_number (void)
   int nread = 0;
 
   char *yytxt = flex_yytext ();
+  int yylng = flex_yyleng ();
 
-  // Strip any underscores
-  char *tmptxt = strsave (yytxt);
-  char *rptr = tmptxt;
-  char *wptr = tmptxt;
-  while (*rptr)
-  {
-    *wptr = *rptr++;
-     wptr += (*wptr != '_');
-  }
-  *wptr = '\0';
+  // Strip any underscores.  Numbers are short, so the string usually
+  // needs no separate allocation.
+  std::string txt;
+  txt.reserve (yylng);
+  bool all_digits = true;
+  for (int i = 0; i < yylng; i++)
+    {
+      char c = yytxt[i];
+      if (c != '_')
+        {
+          txt.push_back (c);
+          all_digits = all_digits && c >= '0' && c <= '9';
+        }
+    }
+
+  const char *tmptxt = txt.c_str ();
+  size_t len = txt.length ();
+
+  if (all_digits && len > 0 && len <= 15)
+    {
+      // Integers of up to 15 digits are exact in a double, so the
+      // common case of data files full of integers does not need the
+      // library conversion.
+      uintmax_t long_int_value = 0;
 
-  if (looks_like_hex (tmptxt, strlen (tmptxt)))
+      for (size_t i = 0; i < len; i++)
+        long_int_value = 10 * long_int_value + (tmptxt[i] - '0');
+
+      value = static_cast<double> (long_int_value);
+
+      nread = 1;
+    }
+  else if (looks_like_hex (tmptxt, len))
     {
       uintmax_t long_int_value;
 
@@ -2780,11 +2804,11 @@ octave_base_lexer::handle_number (void)
 
       value = static_cast<double> (long_int_value);
     }
-  else if (looks_like_bin (tmptxt, strlen (tmptxt)))
+  else if (looks_like_bin (tmptxt, len))
     {
       uintmax_t long_int_value = 0;
 
-      for (size_t i = 0; i < strlen (tmptxt); i++)
+      for (size_t i = 0; i < len; i++)
         {
           long_int_value <<= 1;
           long_int_value += static_cast<uintmax_t> (tmptxt[i] == '1');
@@ -2796,15 +2820,18 @@ octave_base_lexer::handle_number (void)
     }
   else
     {
-      char *idx = strpbrk (tmptxt, "Dd");
+      size_t pos = txt.find_first_of ("Dd");
 
-      if (idx)
-        *idx = 'e';
+      if (pos != std::string::npos)
+        txt[pos] = 'e';
 
-      nread = sscanf (tmptxt, "%lf", &value);
-    }
+      tmptxt = txt.c_str ();
 
-  delete [] tmptxt;
+      char *end;
+      value = strtod (tmptxt, &end);
+
+      nread = (end != tmptxt);
+    }
 
   // If yytext doesn't contain a valid number, we are in deep doo doo.
 
@@ -3092,6 +3119,15 @@ octave_base_lexer::handle_identifier (void)
   token *tok = new token (NAME, &(symbol_table::insert (ident, sid)),
                           input_line_number, current_input_column);
 
+  // Remember how the symbol table affected the decision below so that
+  // a parse of the same text can be reused only when it would still be
+  // the same.
+
+  if (at_beginning_of_statement
+      && (pending_local_variables.find (ident)
+          == pending_local_variables.end ()))
+    command_syntax_checks[ident] = symbol_table::is_variable (ident, sid);
+
   // The following symbols are handled specially so that things like
   //
   //   pi +1
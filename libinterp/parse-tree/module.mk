@@ -20,12 +20,14 @@ PARSE_TREE_INC = \
   libinterp/parse-tree/pt-exp.h \
   libinterp/parse-tree/pt-fcn-handle.h \
   libinterp/parse-tree/pt-funcall.h \
+  libinterp/parse-tree/pt-fuse.h \
   libinterp/parse-tree/pt-id.h \
   libinterp/parse-tree/pt-idx.h \
   libinterp/parse-tree/pt-jump.h \
   libinterp/parse-tree/pt-loop.h \
   libinterp/parse-tree/pt-mat.h \
   libinterp/parse-tree/pt-misc.h \
+  libinterp/parse-tree/pt-parfor.h \
   libinterp/parse-tree/pt-pr-code.h \
   libinterp/parse-tree/pt-select.h \
   libinterp/parse-tree/pt-stmt.h \
@@ -60,12 +62,14 @@ PARSE_TREE_SRC = \
   libinterp/parse-tree/pt-exp.cc \
   libinterp/parse-tree/pt-fcn-handle.cc \
   libinterp/parse-tree/pt-funcall.cc \
+  libinterp/parse-tree/pt-fuse.cc \
   libinterp/parse-tree/pt-id.cc \
   libinterp/parse-tree/pt-idx.cc \
   libinterp/parse-tree/pt-jump.cc \
   libinterp/parse-tree/pt-loop.cc \
   libinterp/parse-tree/pt-mat.cc \
   libinterp/parse-tree/pt-misc.cc \
+  libinterp/parse-tree/pt-parfor.cc \
   libinterp/parse-tree/pt-pr-code.cc \
   libinterp/parse-tree/pt-select.cc \
   libinterp/parse-tree/pt-stmt.cc \
@@ -40,6 +40,7 @@ along with Octave; see the file COPYING.  If not, see
 #include <cstdlib>
 
 #include <iostream>
+#include <list>
 #include <map>
 #include <sstream>
 
@@ -50,6 +51,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "file-ops.h"
 #include "file-stat.h"
 #include "oct-env.h"
+#include "oct-refcount.h"
 #include "oct-time.h"
 #include "quit.h"
 
@@ -2368,6 +2370,95 @@ octave_base_parser::make_anon_fcn_handle (tree_parameter_list *param_list,
   return retval;
 }
 
+// Return true if a binary operation on the constant values A and B may
+// be performed when the expression is parsed.  Operations that may
+// warn, like division by zero, or that depend on the context, like the
+// Matlab-style short-circuit behavior of | and &, are not folded.
+
+static bool
+is_foldable_binary_op (octave_value::binary_op t, const octave_value& a,
+                       const octave_value& b)
+{
+  if (! a.is_numeric_type () || ! b.is_numeric_type ())
+    return false;
+
+  bool scalars = (a.numel () == 1 && b.numel () == 1);
+
+  switch (t)
+    {
+    case octave_value::op_add:
+    case octave_value::op_sub:
+    case octave_value::op_mul:
+    case octave_value::op_el_mul:
+    case octave_value::op_lt:
+    case octave_value::op_le:
+    case octave_value::op_eq:
+    case octave_value::op_ge:
+    case octave_value::op_gt:
+    case octave_value::op_ne:
+      return true;
+
+    case octave_value::op_pow:
+    case octave_value::op_el_pow:
+      return scalars;
+
+    case octave_value::op_div:
+    case octave_value::op_el_div:
+      return scalars && b.complex_value () != 0.0;
+
+    case octave_value::op_ldiv:
+    case octave_value::op_el_ldiv:
+      return scalars && a.complex_value () != 0.0;
+
+    default:
+      return false;
+    }
+}
+
+// Replace an expression whose operands are constants by a constant
+// holding its value.  If evaluating the expression fails, the
+// expression is kept so that the error happens when it is evaluated.
+
+tree_expression *
+octave_base_parser::fold_constant_expression (tree_expression *e)
+{
+  tree_expression *retval = e;
+
+  octave::unwind_protect frame;
+
+  frame.protect_var (discard_error_messages);
+  frame.protect_var (discard_warning_messages);
+
+  discard_error_messages = true;
+  discard_warning_messages = true;
+
+  try
+    {
+      octave_value tmp = e->rvalue1 ();
+
+      tree_constant *tc_retval
+        = new tree_constant (tmp, e->line (), e->column ());
+
+      std::ostringstream buf;
+
+      tree_print_code tpc (buf);
+
+      e->accept (tpc);
+
+      tc_retval->stash_original_text (buf.str ());
+
+      delete e;
+
+      retval = tc_retval;
+    }
+  catch (const octave_execution_exception&)
+    {
+      recover_from_exception ();
+    }
+
+  return retval;
+}
+
 // Build a binary expression.
 
 tree_expression *
@@ -2458,7 +2549,14 @@ octave_base_parser::make_binary_op (int op, tree_expression *op1,
   int l = tok_val->line ();
   int c = tok_val->column ();
 
-  return maybe_compound_binary_expression (op1, op2, l, c, t);
+  tree_expression *retval
+    = maybe_compound_binary_expression (op1, op2, l, c, t);
+
+  if (op1->is_constant () && op2->is_constant ()
+      && is_foldable_binary_op (t, op1->rvalue1 (), op2->rvalue1 ()))
+    retval = fold_constant_expression (retval);
+
+  return retval;
 }
 
 // Build a boolean expression.
@@ -2528,7 +2626,14 @@ octave_base_parser::make_prefix_op (int op, tree_expression *op1,
   int l = tok_val->line ();
   int c = tok_val->column ();
 
-  return new tree_prefix_expression (op1, l, c, t);
+  tree_expression *retval = new tree_prefix_expression (op1, l, c, t);
+
+  if (op1->is_constant ()
+      && (t == octave_value::op_not || t == octave_value::op_uplus
+          || t == octave_value::op_uminus))
+    retval = fold_constant_expression (retval);
+
+  return retval;
 }
 
 // Build a postfix expression.
@@ -2565,7 +2670,13 @@ octave_base_parser::make_postfix_op (int op, tree_expression *op1,
   int l = tok_val->line ();
   int c = tok_val->column ();
 
-  return new tree_postfix_expression (op1, l, c, t);
+  tree_expression *retval = new tree_postfix_expression (op1, l, c, t);
+
+  if (op1->is_constant ()
+      && (t == octave_value::op_hermitian || t == octave_value::op_transpose))
+    retval = fold_constant_expression (retval);
+
+  return retval;
 }
 
 // Build an unwind-protect command.
@@ -4935,59 +5046,312 @@ builtin ("sin", 0)
   return retval;
 }
 
+// A cache of the parse trees of strings evaluated by eval_string.
+// Only strings that contain a single line of statements and no
+// function definitions are cached, and only if parsing them issued no
+// warnings.  Identifiers are looked up again whenever the tree is
+// evaluated, so the same tree may be used in any scope, but whether an
+// identifier at the beginning of a statement is parsed as a command
+// depends on whether it is a variable.  The result of each of those
+// checks is saved with the tree and an entry is only used if all of
+// them still give the same answer.
+
+class
+eval_string_cache
+{
+public:
+
+  class
+  entry
+  {
+  public:
+
+    entry (tree_statement_list *lst, const std::map<std::string, bool>& deps)
+      : stmt_list (lst), command_syntax_checks (deps), print_flag (false),
+        count (1)
+    {
+      tree_expression *expr = single_expression ();
+
+      if (expr)
+        print_flag = expr->print_result ();
+    }
+
+    ~entry (void) { delete stmt_list; }
+
+    tree_expression *single_expression (void) const
+    {
+      if (stmt_list->length () == 1)
+        {
+          tree_statement *stmt = stmt_list->front ();
+
+          if (stmt && stmt->is_expression ())
+            return stmt->expression ();
+        }
+
+      return 0;
+    }
+
+    bool is_valid (void) const
+    {
+      for (std::map<std::string, bool>::const_iterator
+             p = command_syntax_checks.begin ();
+           p != command_syntax_checks.end (); p++)
+        {
+          if (symbol_table::is_variable (p->first) != p->second)
+            return false;
+        }
+
+      return true;
+    }
+
+    // Undo any changes made by evaluating the list in silent mode.
+
+    void reset_print_flag (void)
+    {
+      tree_expression *expr = single_expression ();
+
+      if (expr)
+        expr->set_print_flag (print_flag);
+    }
+
+    tree_statement_list *stmt_list;
+
+    std::map<std::string, bool> command_syntax_checks;
+
+    bool print_flag;
+
+    // One reference for the cache and one for each evaluation in
+    // progress, so that an entry removed from the cache while it is
+    // being evaluated is not deleted until the evaluation is done.
+
+    octave_refcount<int> count;
+
+  private:
+
+    // No copying!
+
+    entry (const entry&);
+
+    entry& operator = (const entry&);
+  };
+
+  // Return the entry for TEXT with an added reference, or 0 if there
+  // is no valid entry.
+
+  static entry *lookup (const std::string& text)
+  {
+    cache_map::iterator p = cache.find (text);
+
+    if (p == cache.end ())
+      {
+        misses++;
+        return 0;
+      }
+
+    entry *e = p->second->second;
+
+    if (! e->is_valid ())
+      {
+        remove (p);
+        misses++;
+        return 0;
+      }
+
+    lru_list.splice (lru_list.begin (), lru_list, p->second);
+
+    hits++;
+
+    e->count++;
+
+    return e;
+  }
+
+  // Take ownership of LST and return its entry with an added reference.
+
+  static entry *insert (const std::string& text, tree_statement_list *lst,
+                        const std::map<std::string, bool>& deps)
+  {
+    cache_map::iterator p = cache.find (text);
+
+    if (p != cache.end ())
+      remove (p);
+
+    while (cache.size () >= max_entries)
+      remove (cache.find (lru_list.back ().first));
+
+    entry *e = new entry (lst, deps);
+
+    lru_list.push_front (lru_elt (text, e));
+
+    cache[text] = lru_list.begin ();
+
+    e->count++;
+
+    return e;
+  }
+
+  static void release (entry *e)
+  {
+    if (--e->count == 0)
+      delete e;
+  }
+
+  static void clear (void)
+  {
+    while (! cache.empty ())
+      remove (cache.begin ());
+
+    hits = 0;
+    misses = 0;
+  }
+
+  static octave_idx_type num_hits (void) { return hits; }
+
+  static octave_idx_type num_misses (void) { return misses; }
+
+  static octave_idx_type num_entries (void) { return cache.size (); }
+
+private:
+
+  typedef std::pair<std::string, entry *> lru_elt;
+
+  typedef std::list<lru_elt> lru_list_type;
+
+  typedef std::map<std::string, lru_list_type::iterator> cache_map;
+
+  static void remove (cache_map::iterator p)
+  {
+    entry *e = p->second->second;
+
+    lru_list.erase (p->second);
+    cache.erase (p);
+
+    release (e);
+  }
+
+  static const size_t max_entries = 128;
+
+  // Most recently used entries first.
+  static lru_list_type lru_list;
+
+  static cache_map cache;
+
+  static octave_idx_type hits;
+
+  static octave_idx_type misses;
+};
+
+eval_string_cache::lru_list_type eval_string_cache::lru_list;
+
+eval_string_cache::cache_map eval_string_cache::cache;
+
+octave_idx_type eval_string_cache::hits = 0;
+
+octave_idx_type eval_string_cache::misses = 0;
+
+// Evaluate one unit of input parsed by eval_string.
+
+static octave_value_list
+eval_statement_list (tree_statement_list *stmt_list, bool silent,
+                     int nargout)
+{
+  octave_value_list retval;
+
+  tree_statement *stmt = 0;
+
+  if (stmt_list->length () == 1
+      && (stmt = stmt_list->front ())
+      && stmt->is_expression ())
+    {
+      tree_expression *expr = stmt->expression ();
+
+      if (silent)
+        expr->set_print_flag (false);
+
+      bool do_bind_ans = false;
+
+      if (expr->is_identifier ())
+        {
+          tree_identifier *id
+            = dynamic_cast<tree_identifier *> (expr);
+
+          do_bind_ans = (! id->is_variable ());
+        }
+      else
+        do_bind_ans = (! expr->is_assignment_expression ());
+
+      retval = expr->rvalue (nargout);
+
+      if (do_bind_ans && ! retval.empty ())
+        bind_ans (retval(0), expr->print_result ());
+
+      if (nargout == 0)
+        retval = octave_value_list ();
+    }
+  else if (nargout == 0)
+    stmt_list->accept (*current_evaluator);
+  else
+    error ("eval: invalid use of statement list");
+
+  return retval;
+}
+
+static octave_value_list
+eval_cached_string (eval_string_cache::entry *e, bool silent, int nargout)
+{
+  octave::unwind_protect frame;
+
+  frame.add_fcn (eval_string_cache::release, e);
+
+  e->reset_print_flag ();
+
+  return eval_statement_list (e->stmt_list, silent, nargout);
+}
+
 octave_value_list
 eval_string (const std::string& eval_str, bool silent,
              int& parse_status, int nargout)
 {
   octave_value_list retval;
 
+  parse_status = 0;
+
+  eval_string_cache::entry *cached = eval_string_cache::lookup (eval_str);
+
+  if (cached)
+    return eval_cached_string (cached, silent, nargout);
+
   octave_parser parser (eval_str);
 
+  bool first_unit = true;
+
   do
     {
       parser.reset ();
 
+      size_t num_warnings = warning_count ();
+
       parse_status = parser.run ();
 
       if (parse_status == 0)
         {
           if (parser.stmt_list)
             {
-              tree_statement *stmt = 0;
-
-              if (parser.stmt_list->length () == 1
-                  && (stmt = parser.stmt_list->front ())
-                  && stmt->is_expression ())
+              if (first_unit && parser.lexer.end_of_input
+                  && parser.max_fcn_depth == 0
+                  && warning_count () == num_warnings)
                 {
-                  tree_expression *expr = stmt->expression ();
+                  cached = eval_string_cache::insert
+                    (eval_str, parser.stmt_list,
+                     parser.lexer.command_syntax_checks);
 
-                  if (silent)
-                    expr->set_print_flag (false);
+                  parser.stmt_list = 0;
 
-                  bool do_bind_ans = false;
-
-                  if (expr->is_identifier ())
-                    {
-                      tree_identifier *id
-                        = dynamic_cast<tree_identifier *> (expr);
-
-                      do_bind_ans = (! id->is_variable ());
-                    }
-                  else
-                    do_bind_ans = (! expr->is_assignment_expression ());
-
-                  retval = expr->rvalue (nargout);
-
-                  if (do_bind_ans && ! retval.empty ())
-                    bind_ans (retval(0), expr->print_result ());
-
-                  if (nargout == 0)
-                    retval = octave_value_list ();
+                  return eval_cached_string (cached, silent, nargout);
                 }
-              else if (nargout == 0)
-                parser.stmt_list->accept (*current_evaluator);
-              else
-                error ("eval: invalid use of statement list");
+
+              retval = eval_statement_list (parser.stmt_list, silent,
+                                            nargout);
 
               if (tree_return_command::returning
                   || tree_break_command::breaking
@@ -4997,6 +5361,8 @@ eval_string (const std::string& eval_str, bool silent,
           else if (parser.lexer.end_of_input)
             break;
         }
+
+      first_unit = false;
     }
   while (parse_status == 0);
 
@@ -5444,6 +5810,95 @@ s = evalc ("t = 42"), t
 
 */
 
+DEFUN (__eval_cache_stats__, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn  {} {@var{stats} =} __eval_cache_stats__ ()
+@deftypefnx {} {} __eval_cache_stats__ ("clear")
+Return statistics about the cache of parsed strings used by @code{eval},
+@code{evalin}, and @code{evalc}.
+
+@var{stats} is a structure with the fields @code{hits}, @code{misses}, and
+@code{entries}.  With the argument @qcode{"clear"}, empty the cache and
+reset the counts.
+@end deftypefn */)
+{
+  int nargin = args.length ();
+
+  if (nargin > 1)
+    print_usage ();
+
+  if (nargin == 1)
+    {
+      std::string opt = args(0).xstring_value ("__eval_cache_stats__: OPT must be a string");
+
+      if (opt != "clear")
+        error ("__eval_cache_stats__: unrecognized option '%s'", opt.c_str ());
+
+      eval_string_cache::clear ();
+
+      return ovl ();
+    }
+
+  octave_scalar_map m;
+
+  m.assign ("hits", eval_string_cache::num_hits ());
+  m.assign ("misses", eval_string_cache::num_misses ());
+  m.assign ("entries", eval_string_cache::num_entries ());
+
+  return ovl (m);
+}
+
+/*
+%!test
+%! __eval_cache_stats__ ("clear");
+%! for k = 1:5
+%!   x = eval ("k * 2;");
+%! endfor
+%! s = __eval_cache_stats__ ();
+%! assert (x, 10);
+%! assert (s.entries, 1);
+%! assert (s.misses, 1);
+%! assert (s.hits, 4);
+
+## Strings with more than one line are not cached.
+%!test
+%! __eval_cache_stats__ ("clear");
+%! for k = 1:3
+%!   eval ("y = k;\ny = y + 1;");
+%! endfor
+%! s = __eval_cache_stats__ ();
+%! assert (y, 4);
+%! assert (s.entries, 0);
+
+## Whether a statement is a command depends on the current variables.
+%!test
+%! str = "class -1";
+%! a = eval (str);
+%! class = 3;
+%! b = eval (str);
+%! clear class
+%! c = eval (str);
+%! assert (a, "char");
+%! assert (b, 2);
+%! assert (c, "char");
+
+## Evaluating silently does not change later output.
+%!test
+%! y = eval ("3 + 4");
+%! s = evalc ("3 + 4");
+%! assert (y, 7);
+%! assert (s, "ans =  7\n");
+
+%!test
+%! y = 0;
+%! for k = 1:3
+%!   eval ("error ('foo');", "y = y + 1;");
+%! endfor
+%! assert (y, 3);
+
+%!error <unrecognized option> __eval_cache_stats__ ("foo")
+*/
+
 DEFUN (__parser_debug_flag__, args, nargout,
        doc: /* -*- texinfo -*-
 @deftypefn  {} {@var{val} =} __parser_debug_flag__ ()
@@ -179,6 +179,9 @@ public:
   tree_anon_fcn_handle *
   make_anon_fcn_handle (tree_parameter_list *param_list, tree_statement *stmt);
 
+  // Replace an expression on constants by its value.
+  tree_expression *fold_constant_expression (tree_expression *e);
+
   // Build a binary expression.
   tree_expression *
   make_binary_op (int op, tree_expression *op1, token *tok_val,
@@ -33,12 +33,20 @@ along with Octave; see the file COPYING.  If not, see
 #include "input.h"
 #include "ovl.h"
 #include "oct-lvalue.h"
+#include "ov-re-mat.h"
+#include "ov-scalar.h"
 #include "pager.h"
+#include "profiler.h"
 #include "ov.h"
 #include "pt-arg-list.h"
+#include "pt-binop.h"
 #include "pt-bp.h"
 #include "pt-assign.h"
+#include "pt-cbinop.h"
 #include "pt-eval.h"
+#include "pt-id.h"
+#include "pt-idx.h"
+#include "pt-mat.h"
 #include "pt-walk.h"
 #include "utils.h"
 #include "variables.h"
@@ -48,7 +56,8 @@ along with Octave; see the file COPYING.  If not, see
 tree_simple_assignment::tree_simple_assignment
   (tree_expression *le, tree_expression *re,
    bool plhs, int l, int c, octave_value::assign_op t)
- : tree_expression (l, c), lhs (le), rhs (re), preserve (plhs), etype (t)
+ : tree_expression (l, c), lhs (le), rhs (re), preserve (plhs), etype (t),
+   update (unknown_update)
 { }
 
 tree_simple_assignment::~tree_simple_assignment (void)
@@ -75,7 +84,20 @@ tree_simple_assignment::rvalue1 (int)
 
   if (rhs)
     {
-      octave_value rhs_val = rhs->rvalue1 ();
+      octave_value rhs_val;
+
+      // The assignment that is performed.  For updates like A = A + B
+      // or x = [x; y], this may be A += B or x(n+1) = y instead, which
+      // modify the value in place if it is not shared.
+
+      octave_value::assign_op op = etype;
+      std::list<octave_value_list> idx;
+
+      if (update == unknown_update)
+        update = classify_update ();
+
+      if (update == no_update || ! eval_update (op, idx, rhs_val))
+        rhs_val = rhs->rvalue1 ();
 
       if (rhs_val.is_undefined ())
         error ("value on right hand side of assignment is undefined");
@@ -90,6 +112,18 @@ tree_simple_assignment::rvalue1 (int)
           rhs_val = lst(0);
         }
 
+      // Assignments like s.a = x need not go through octave_lvalue.
+
+      if (etype == octave_value::op_asn_eq && ! print_result ()
+          && lhs->is_index_expression ())
+        {
+          tree_index_expression *idx_expr
+            = dynamic_cast<tree_index_expression *> (lhs);
+
+          if (idx_expr->fast_field_assign (rhs_val))
+            return rhs_val;
+        }
+
       try
         {
           octave_lvalue ult = lhs->lvalue ();
@@ -97,9 +131,15 @@ tree_simple_assignment::rvalue1 (int)
           if (ult.numel () != 1)
             err_nonbraced_cs_list_assignment ();
 
-          ult.assign (etype, rhs_val);
+          if (! idx.empty ())
+            ult.set_index ("(", idx);
 
-          if (etype == octave_value::op_asn_eq)
+          ult.assign (op, rhs_val);
+
+          if (! idx.empty ())
+            ult.clear_index ();
+
+          if (op == octave_value::op_asn_eq && idx.empty ())
             retval = rhs_val;
           else
             retval = ult.value ();
@@ -132,6 +172,282 @@ tree_simple_assignment::rvalue1 (int)
   return retval;
 }
 
+// Return the kind of update performed by an assignment of the form
+//
+//   A = A op B
+//   x = [x, y]
+//   x = [x; y]
+//
+// where y is a variable or a constant.
+
+tree_simple_assignment::update_type
+tree_simple_assignment::classify_update (void) const
+{
+  if (etype != octave_value::op_asn_eq || ! lhs->is_identifier ())
+    return no_update;
+
+  std::string name = lhs->name ();
+
+  if (rhs->is_binary_expression () && ! rhs->is_boolean_expression ()
+      && ! dynamic_cast<tree_compound_binary_expression *> (rhs))
+    {
+      tree_binary_expression *expr
+        = dynamic_cast<tree_binary_expression *> (rhs);
+
+      tree_expression *op_lhs = expr->lhs ();
+
+      if (! op_lhs || ! op_lhs->is_identifier () || op_lhs->name () != name
+          || ! expr->rhs ())
+        return no_update;
+
+      switch (expr->op_type ())
+        {
+        case octave_value::op_add:
+        case octave_value::op_sub:
+        case octave_value::op_mul:
+        case octave_value::op_div:
+        case octave_value::op_el_mul:
+        case octave_value::op_el_div:
+          return binary_update;
+
+        default:
+          return no_update;
+        }
+    }
+  else if (rhs->is_matrix ())
+    {
+      tree_matrix *mat = dynamic_cast<tree_matrix *> (rhs);
+
+      tree_expression *x = 0;
+      tree_expression *y = 0;
+      update_type retval = no_update;
+
+      if (mat->length () == 1 && mat->front ()->length () == 2)
+        {
+          x = mat->front ()->front ();
+          y = mat->front ()->back ();
+          retval = horzcat_update;
+        }
+      else if (mat->length () == 2 && mat->front ()->length () == 1
+               && mat->back ()->length () == 1)
+        {
+          x = mat->front ()->front ();
+          y = mat->back ()->front ();
+          retval = vertcat_update;
+        }
+
+      if (x && x->is_identifier () && x->name () == name
+          && (y->is_identifier () || y->is_constant ()))
+        return retval;
+    }
+
+  return no_update;
+}
+
+// TRUE if A OP= B computes the same value as A OP B.  The in-place
+// operators do not broadcast and do not warn about division by zero.
+
+static bool
+same_value_in_place (octave_value::binary_op op, const octave_value& a,
+                     const octave_value& b)
+{
+  if (! a.is_numeric_type () || ! b.is_numeric_type ())
+    return false;
+
+  if (op == octave_value::op_div || op == octave_value::op_el_div)
+    return b.is_real_scalar () && b.double_value () != 0;
+
+  return b.numel () == 1 || b.dims () == a.dims ();
+}
+
+// Evaluate the right hand side of an update.  Return false if nothing
+// has been evaluated and the right hand side must be evaluated as
+// usual.  Otherwise, set OP, IDX and RHS_VAL to the assignment that
+// must be performed.
+
+bool
+tree_simple_assignment::eval_update (octave_value::assign_op& op,
+                                     std::list<octave_value_list>& idx,
+                                     octave_value& rhs_val)
+{
+  // Keep the per-operator entries of the profiler.  They are only
+  // timed separately if the profiler is not sampling.
+
+  if (profiler.is_active () && ! profiler.is_sampling ())
+    return false;
+
+  tree_identifier *id = dynamic_cast<tree_identifier *> (lhs);
+
+  if (! id->is_variable ())
+    return false;
+
+  octave_value a = id->symbol ()->varval ();
+
+  if (update == binary_update)
+    {
+      tree_binary_expression *expr
+        = dynamic_cast<tree_binary_expression *> (rhs);
+
+      octave_value::binary_op binop = expr->op_type ();
+
+      octave_value b = expr->rhs ()->rvalue1 ();
+
+      if (b.is_undefined ())
+        return true;
+
+      // Evaluating B may have changed the variable, for example with
+      // assignin.  A OP B uses the value it had before.
+
+      if (! b.is_cs_list () && same_value_in_place (binop, a, b)
+          && a.is_copy_of (id->symbol ()->varval ()))
+        {
+          a = octave_value ();
+
+          op = octave_value::binary_op_to_assign_op (binop);
+          rhs_val = b;
+        }
+      else
+        rhs_val = ::do_binary_op (binop, a, b);
+
+      return true;
+    }
+
+  // Concatenation of real double matrices, where appending Y to X is
+  // the same as assigning Y to the elements just past the end of X.
+  // Evaluating a variable or a constant has no side effects, so the
+  // matrix may be evaluated as usual if that is not the case.
+
+  tree_matrix *mat = dynamic_cast<tree_matrix *> (rhs);
+
+  tree_expression *elt = (update == horzcat_update
+                          ? mat->front ()->back () : mat->back ()->front ());
+
+  if (elt->is_identifier ()
+      && ! dynamic_cast<tree_identifier *> (elt)->is_variable ())
+    return false;
+
+  octave_value y = elt->rvalue1 ();
+
+  int ty = y.type_id ();
+
+  if (a.type_id () != octave_matrix::static_type_id ()
+      || (ty != octave_matrix::static_type_id ()
+          && ty != octave_scalar::static_type_id ())
+      || a.ndims () != 2 || y.ndims () != 2 || y.is_empty ())
+    return false;
+
+  octave_value_list args;
+
+  if (update == horzcat_update)
+    {
+      octave_idx_type nc = a.columns ();
+      octave_idx_type k = y.columns ();
+
+      if (a.rows () != y.rows () || nc == 0)
+        return false;
+
+      args.resize (2);
+      args(0) = octave_value (octave_value::magic_colon_t);
+      args(1) = (k == 1 ? octave_value (nc + 1.0)
+                 : octave_value (Range (nc + 1.0, nc + k)));
+    }
+  else
+    {
+      // Only column vectors can grow in place.  Appending rows to a
+      // matrix moves every column.
+
+      octave_idx_type nr = a.rows ();
+      octave_idx_type k = y.rows ();
+
+      if (a.columns () != 1 || nr < 2 || y.columns () != 1)
+        return false;
+
+      args.resize (1);
+      args(0) = (k == 1 ? octave_value (nr + 1.0)
+                 : octave_value (Range (nr + 1.0, nr + k)));
+    }
+
+  op = octave_value::op_asn_eq;
+  idx.push_back (args);
+  rhs_val = y;
+
+  return true;
+}
+
+/*
+%!test
+%! A = magic (4);
+%! B = A;
+%! A = A + 1;
+%! A = A * 2;
+%! A = A - B;
+%! A = A ./ [1, 2, 3, 4];
+%! assert (B, magic (4));
+%! assert (A, (magic (4) + 2) ./ [1, 2, 3, 4]);
+
+%!test
+%! A = [1, 2; 3, 4];
+%! A = A + [10, 20];
+%! assert (A, [11, 22; 13, 24]);
+%! A = A * A;
+%! assert (A, [11, 22; 13, 24] * [11, 22; 13, 24]);
+%! A = int8 ([100, 50]);
+%! A = A + int8 (100);
+%! assert (A, int8 ([127, 127]));
+
+%!function r = set_a_in_caller ()
+%!  assignin ("caller", "A", 100);
+%!  r = 1;
+%!endfunction
+
+%!test
+%! A = [1, 2];
+%! A = A + set_a_in_caller ();
+%! assert (A, [2, 3]);
+
+%!test
+%! x = [1; 2];
+%! for i = 3:2000
+%!   x = [x; i];
+%! endfor
+%! assert (x, (1:2000)');
+%! y = x;
+%! v = [1; 2];
+%! x = [x; v];
+%! assert (y, (1:2000)');
+%! assert (x, [(1:2000)'; 1; 2]);
+
+%!test
+%! x = [];
+%! for i = 1:1000
+%!   x = [x, i];
+%! endfor
+%! assert (x, 1:1000);
+%! A = ones (2, 1);
+%! for i = 1:100
+%!   v = [i; -i];
+%!   A = [A, v];
+%! endfor
+%! assert (A, [1, 1:100; 1, -(1:100)]);
+
+%!test
+%! x = "ab";
+%! x = [x, 99];
+%! assert (x, "abc");
+%! x = [1, 2];
+%! y = int8 (3);
+%! x = [x, y];
+%! assert (x, int8 ([1, 2, 3]));
+%! x = [1, 2];
+%! s = evalc ("x = [x, 3]");
+%! assert (s, evalc ("x"));
+
+%!error <dimensions mismatch>
+%! x = [1; 2];
+%! y = [3, 4];
+%! x = [x, y];
+*/
+
 std::string
 tree_simple_assignment::oper (void) const
 {
@@ -26,6 +26,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "octave-config.h"
 
 #include <iosfwd>
+#include <list>
 #include <string>
 
 class tree_argument_list;
@@ -49,7 +50,7 @@ public:
   tree_simple_assignment (bool plhs = false, int l = -1, int c = -1,
                           octave_value::assign_op t = octave_value::op_asn_eq)
     : tree_expression (l, c), lhs (0), rhs (0), preserve (plhs), ans_ass (),
-      etype (t) { }
+      etype (t), update (unknown_update) { }
 
   tree_simple_assignment (tree_expression *le, tree_expression *re,
                           bool plhs = false, int l = -1, int c = -1,
@@ -82,11 +83,29 @@ public:
 
 private:
 
+  // Assignments like A = A + B or x = [x; y] that update the value of
+  // a variable.
+
+  enum update_type
+  {
+    unknown_update,
+    no_update,
+    binary_update,
+    horzcat_update,
+    vertcat_update
+  };
+
   void do_assign (octave_lvalue& ult, const octave_value_list& args,
                   const octave_value& rhs_val);
 
   void do_assign (octave_lvalue& ult, const octave_value& rhs_val);
 
+  update_type classify_update (void) const;
+
+  bool eval_update (octave_value::assign_op& op,
+                    std::list<octave_value_list>& idx,
+                    octave_value& rhs_val);
+
   // The left hand side of the assignment.
   tree_expression *lhs;
 
@@ -102,6 +121,10 @@ private:
   // The type of the expression.
   octave_value::assign_op etype;
 
+  // The kind of update performed by the assignment, determined when it
+  // is first evaluated.
+  update_type update;
+
   // No copying!
 
   tree_simple_assignment (const tree_simple_assignment&);
@@ -31,6 +31,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "profiler.h"
 #include "pt-binop.h"
 #include "pt-bp.h"
+#include "pt-fuse.h"
 #include "pt-walk.h"
 #include "variables.h"
 
@@ -40,6 +41,13 @@ static bool Vdo_braindead_shortcircuit_evaluation = true;
 
 // Binary expressions.
 
+tree_binary_expression::~tree_binary_expression (void)
+{
+  delete op_lhs;
+  delete op_rhs;
+  delete fusion;
+}
+
 octave_value_list
 tree_binary_expression::rvalue (int nargout)
 {
@@ -111,6 +119,15 @@ tree_binary_expression::rvalue1 (int)
         }
     }
 
+  if (! fusion_checked)
+    {
+      fusion = tree_elementwise_fusion::create (this);
+      fusion_checked = true;
+    }
+
+  if (fusion && fusion->evaluate (retval))
+    return retval;
+
   if (op_lhs)
     {
       octave_value a = op_lhs->rvalue1 ();
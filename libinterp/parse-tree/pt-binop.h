@@ -28,6 +28,7 @@ along with Octave; see the file COPYING.  If not, see
 #include <string>
 
 class tree_walker;
+class tree_elementwise_fusion;
 
 class octave_value;
 class octave_value_list;
@@ -49,7 +50,8 @@ public:
                             = octave_value::unknown_binary_op)
     : tree_expression (l, c), op_lhs (0), op_rhs (0), etype (t),
       eligible_for_braindead_shortcircuit (false),
-      braindead_shortcircuit_warning_issued (false) { }
+      braindead_shortcircuit_warning_issued (false),
+      fusion (0), fusion_checked (false) { }
 
   tree_binary_expression (tree_expression *a, tree_expression *b,
                           int l = -1, int c = -1,
@@ -57,13 +59,10 @@ public:
                             = octave_value::unknown_binary_op)
     : tree_expression (l, c), op_lhs (a), op_rhs (b), etype (t),
       eligible_for_braindead_shortcircuit (false),
-      braindead_shortcircuit_warning_issued (false) { }
+      braindead_shortcircuit_warning_issued (false),
+      fusion (0), fusion_checked (false) { }
 
-  ~tree_binary_expression (void)
-  {
-    delete op_lhs;
-    delete op_rhs;
-  }
+  ~tree_binary_expression (void);
 
   void mark_braindead_shortcircuit (void)
   {
@@ -123,6 +122,13 @@ private:
   // for this operator.
   bool braindead_shortcircuit_warning_issued;
 
+  // The plan for evaluating this expression in a single loop, if it is
+  // an element-wise expression with more than one operation.
+  tree_elementwise_fusion *fusion;
+
+  // TRUE if we have already looked for such a plan.
+  bool fusion_checked;
+
   void matlab_style_short_circuit_warning (const char *op);
 
   // No copying!
@@ -38,9 +38,11 @@ along with Octave; see the file COPYING.  If not, see
 #include "input.h"
 #include "ov-fcn-handle.h"
 #include "ov-usr-fcn.h"
+#include "profiler.h"
 #include "variables.h"
 #include "pt-all.h"
 #include "pt-eval.h"
+#include "pt-parfor.h"
 #include "symtab.h"
 #include "toplev.h"
 #include "unwind-prot.h"
@@ -284,9 +286,6 @@ tree_evaluator::visit_simple_for_command (tree_simple_for_command& cmd)
   if (debug_mode)
     do_breakpoint (cmd.is_breakpoint (true));
 
-  // FIXME: need to handle PARFOR loops here using cmd.in_parallel ()
-  // and cmd.maxproc_expr ();
-
   octave::unwind_protect frame;
 
   frame.protect_var (in_loop_command);
@@ -297,6 +296,14 @@ tree_evaluator::visit_simple_for_command (tree_simple_for_command& cmd)
 
   octave_value rhs = expr->rvalue1 ();
 
+  if (cmd.in_parallel () && rhs.is_defined ())
+    {
+      tree_parfor_plan *plan = cmd.parallel_plan ();
+
+      if (plan && plan->execute (*this, rhs))
+        return;
+    }
+
 #if defined (HAVE_LLVM)
   if (tree_jit::execute (cmd, rhs))
     return;
@@ -667,6 +674,9 @@ tree_evaluator::visit_statement (tree_statement& stmt)
           if (! Vdebugging)
             octave_call_stack::set_location (stmt.line (), stmt.column ());
 
+          if (profiler.is_active ())
+            profiler.enter_statement (stmt.line ());
+
           if ((statement_context == script
                && ((Vecho_executing_commands & ECHO_SCRIPTS
                     && octave_call_stack::all_scripts ())
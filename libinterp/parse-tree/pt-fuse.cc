@@ -0,0 +1,800 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <cmath>
+
+#include <limits>
+#include <list>
+#include <vector>
+
+#include "lo-mappers.h"
+#include "quit.h"
+
+#include "defun.h"
+#include "error.h"
+#include "errwarn.h"
+#include "ov-re-mat.h"
+#include "ov-scalar.h"
+#include "ovl.h"
+#include "parse.h"
+#include "profiler.h"
+#include "pt-arg-list.h"
+#include "pt-binop.h"
+#include "pt-cbinop.h"
+#include "pt-fuse.h"
+#include "pt-id.h"
+#include "pt-idx.h"
+#include "pt-unop.h"
+#include "symtab.h"
+#include "variables.h"
+
+// TRUE means element-wise expressions are evaluated by
+// tree_elementwise_fusion when possible.
+static bool Vfuse_elementwise = true;
+
+// Number of elements computed at a time by the fused loop.
+static const octave_idx_type fused_block_size = 256;
+
+// Mapper functions that may be fused.  These are the functions used by
+// octave_matrix::map for the corresponding builtin functions.
+
+class fused_mapper
+{
+public:
+
+  const char *name;
+
+  double (*fcn) (double);
+
+  // TRUE if the function returns complex values for negative arguments.
+  bool real_domain_nonneg;
+};
+
+static double
+fused_fix (double x)
+{
+  return octave::math::fix (x);
+}
+
+static double
+fused_round (double x)
+{
+  return octave::math::round (x);
+}
+
+static double
+fused_signum (double x)
+{
+  return octave::math::signum (x);
+}
+
+static const fused_mapper fused_mappers[] =
+{
+  { "abs", ::fabs, false },
+  { "atan", ::atan, false },
+  { "ceil", ::ceil, false },
+  { "cos", ::cos, false },
+  { "cosh", ::cosh, false },
+  { "exp", ::exp, false },
+  { "fix", fused_fix, false },
+  { "floor", ::floor, false },
+  { "log", ::log, true },
+  { "round", fused_round, false },
+  { "sign", fused_signum, false },
+  { "sin", ::sin, false },
+  { "sinh", ::sinh, false },
+  { "sqrt", ::sqrt, true },
+  { "tan", ::tan, false },
+  { "tanh", ::tanh, false },
+  { 0, 0, false }
+};
+
+static const fused_mapper *
+find_fused_mapper (const std::string& name)
+{
+  for (const fused_mapper *p = fused_mappers; p->name; p++)
+    {
+      if (name == p->name)
+        return p;
+    }
+
+  return 0;
+}
+
+static bool
+is_fused_binary_op (octave_value::binary_op op)
+{
+  switch (op)
+    {
+    case octave_value::op_add:
+    case octave_value::op_sub:
+    case octave_value::op_mul:
+    case octave_value::op_div:
+    case octave_value::op_el_mul:
+    case octave_value::op_el_div:
+    case octave_value::op_el_pow:
+      return true;
+
+    default:
+      return false;
+    }
+}
+
+// Same as in xpow.cc.
+
+static inline bool
+xisint (double x)
+{
+  return (octave::math::x_nint (x) == x
+          && ((x >= 0 && x < std::numeric_limits<int>::max ())
+              || (x <= 0 && x > std::numeric_limits<int>::min ())));
+}
+
+class fused_add
+{
+public:
+  double operator () (double x, double y) const { return x + y; }
+};
+
+class fused_sub
+{
+public:
+  double operator () (double x, double y) const { return x - y; }
+};
+
+class fused_mul
+{
+public:
+  double operator () (double x, double y) const { return x * y; }
+};
+
+class fused_div
+{
+public:
+  double operator () (double x, double y) const { return x / y; }
+};
+
+template <typename F>
+static inline void
+fused_binary_op (bool as, double av, const double *a,
+                 bool bs, double bv, const double *b,
+                 double *r, octave_idx_type n, F f)
+{
+  if (as)
+    {
+      for (octave_idx_type i = 0; i < n; i++)
+        r[i] = f (av, b[i]);
+    }
+  else if (bs)
+    {
+      for (octave_idx_type i = 0; i < n; i++)
+        r[i] = f (a[i], bv);
+    }
+  else
+    {
+      for (octave_idx_type i = 0; i < n; i++)
+        r[i] = f (a[i], b[i]);
+    }
+}
+
+tree_elementwise_fusion *
+tree_elementwise_fusion::create (tree_binary_expression *expr)
+{
+  tree_elementwise_fusion *retval = new tree_elementwise_fusion ();
+
+  if (retval->add_node (expr) < 0 || retval->num_ops < 2)
+    {
+      delete retval;
+      retval = 0;
+    }
+
+  return retval;
+}
+
+// Append nodes for EXPR and its operands.  Return the index of the
+// node for EXPR, or -1 if EXPR can't be part of a fused expression.
+
+int
+tree_elementwise_fusion::add_node (tree_expression *expr)
+{
+  if (! expr)
+    return -1;
+
+  if (expr->is_constant () || expr->is_identifier ())
+    nodes.push_back (node (leaf_node, expr));
+  else if (expr->is_binary_expression ())
+    {
+      if (expr->is_boolean_expression ()
+          || dynamic_cast<tree_compound_binary_expression *> (expr))
+        return -1;
+
+      tree_binary_expression *be
+        = dynamic_cast<tree_binary_expression *> (expr);
+
+      if (! is_fused_binary_op (be->op_type ()))
+        return -1;
+
+      int lhs = add_node (be->lhs ());
+      if (lhs < 0)
+        return -1;
+
+      int rhs = add_node (be->rhs ());
+      if (rhs < 0)
+        return -1;
+
+      nodes.push_back (node (binary_node, expr, lhs, rhs));
+      nodes.back ().op = be->op_type ();
+      num_ops++;
+    }
+  else if (expr->is_unary_expression ())
+    {
+      tree_prefix_expression *pe
+        = dynamic_cast<tree_prefix_expression *> (expr);
+
+      if (! pe || pe->op_type () != octave_value::op_uminus)
+        return -1;
+
+      int arg = add_node (pe->operand ());
+      if (arg < 0)
+        return -1;
+
+      nodes.push_back (node (negate_node, expr, arg));
+      num_ops++;
+    }
+  else if (expr->is_index_expression ())
+    {
+      tree_index_expression *ie
+        = dynamic_cast<tree_index_expression *> (expr);
+
+      tree_expression *fcn_expr = ie->expression ();
+
+      if (! fcn_expr->is_identifier () || ie->type_tags () != "(")
+        return -1;
+
+      std::list<tree_argument_list *> args = ie->arg_lists ();
+
+      tree_argument_list *arg_list = args.front ();
+
+      if (! arg_list || arg_list->length () != 1)
+        return -1;
+
+      std::string name = fcn_expr->name ();
+
+      const fused_mapper *m = find_fused_mapper (name);
+
+      if (! m)
+        return -1;
+
+      int arg = add_node (arg_list->front ());
+      if (arg < 0)
+        return -1;
+
+      nodes.push_back (node (mapper_node, fcn_expr, arg));
+      nodes.back ().fcn = m->fcn;
+      nodes.back ().real_domain_nonneg = m->real_domain_nonneg;
+      nodes.back ().fcn_name = name;
+      num_ops++;
+    }
+  else
+    return -1;
+
+  return nodes.size () - 1;
+}
+
+bool
+tree_elementwise_fusion::evaluate (octave_value& retval)
+{
+  // Keep the per-operator entries of the profiler.  They are only
+  // timed separately if the profiler is not sampling.
+
+  if (! Vfuse_elementwise
+      || (profiler.is_active () && ! profiler.is_sampling ()))
+    return false;
+
+  int n = nodes.size ();
+
+  // Before evaluating anything, check that identifiers still refer to
+  // variables.  The fused loop is only used if at least one operand is
+  // a real array, so give up on scalar expressions here, before
+  // anything is allocated or any function is looked up.  Getting the
+  // values of variables and constants is not observable.
+
+  bool have_array = false;
+
+  for (int k = 0; k < n; k++)
+    {
+      const node& nd = nodes[k];
+
+      if (nd.type != leaf_node)
+        continue;
+
+      if (nd.expr->is_identifier ()
+          && ! dynamic_cast<tree_identifier *> (nd.expr)->is_variable ())
+        return false;
+
+      if (! have_array
+          && (nd.expr->rvalue1 ().type_id ()
+              == octave_matrix::static_type_id ()))
+        have_array = true;
+    }
+
+  if (! have_array)
+    return false;
+
+  // Check that the mapper names refer to the builtin functions.
+
+  for (int k = 0; k < n; k++)
+    {
+      const node& nd = nodes[k];
+
+      if (nd.type == mapper_node)
+        {
+          tree_identifier *id = dynamic_cast<tree_identifier *> (nd.expr);
+
+          if (id->is_variable ())
+            return false;
+
+          octave_value fcn = symbol_table::find_function (nd.fcn_name);
+
+          if (! fcn.is_builtin_function ())
+            return false;
+        }
+    }
+
+  std::vector<octave_value> vals (n);
+
+  for (int k = 0; k < n; k++)
+    {
+      if (nodes[k].type == leaf_node)
+        vals[k] = nodes[k].expr->rvalue1 ();
+    }
+
+  std::vector<operand> ops (n);
+  dim_vector dims;
+  int num_div_by_zero = 0;
+
+  if (prepare (vals, ops, dims, num_div_by_zero))
+    {
+      if (ops[n-1].scalar)
+        {
+          retval = vals[n-1];
+          return true;
+        }
+
+      octave_idx_type nel = dims.numel ();
+
+      NDArray result (dims);
+      double *r = result.fortran_vec ();
+
+      octave_idx_type block_len = std::min (fused_block_size, nel);
+
+      std::vector<double> bufs (n * block_len);
+
+      for (int k = 0; k < n; k++)
+        ops[k].buf = &bufs[k * block_len];
+
+      bool ok = true;
+
+      for (octave_idx_type off = 0; off < nel; off += fused_block_size)
+        {
+          octave_quit ();
+
+          octave_idx_type len = std::min (fused_block_size, nel - off);
+
+          if (! eval_block (ops, n-1, off, len, r + off))
+            {
+              ok = false;
+              break;
+            }
+        }
+
+      if (ok)
+        {
+          for (int i = 0; i < num_div_by_zero; i++)
+            warn_divide_by_zero ();
+
+          retval = result;
+          return true;
+        }
+    }
+
+  retval = generic_value (vals, n-1);
+
+  return true;
+}
+
+// Find the dimensions of the result and the operands of the fused loop.
+// Operations on scalars are performed here, one at a time, and their
+// values are stored in VALS.  Return false if the fused loop can't be
+// used.
+
+bool
+tree_elementwise_fusion::prepare (std::vector<octave_value>& vals,
+                                  std::vector<operand>& ops,
+                                  dim_vector& dims,
+                                  int& num_div_by_zero) const
+{
+  int n = nodes.size ();
+
+  bool have_dims = false;
+
+  for (int k = 0; k < n; k++)
+    {
+      const node& nd = nodes[k];
+
+      operand& opk = ops[k];
+
+      switch (nd.type)
+        {
+        case leaf_node:
+          break;
+
+        case binary_node:
+          {
+            const operand& a = ops[nd.lhs];
+            const operand& b = ops[nd.rhs];
+
+            if (a.scalar && b.scalar)
+              vals[k] = ::do_binary_op (nd.op, vals[nd.lhs], vals[nd.rhs]);
+            else
+              {
+                // Only the element-wise cases of these operators.
+
+                if ((nd.op == octave_value::op_mul && ! (a.scalar || b.scalar))
+                    || (nd.op == octave_value::op_div && ! b.scalar)
+                    || (nd.op == octave_value::op_el_pow && ! b.scalar))
+                  return false;
+
+                if ((nd.op == octave_value::op_div
+                     || nd.op == octave_value::op_el_div)
+                    && b.scalar && b.scalar_value == 0.0)
+                  num_div_by_zero++;
+              }
+          }
+          break;
+
+        case negate_node:
+          if (ops[nd.lhs].scalar)
+            vals[k] = ::do_unary_op (octave_value::op_uminus, vals[nd.lhs]);
+          break;
+
+        case mapper_node:
+          if (ops[nd.lhs].scalar)
+            {
+              octave_value_list tmp = feval (nd.fcn_name,
+                                             ovl (vals[nd.lhs]), 1);
+
+              if (tmp.length () > 0)
+                vals[k] = tmp(0);
+            }
+          break;
+        }
+
+      const octave_value& val = vals[k];
+
+      if (val.is_defined ())
+        {
+          // A leaf or an operation on scalars.
+
+          if (val.type_id () == octave_scalar::static_type_id ())
+            {
+              opk.scalar = true;
+              opk.scalar_value = val.double_value ();
+            }
+          else if (val.type_id () == octave_matrix::static_type_id ())
+            {
+              opk.array = val.array_value ();
+              opk.data = opk.array.data ();
+
+              if (! have_dims)
+                {
+                  dims = opk.array.dims ();
+                  have_dims = true;
+                }
+              else if (opk.array.dims () != dims)
+                return false;
+            }
+          else
+            return false;
+        }
+      else if (nd.type == leaf_node)
+        return false;
+    }
+
+  return have_dims ? dims.numel () > 0 : ops[n-1].scalar;
+}
+
+// Compute elements OFF to OFF+LEN-1 of node K, which is not a scalar.
+// The result is stored in DEST unless K is a leaf.  Return a pointer
+// to the result, or 0 if the result would be complex.
+
+const double *
+tree_elementwise_fusion::eval_block (std::vector<operand>& ops, int k,
+                                     octave_idx_type off,
+                                     octave_idx_type len,
+                                     double *dest) const
+{
+  const node& nd = nodes[k];
+
+  if (nd.type == leaf_node || ops[k].data)
+    return ops[k].data + off;
+
+  const operand& a = ops[nd.lhs];
+
+  const double *av = 0;
+
+  if (! a.scalar)
+    {
+      av = eval_block (ops, nd.lhs, off, len, a.buf);
+
+      if (! av)
+        return 0;
+    }
+
+  switch (nd.type)
+    {
+    case binary_node:
+      {
+        const operand& b = ops[nd.rhs];
+
+        const double *bv = 0;
+
+        if (! b.scalar)
+          {
+            bv = eval_block (ops, nd.rhs, off, len, b.buf);
+
+            if (! bv)
+              return 0;
+          }
+
+        double as = a.scalar_value;
+        double bs = b.scalar_value;
+
+        switch (nd.op)
+          {
+          case octave_value::op_add:
+            fused_binary_op (a.scalar, as, av, b.scalar, bs, bv, dest, len,
+                             fused_add ());
+            break;
+
+          case octave_value::op_sub:
+            fused_binary_op (a.scalar, as, av, b.scalar, bs, bv, dest, len,
+                             fused_sub ());
+            break;
+
+          case octave_value::op_mul:
+          case octave_value::op_el_mul:
+            fused_binary_op (a.scalar, as, av, b.scalar, bs, bv, dest, len,
+                             fused_mul ());
+            break;
+
+          case octave_value::op_div:
+          case octave_value::op_el_div:
+            fused_binary_op (a.scalar, as, av, b.scalar, bs, bv, dest, len,
+                             fused_div ());
+            break;
+
+          case octave_value::op_el_pow:
+            // Same as elem_xpow (const NDArray&, double).
+            if (xisint (bs))
+              {
+                int ib = static_cast<int> (bs);
+
+                if (ib == 2)
+                  {
+                    for (octave_idx_type i = 0; i < len; i++)
+                      dest[i] = av[i] * av[i];
+                  }
+                else if (ib == 3)
+                  {
+                    for (octave_idx_type i = 0; i < len; i++)
+                      dest[i] = av[i] * av[i] * av[i];
+                  }
+                else if (ib == -1)
+                  {
+                    for (octave_idx_type i = 0; i < len; i++)
+                      dest[i] = 1.0 / av[i];
+                  }
+                else
+                  {
+                    for (octave_idx_type i = 0; i < len; i++)
+                      dest[i] = std::pow (av[i], ib);
+                  }
+              }
+            else
+              {
+                for (octave_idx_type i = 0; i < len; i++)
+                  {
+                    if (av[i] < 0)
+                      return 0;
+
+                    dest[i] = std::pow (av[i], bs);
+                  }
+              }
+            break;
+
+          default:
+            panic_impossible ();
+          }
+      }
+      break;
+
+    case negate_node:
+      for (octave_idx_type i = 0; i < len; i++)
+        dest[i] = -av[i];
+      break;
+
+    case mapper_node:
+      if (nd.real_domain_nonneg)
+        {
+          for (octave_idx_type i = 0; i < len; i++)
+            {
+              if (av[i] < 0)
+                return 0;
+
+              dest[i] = nd.fcn (av[i]);
+            }
+        }
+      else
+        {
+          for (octave_idx_type i = 0; i < len; i++)
+            dest[i] = nd.fcn (av[i]);
+        }
+      break;
+
+    default:
+      panic_impossible ();
+    }
+
+  return dest;
+}
+
+// Perform the operations of node K and its operands one at a time,
+// reusing the values already stored in VALS.
+
+octave_value
+tree_elementwise_fusion::generic_value (std::vector<octave_value>& vals,
+                                        int k) const
+{
+  if (vals[k].is_defined ())
+    return vals[k];
+
+  const node& nd = nodes[k];
+
+  octave_value a = generic_value (vals, nd.lhs);
+
+  if (a.is_undefined ())
+    return a;
+
+  switch (nd.type)
+    {
+    case binary_node:
+      {
+        octave_value b = generic_value (vals, nd.rhs);
+
+        if (b.is_defined ())
+          vals[k] = ::do_binary_op (nd.op, a, b);
+      }
+      break;
+
+    case negate_node:
+      vals[k] = ::do_unary_op (octave_value::op_uminus, a);
+      break;
+
+    case mapper_node:
+      {
+        octave_value_list tmp = feval (nd.fcn_name, ovl (a), 1);
+
+        if (tmp.length () > 0)
+          vals[k] = tmp(0);
+      }
+      break;
+
+    default:
+      panic_impossible ();
+    }
+
+  return vals[k];
+}
+
+DEFUN (__fuse_elementwise__, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn  {} {@var{val} =} __fuse_elementwise__ ()
+@deftypefnx {} {@var{old_val} =} __fuse_elementwise__ (@var{new_val})
+@deftypefnx {} {} __fuse_elementwise__ (@var{new_val}, "local")
+Query or set the internal variable that controls whether element-wise
+expressions on real double arrays are evaluated in a single loop.
+
+When called from inside a function with the @qcode{"local"} option, the
+variable is changed locally for the function and any subroutines it calls.
+The original variable value is restored when exiting the function.
+@end deftypefn */)
+{
+  return set_internal_variable (Vfuse_elementwise, args, nargout,
+                                "__fuse_elementwise__");
+}
+
+/*
+%!function y = __unfused__ (f, varargin)
+%!  old = __fuse_elementwise__ (false);
+%!  unwind_protect
+%!    y = f (varargin{:});
+%!  unwind_protect_cleanup
+%!    __fuse_elementwise__ (old);
+%!  end_unwind_protect
+%!endfunction
+
+%!test
+%! a = rand (30, 40);  b = rand (30, 40) - 0.5;  c = rand (30, 40);
+%! f = @(a, b, c) a .* b + c .* exp (-b) - 2 * abs (b) ./ (a + 1);
+%! assert (f (a, b, c), __unfused__ (f, a, b, c));
+%! y = a .* b + c .* exp (-b) - 2 * abs (b) ./ (a + 1);
+%! assert (y, __unfused__ (f, a, b, c));
+
+%!test
+%! x = linspace (-2, 2, 1001);
+%! y = x.^2 + x.^3 - x.^-1 + sign (x) .* floor (x .* 3);
+%! assert (y, __unfused__ (@(x) x.^2 + x.^3 - x.^-1 + sign (x) .* floor (x .* 3), x));
+
+## Results that would be complex fall back to the usual evaluation
+%!test
+%! x = [4, 1, -1, 9];
+%! assert (sqrt (x) + 1, [3, 2, 1+i, 4]);
+%! assert (x.^0.5 .* 2, [4, 2, 2i, 6]);
+%! assert (log (x) + 0, log (x));
+
+## Mixed types, sizes and scalar operands
+%!test
+%! x = single ([1, 2, 3]);
+%! assert (class (x .* 2 + 1), "single");
+%! assert (int8 ([1, 2]) .* 2 + 1, int8 ([3, 5]));
+%! assert ([1, 2] .* [1; 2] + 1, [2, 3; 3, 5]);
+%! assert (2 * 3 + 1, 7);
+%! a = 2;
+%! assert (a .* a + a, 6);
+
+%!error <nonconformant arguments> [1, 2] .* [1, 2, 3] + 1
+%!error <undefined> __undefined_variable__ .* 2 + 1
+
+%!test
+%! x = [1, 2, 3];
+%! exp = [10, 20, 30];
+%! assert (exp (2) .* x + 1, [21, 41, 61]);
+
+## Scalar expressions are left to the tree
+%!test
+%! s = 0;
+%! a = 3;
+%! for i = 1:10
+%!   s = s + a .* i - exp (-i);
+%! endfor
+%! assert (s, 165 - sum (exp (-(1:10))), -eps);
+%! b = int8 (5);
+%! assert (b .* a + 1, int8 (16));
+
+%!test
+%! assert (__fuse_elementwise__ (), true);
+*/
@@ -0,0 +1,155 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if ! defined (octave_pt_fuse_h)
+#define octave_pt_fuse_h 1
+
+#include "octave-config.h"
+
+#include <string>
+#include <vector>
+
+#include "dNDArray.h"
+#include "ov.h"
+
+class tree_expression;
+class tree_binary_expression;
+class tree_identifier;
+
+// Evaluation of element-wise expressions like
+//
+//   a .* b + c .* exp (-d)
+//
+// over real double arrays in a single loop.  The loop works on blocks
+// of elements so that intermediate values stay in small buffers
+// instead of full-size temporary arrays.  The operands must be
+// variables or constants, so evaluating all of them before any of the
+// operations is not observable.  If the values turn out to be
+// unsuitable (other types, different sizes, results that would be
+// complex), the operations are performed one at a time on the values
+// that have already been computed, exactly as the tree would have done.
+
+class
+tree_elementwise_fusion
+{
+public:
+
+  // Return a plan for evaluating the tree rooted at EXPR, or 0 if the
+  // tree does not contain at least two operations that can be fused.
+
+  static tree_elementwise_fusion *create (tree_binary_expression *expr);
+
+  ~tree_elementwise_fusion (void) { }
+
+  // Evaluate the expression and store its value in RETVAL.  If the
+  // expression must be evaluated by the tree instead, return false
+  // without evaluating any part of it other than looking up the values
+  // of its operands.
+
+  bool evaluate (octave_value& retval);
+
+private:
+
+  typedef double (*mapper_fcn) (double);
+
+  enum node_type
+  {
+    leaf_node,
+    binary_node,
+    negate_node,
+    mapper_node
+  };
+
+  // One operation or operand of the expression.  Operands always
+  // precede the operations that use them.
+
+  class node
+  {
+  public:
+
+    node (node_type t, tree_expression *e, int a = -1, int b = -1)
+      : type (t), op (octave_value::unknown_binary_op), lhs (a), rhs (b),
+        expr (e), fcn (0), real_domain_nonneg (false), fcn_name () { }
+
+    node_type type;
+
+    octave_value::binary_op op;
+
+    int lhs;
+    int rhs;
+
+    // The operand for leaf nodes, the function name for mapper nodes.
+    tree_expression *expr;
+
+    mapper_fcn fcn;
+
+    // TRUE if FCN produces complex values for negative arguments.
+    bool real_domain_nonneg;
+
+    std::string fcn_name;
+  };
+
+  // The values of an operand or operation during one evaluation.
+
+  class operand
+  {
+  public:
+
+    operand (void)
+      : scalar (false), scalar_value (0), array (), data (0), buf (0) { }
+
+    bool scalar;
+    double scalar_value;
+
+    // The values of array leaves.
+    NDArray array;
+    const double *data;
+
+    // Storage for one block of the values of an operation.
+    double *buf;
+  };
+
+  tree_elementwise_fusion (void) : nodes (), num_ops (0) { }
+
+  int add_node (tree_expression *expr);
+
+  bool prepare (std::vector<octave_value>& vals, std::vector<operand>& ops,
+                dim_vector& dims, int& num_div_by_zero) const;
+
+  const double *eval_block (std::vector<operand>& ops, int k,
+                            octave_idx_type off, octave_idx_type len,
+                            double *dest) const;
+
+  octave_value generic_value (std::vector<octave_value>& vals, int k) const;
+
+  std::vector<node> nodes;
+
+  int num_ops;
+
+  // No copying!
+
+  tree_elementwise_fusion (const tree_elementwise_fusion&);
+
+  tree_elementwise_fusion& operator = (const tree_elementwise_fusion&);
+};
+
+#endif
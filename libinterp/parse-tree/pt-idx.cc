@@ -30,6 +30,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "ovl.h"
 #include "oct-lvalue.h"
 #include "ov.h"
+#include "ov-struct.h"
 #include "pager.h"
 #include "pt-arg-list.h"
 #include "pt-bp.h"
@@ -88,6 +89,9 @@ tree_index_expression::append (tree_argument_list *lst, char t)
 void
 tree_index_expression::append (const std::string& n)
 {
+  if (field_cache.size () == type.length ())
+    field_cache.push_back (octave_field_cache (n));
+
   args.push_back (static_cast<tree_argument_list *> (0));
   type.append (".");
   arg_nm.push_back (n);
@@ -321,7 +325,10 @@ tree_index_expression::rvalue (int nargout,
   if (first_expr_val.is_undefined ())
     first_expr_val = expr->rvalue1 ();
 
-  octave_value tmp = first_expr_val;
+  if (fast_field_ref (first_expr_val, retval))
+    return retval;
+
+  octave_value tmp = std::move (first_expr_val);
   octave_idx_type tmpi = 0;
 
   std::list<octave_value_list> idx;
@@ -398,7 +405,7 @@ tree_index_expression::rvalue (int nargout,
         case '(':
           if (have_args)
             {
-              idx.push_back (first_args);
+              idx.push_back (std::move (first_args));
               have_args = false;
             }
           else
@@ -453,6 +460,40 @@ tree_index_expression::rvalue (int nargout,
   return retval;
 }
 
+// If all indices are constant field names and VAL and each
+// intermediate result are scalar structs with the named fields, look
+// up the fields using the cached field indices.  Otherwise, return
+// false and leave the evaluation (and any error) to subsref.
+
+bool
+tree_index_expression::fast_field_ref (const octave_value& val,
+                                       octave_value_list& retval)
+{
+  if (field_cache.size () != type.length ())
+    return false;
+
+  octave_value tmp = val;
+
+  for (std::vector<octave_field_cache>::iterator p = field_cache.begin ();
+       p != field_cache.end (); p++)
+    {
+      if (tmp.type_id () != octave_scalar_struct::static_type_id ())
+        return false;
+
+      const octave_scalar_struct *s
+        = static_cast<const octave_scalar_struct *> (tmp.internal_rep ());
+
+      tmp = s->getfield (*p);
+
+      if (tmp.is_undefined ())
+        return false;
+    }
+
+  retval = ovl (tmp);
+
+  return true;
+}
+
 octave_value
 tree_index_expression::rvalue1 (int nargout)
 {
@@ -655,6 +696,37 @@ tree_index_expression::lvalue (void)
 %! assert (x(2).b == 1);
 */
 
+// If this is an expression like s.a in which the index is a constant
+// field name and S is an unshared scalar struct variable, store RHS in
+// the field directly and return true.  Otherwise, return false and
+// leave the assignment to octave_lvalue::assign.
+
+bool
+tree_index_expression::fast_field_assign (const octave_value& rhs)
+{
+  if (type.length () != 1 || field_cache.size () != 1
+      || ! expr->is_identifier ())
+    return false;
+
+  tree_identifier *id = dynamic_cast<tree_identifier *> (expr);
+
+  if (! id->is_variable ())
+    return false;
+
+  octave_value& val = id->symbol ()->varref ();
+
+  if (val.type_id () != octave_scalar_struct::static_type_id ()
+      || val.get_count () != 1)
+    return false;
+
+  octave_scalar_struct *s
+    = static_cast<octave_scalar_struct *> (val.internal_rep ());
+
+  s->setfield (field_cache[0], rhs.storable_value ());
+
+  return true;
+}
+
 tree_index_expression *
 tree_index_expression::dup (symbol_table::scope_id scope,
                             symbol_table::context_id context) const
@@ -681,6 +753,8 @@ tree_index_expression::dup (symbol_table::scope_id scope,
 
   new_idx_expr->arg_nm = arg_nm;
 
+  new_idx_expr->field_cache = field_cache;
+
   std::list<tree_expression *> new_dyn_field;
 
   for (std::list<tree_expression *>::const_iterator p = dyn_field.begin ();
@@ -36,8 +36,11 @@ class octave_value;
 class octave_value_list;
 class octave_lvalue;
 
+#include <vector>
+
 #include "str-vec.h"
 
+#include "oct-map.h"
 #include "pt-exp.h"
 #include "symtab.h"
 
@@ -79,6 +82,8 @@ public:
 
   std::list<string_vector> arg_names (void) { return arg_nm; }
 
+  std::list<tree_expression *> dyn_fields (void) { return dyn_field; }
+
   bool lvalue_ok (void) const { return expr->lvalue_ok (); }
 
   bool rvalue_ok (void) const { return true; }
@@ -92,6 +97,8 @@ public:
 
   octave_lvalue lvalue (void);
 
+  bool fast_field_assign (const octave_value& rhs);
+
   tree_index_expression *dup (symbol_table::scope_id scope,
                               symbol_table::context_id context) const;
 
@@ -115,10 +122,16 @@ private:
   // The list of dynamic field names, if any.
   std::list<tree_expression *> dyn_field;
 
+  // Cached field indices.  Only valid if all indices are constant
+  // field names, in which case there is one element for each index.
+  std::vector<octave_field_cache> field_cache;
+
   tree_index_expression (int l, int c);
 
   octave_map make_arg_struct (void) const;
 
+  bool fast_field_ref (const octave_value& val, octave_value_list& retval);
+
   std::string
   get_struct_index
     (std::list<string_vector>::const_iterator p_arg_nm,
@@ -38,6 +38,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "pt-jit.h"
 #include "pt-jump.h"
 #include "pt-loop.h"
+#include "pt-parfor.h"
 #include "pt-stmt.h"
 #include "pt-walk.h"
 #include "unwind-prot.h"
@@ -101,11 +102,26 @@ tree_simple_for_command::~tree_simple_for_command (void)
   delete list;
   delete lead_comm;
   delete trail_comm;
+  delete parfor_plan;
 #if defined (HAVE_LLVM)
   delete compiled;
 #endif
 }
 
+tree_parfor_plan *
+tree_simple_for_command::parallel_plan (void)
+{
+  if (! parfor_plan_checked)
+    {
+      if (parallel)
+        parfor_plan = tree_parfor_plan::create (*this);
+
+      parfor_plan_checked = true;
+    }
+
+  return parfor_plan;
+}
+
 tree_command *
 tree_simple_for_command::dup (symbol_table::scope_id scope,
                               symbol_table::context_id context) const
@@ -39,6 +39,7 @@ class tree_walker;
 #include "symtab.h"
 
 class jit_info;
+class tree_parfor_plan;
 
 // While.
 
@@ -87,6 +88,10 @@ public:
 
   octave_comment_list *trailing_comment (void) { return trail_comm; }
 
+  // The plan for running a parfor loop in worker processes, or 0 if
+  // it must be run serially.
+  tree_parfor_plan *parallel_plan (void);
+
   tree_command *dup (symbol_table::scope_id scope,
                      symbol_table::context_id context) const;
 
@@ -180,7 +185,8 @@ public:
 
   tree_simple_for_command (int l = -1, int c = -1)
     : tree_command (l, c), parallel (false), lhs (0), expr (0),
-      maxproc (0), list (0), lead_comm (0), trail_comm (0)
+      maxproc (0), list (0), lead_comm (0), trail_comm (0),
+      parfor_plan (0), parfor_plan_checked (false)
 #if defined (HAVE_LLVM)
       , compiled (0)
 #endif
@@ -195,7 +201,8 @@ public:
                            int l = -1, int c = -1)
     : tree_command (l, c), parallel (parallel_arg), lhs (le),
       expr (re), maxproc (maxproc_arg), list (lst),
-      lead_comm (lc), trail_comm (tc)
+      lead_comm (lc), trail_comm (tc), parfor_plan (0),
+      parfor_plan_checked (false)
 #if defined (HAVE_LLVM)
       , compiled (0)
 #endif
@@ -217,6 +224,10 @@ public:
 
   octave_comment_list *trailing_comment (void) { return trail_comm; }
 
+  // The plan for running a parfor loop in worker processes, or 0 if
+  // it must be run serially.
+  tree_parfor_plan *parallel_plan (void);
+
   tree_command *dup (symbol_table::scope_id scope,
                      symbol_table::context_id context) const;
 
@@ -259,6 +270,12 @@ private:
   // Comment preceding ENDFOR token.
   octave_comment_list *trail_comm;
 
+  // The plan for running the loop in worker processes.
+  tree_parfor_plan *parfor_plan;
+
+  // TRUE if we have already looked for such a plan.
+  bool parfor_plan_checked;
+
   // compiled version of the loop
   jit_info *compiled;
 
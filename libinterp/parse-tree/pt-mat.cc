@@ -24,6 +24,7 @@ along with Octave; see the file COPYING.  If not, see
 #  include "config.h"
 #endif
 
+#include <algorithm>
 #include <iostream>
 
 #include "oct-locbuf.h"
@@ -73,7 +74,8 @@ private:
         some_str (false), all_real (false), all_cmplx (false),
         all_mt (true), any_cell (false), any_sparse (false),
         any_class (false), all_1x1 (false),
-        first_elem_is_struct (false), class_nm (), ok (false)
+        first_elem_is_struct (false), class_nm (), ok (false),
+        last_type_id (-1), dims_ok (true)
     { }
 
     tm_row_const_rep (const tree_argument_list& row)
@@ -81,7 +83,8 @@ private:
         some_str (false), all_real (false), all_cmplx (false),
         all_mt (true), any_cell (false), any_sparse (false),
         any_class (false), all_1x1 (! row.empty ()),
-        first_elem_is_struct (false), class_nm (), ok (false)
+        first_elem_is_struct (false), class_nm (), ok (false),
+        last_type_id (-1), dims_ok (true)
     { init (row); }
 
     ~tm_row_const_rep (void) { }
@@ -107,6 +110,16 @@ private:
 
     bool ok;
 
+    // The type of the previous element.  The class of the result and
+    // the flags above that depend only on the type of the elements
+    // need not be updated for elements of the same type, as in
+    // [c{:}] or [s.field].
+    int last_type_id;
+
+    // False if the dimensions of the elements did not agree when they
+    // were added.
+    bool dims_ok;
+
     void do_init_element (const octave_value&, bool&);
 
     void init (const tree_argument_list&);
@@ -284,15 +297,15 @@ void
 tm_row_const::tm_row_const_rep::do_init_element (const octave_value& val,
                                                  bool& first_elem)
 {
-  std::string this_elt_class_nm
-    = val.is_object () ? std::string ("class") : val.class_name ();
-
-  class_nm = get_concat_class (class_nm, this_elt_class_nm);
-
   dim_vector this_elt_dv = val.dims ();
 
   if (! this_elt_dv.zero_by_zero ())
     {
+      if (all_mt)
+        dv = this_elt_dv;
+      else if (dims_ok && ! dv.hvcat (this_elt_dv, 1))
+        dims_ok = false;
+
       all_mt = false;
 
       if (first_elem)
@@ -306,6 +319,24 @@ tm_row_const::tm_row_const_rep::do_init_element (const octave_value& val,
 
   append (val);
 
+  // Special treatment of sparse matrices to avoid out-of-memory error
+  all_1x1 = all_1x1 && ! val.is_sparse_type () && val.numel () == 1;
+
+  int this_elt_type_id = val.type_id ();
+
+  if (this_elt_type_id == last_type_id)
+    return;
+
+  // The class name of objects may differ for the same type.
+
+  last_type_id = ((val.is_object () || val.is_java ())
+                  ? -1 : this_elt_type_id);
+
+  std::string this_elt_class_nm
+    = val.is_object () ? std::string ("class") : val.class_name ();
+
+  class_nm = get_concat_class (class_nm, this_elt_class_nm);
+
   if (all_str && ! val.is_string ())
     all_str = false;
 
@@ -332,9 +363,6 @@ tm_row_const::tm_row_const_rep::do_init_element (const octave_value& val,
 
   if (! any_class && val.is_object ())
     any_class = true;
-
-  // Special treatment of sparse matrices to avoid out-of-memory error
-  all_1x1 = all_1x1 && ! val.is_sparse_type () && val.numel () == 1;
 }
 
 void
@@ -384,8 +412,23 @@ tm_row_const::tm_row_const_rep::init (const tree_argument_list& row)
         }
     }
 
+  bool cellified = false;
+
   if (any_cell && ! any_class && ! first_elem_is_struct)
-    cellify ();
+    {
+      cellify ();
+
+      cellified = true;
+    }
+
+  // The dimensions were already found while adding the elements unless
+  // they must be checked again.
+
+  if (dims_ok && ! cellified && ! any_class)
+    {
+      ok = true;
+      return;
+    }
 
   first_elem = true;
 
@@ -672,6 +715,18 @@ static void
 single_type_concat (Array<T>& result,
                     tm_const& tmp)
 {
+  // Copy the elements one column at a time.  The elements of a row
+  // have the same number of rows and the same higher dimensions as the
+  // result, so each column of each page of an element is a contiguous
+  // block of the result.
+
+  octave_idx_type nr = result.rows ();
+  octave_idx_type nc = result.columns ();
+  octave_idx_type npages = (nr > 0 && nc > 0 ? result.numel () / (nr * nc)
+                            : 0);
+
+  T *dest = result.fortran_vec ();
+
   octave_idx_type r = 0;
   octave_idx_type c = 0;
 
@@ -694,9 +749,30 @@ single_type_concat (Array<T>& result,
 
           if (! ra.is_empty ())
             {
-              result.insert (ra, r, c);
+              octave_idx_type ra_nr = ra.rows ();
+              octave_idx_type ra_nc = ra.columns ();
+
+              if (ra.numel () == ra_nr * ra_nc * npages
+                  && r + ra_nr <= nr && c + ra_nc <= nc)
+                {
+                  const T *src = ra.data ();
+
+                  for (octave_idx_type k = 0; k < npages; k++)
+                    for (octave_idx_type j = 0; j < ra_nc; j++)
+                      {
+                        std::copy (src, src + ra_nr,
+                                   dest + (k * nc + c + j) * nr + r);
+                        src += ra_nr;
+                      }
+                }
+              else
+                {
+                  result.insert (ra, r, c);
 
-              c += ra.columns ();
+                  dest = result.fortran_vec ();
+                }
+
+              c += ra_nc;
             }
         }
 
@@ -719,7 +795,6 @@ single_type_concat (Array<T>& result,
 
   if (tmp.length () == 1)
     {
-      // If possible, forward the operation to liboctave.
       // Single row.
       tm_row_const& row = tmp.front ();
       if (! (equal_types<T, char>::value || equal_types<T, octave_value>::value)
@@ -734,26 +809,10 @@ single_type_concat (Array<T>& result,
 
           return;
         }
-
-      octave_idx_type ncols = row.length ();
-      octave_idx_type i = 0;
-      OCTAVE_LOCAL_BUFFER (Array<T>, array_list, ncols);
-
-      for (tm_row_const::iterator q = row.begin (); q != row.end (); q++)
-        {
-          octave_quit ();
-
-          array_list[i] = octave_value_extract<TYPE> (*q);
-          i++;
-        }
-
-      result = Array<T>::cat (-2, ncols, array_list);
-    }
-  else
-    {
-      result = Array<T> (dv);
-      single_type_concat<TYPE> (result, tmp);
     }
+
+  result = Array<T> (dv);
+  single_type_concat<TYPE> (result, tmp);
 }
 
 template <typename TYPE, typename T>
@@ -1342,6 +1401,34 @@ tree_matrix::accept (tree_walker& tw)
 %!assert (isnull ([;;]))
 %!assert (isnull ([;,;]))
 %!assert (isnull ([,;,;,]))
+
+%!test
+%! a = reshape (1:12, [2, 3, 2]);
+%! b = reshape (13:20, [2, 2, 2]);
+%! c = [a, b];
+%! assert (c(:,:,1), [1, 3, 5, 13, 15; 2, 4, 6, 14, 16]);
+%! assert (c(:,:,2), [7, 9, 11, 17, 19; 8, 10, 12, 18, 20]);
+%! d = [a; a];
+%! assert (size (d), [4, 3, 2]);
+%! assert (d(3:4,:,2), a(:,:,2));
+
+%!test
+%! x = [1, 2; 3, 4];
+%! assert ([x, [5; 6]; 7, 8, 9], [1, 2, 5; 3, 4, 6; 7, 8, 9]);
+%! assert ([x, zeros(2, 0), x; [], 1:4], [1, 2, 1, 2; 3, 4, 3, 4; 1:4]);
+%! assert ([int8(x), int8([5; 6])], int8 ([1, 2, 5; 3, 4, 6]));
+%! assert ([x, {1}; "a", {2}], {x, 1; "a", 2});
+
+%!test
+%! s(1:100) = struct ("f", 1:2);
+%! assert ([s.f], repmat (1:2, 1, 100));
+%! c = num2cell (1:100);
+%! c{50} = single (50);
+%! assert (class ([c{:}]), "single");
+%! assert (class (vertcat (c{:})), "single");
+%! assert (vertcat (c{:}), single ((1:100)'));
+
+%!error <horizontal dimensions mismatch \(2x2 vs 1x3\)> [[1, 2; 3, 4], [1, 2, 3]]
 */
 
 DEFUN (string_fill_char, args, nargout,
@@ -0,0 +1,1474 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "lo-mappers.h"
+#include "mach-info.h"
+#include "nproc-wrapper.h"
+#include "oct-rand.h"
+#include "oct-syscalls.h"
+#include "quit.h"
+#include "tmpfile-wrapper.h"
+#include "unwind-prot.h"
+
+#include "Cell.h"
+#include "defun.h"
+#include "error.h"
+#include "ls-oct-binary.h"
+#include "oct-map.h"
+#include "octave-link.h"
+#include "ov-bool.h"
+#include "ov-java.h"
+#include "ov-scalar.h"
+#include "ovl.h"
+#include "pager.h"
+#include "parse.h"
+#include "profiler.h"
+#include "pt-arg-list.h"
+#include "pt-array-list.h"
+#include "pt-assign.h"
+#include "pt-binop.h"
+#include "pt-cbinop.h"
+#include "pt-colon.h"
+#include "pt-const.h"
+#include "pt-eval.h"
+#include "pt-fcn-handle.h"
+#include "pt-id.h"
+#include "pt-idx.h"
+#include "pt-jump.h"
+#include "pt-loop.h"
+#include "pt-parfor.h"
+#include "pt-select.h"
+#include "pt-stmt.h"
+#include "pt-unop.h"
+#include "symtab.h"
+#include "toplev.h"
+
+// TRUE in worker processes.  Nested parfor loops are run serially.
+static bool in_parfor_worker = false;
+
+// Functions that use or change the variables of their caller or the
+// state of the interpreter, which the workers don't share.
+
+static const char *serial_only_fcns[] =
+{
+  "__printf_assert__",
+  "__prog_output_assert__",
+  "assignin",
+  "clear",
+  "dbstop",
+  "eval",
+  "evalc",
+  "evalin",
+  "exist",
+  "input",
+  "inputname",
+  "keyboard",
+  "load",
+  "who",
+  "whos",
+  0
+};
+
+static bool
+is_serial_only_name (const std::string& name)
+{
+  if (name == "ans")
+    return true;
+
+  for (const char **p = serial_only_fcns; *p; p++)
+    {
+      if (name == *p)
+        return true;
+    }
+
+  return false;
+}
+
+static bool
+is_named_identifier (tree_expression *expr, const std::string& name)
+{
+  if (! expr || ! expr->is_identifier ())
+    return false;
+
+  tree_identifier *id = dynamic_cast<tree_identifier *> (expr);
+
+  return ! id->is_black_hole () && id->name () == name;
+}
+
+// The value of the loop variable in iteration I, as computed by
+// tree_evaluator::visit_simple_for_command.
+
+static octave_value
+loop_value (const octave_value& rhs, octave_idx_type i)
+{
+  if (rhs.is_range ())
+    return octave_value (rhs.range_value ().elem (i));
+
+  dim_vector dv = rhs.dims ().redim (2);
+
+  octave_value arg = rhs;
+  if (rhs.ndims () > 2)
+    arg = arg.reshape (dv);
+
+  octave_value_list idx;
+
+  if (dv(0) == 1)
+    idx = ovl (i + 1);
+  else
+    idx = ovl (octave_value (octave_value::magic_colon_t), i + 1);
+
+  return arg.do_index_op (idx);
+}
+
+// A new value that X OP VAL leaves unchanged.  A new representation
+// is allocated so that the value is not shared with any other
+// variable.
+
+static octave_value
+reduction_identity (octave_value::binary_op op)
+{
+  switch (op)
+    {
+    case octave_value::op_mul:
+    case octave_value::op_el_mul:
+      return octave_value (new octave_scalar (1.0));
+
+    case octave_value::op_el_and:
+      return octave_value (new octave_bool (true));
+
+    case octave_value::op_el_or:
+      return octave_value (new octave_bool (false));
+
+    default:
+      return octave_value (new octave_scalar (0.0));
+    }
+}
+
+static void
+close_files (std::vector<FILE *> *files)
+{
+  for (size_t i = 0; i < files->size (); i++)
+    {
+      if ((*files)[i])
+        std::fclose ((*files)[i]);
+    }
+}
+
+static void
+wait_for_worker (pid_t pid)
+{
+  int status = 0;
+  std::string msg;
+
+  while (octave::sys::waitpid (pid, &status, 0, msg) < 0 && errno == EINTR)
+    ;
+}
+
+static octave_scalar_map
+read_worker_result (FILE *fid)
+{
+  std::string buf;
+
+  std::rewind (fid);
+
+  char tmp[8192];
+  size_t n;
+
+  while ((n = std::fread (tmp, 1, sizeof (tmp), fid)) > 0)
+    buf.append (tmp, n);
+
+  std::istringstream is (buf);
+
+  bool global = false;
+  octave_value tc;
+  std::string doc;
+
+  std::string name
+    = read_binary_data (is, false,
+                        octave::mach_info::native_float_format (),
+                        "parfor", global, tc, doc);
+
+  if (name.empty () || ! tc.is_map ())
+    error ("parfor: worker process terminated unexpectedly");
+
+  return tc.scalar_map_value ();
+}
+
+bool
+tree_parfor_plan::subscript::operator == (const subscript& s) const
+{
+  if (type != s.type)
+    return false;
+
+  switch (type)
+    {
+    case variable_sub:
+      return name == s.name;
+
+    case constant_sub:
+      if (value.is_magic_colon () || s.value.is_magic_colon ())
+        return value.is_magic_colon () && s.value.is_magic_colon ();
+      else
+        return value.double_value () == s.value.double_value ();
+
+    default:
+      return true;
+    }
+}
+
+tree_parfor_plan *
+tree_parfor_plan::create (tree_simple_for_command& cmd)
+{
+  tree_expression *lhs = cmd.left_hand_side ();
+  tree_statement_list *lst = cmd.body ();
+
+  if (! lhs || ! lhs->is_identifier () || ! lst || lst->empty ())
+    return 0;
+
+  tree_identifier *id = dynamic_cast<tree_identifier *> (lhs);
+
+  if (id->is_black_hole ())
+    return 0;
+
+  tree_parfor_plan *plan
+    = new tree_parfor_plan (id->name (), cmd.maxproc_expr (), lst);
+
+  if (plan->analyze_statements (lst, true, 0) && plan->classify ())
+    return plan;
+
+  delete plan;
+
+  return 0;
+}
+
+bool
+tree_parfor_plan::analyze_statements (tree_statement_list *lst,
+                                      bool top_level, int loop_depth)
+{
+  if (! lst)
+    return true;
+
+  for (tree_statement_list::iterator p = lst->begin (); p != lst->end (); p++)
+    {
+      tree_statement *stmt = *p;
+
+      if (stmt->is_command ())
+        {
+          if (! analyze_command (stmt->command (), top_level, loop_depth))
+            return false;
+        }
+      else if (stmt->is_expression ())
+        {
+          tree_expression *expr = stmt->expression ();
+
+          bool ok = true;
+
+          if (analyze_reduction (expr, ok))
+            {
+              if (! ok)
+                return false;
+            }
+          else if (expr->is_assignment_expression ())
+            {
+              if (! analyze_assignment (expr, top_level))
+                return false;
+            }
+          else
+            {
+              if (! analyze_expr (expr))
+                return false;
+
+              uses_ans = true;
+            }
+        }
+    }
+
+  return true;
+}
+
+bool
+tree_parfor_plan::analyze_command (tree_command *cmd, bool top_level,
+                                   int loop_depth)
+{
+  if (dynamic_cast<tree_no_op_command *> (cmd)
+      || dynamic_cast<tree_continue_command *> (cmd))
+    return true;
+
+  // BREAK is only allowed in loops nested in the body.
+
+  if (dynamic_cast<tree_break_command *> (cmd))
+    return loop_depth > 0;
+
+  tree_if_command *if_cmd = dynamic_cast<tree_if_command *> (cmd);
+
+  if (if_cmd)
+    {
+      tree_if_command_list *lst = if_cmd->cmd_list ();
+
+      if (lst)
+        {
+          for (tree_if_command_list::iterator p = lst->begin ();
+               p != lst->end (); p++)
+            {
+              tree_if_clause *clause = *p;
+
+              if (! analyze_expr (clause->condition ())
+                  || ! analyze_statements (clause->commands (), false,
+                                           loop_depth))
+                return false;
+            }
+        }
+
+      return true;
+    }
+
+  tree_switch_command *switch_cmd = dynamic_cast<tree_switch_command *> (cmd);
+
+  if (switch_cmd)
+    {
+      if (! analyze_expr (switch_cmd->switch_value ()))
+        return false;
+
+      tree_switch_case_list *lst = switch_cmd->case_list ();
+
+      if (lst)
+        {
+          for (tree_switch_case_list::iterator p = lst->begin ();
+               p != lst->end (); p++)
+            {
+              tree_switch_case *t = *p;
+
+              if (! analyze_expr (t->case_label ())
+                  || ! analyze_statements (t->commands (), false,
+                                           loop_depth))
+                return false;
+            }
+        }
+
+      return true;
+    }
+
+  tree_simple_for_command *for_cmd
+    = dynamic_cast<tree_simple_for_command *> (cmd);
+
+  if (for_cmd)
+    {
+      if (! analyze_expr (for_cmd->control_expr ())
+          || ! analyze_expr (for_cmd->maxproc_expr ())
+          || ! analyze_lvalue (for_cmd->left_hand_side (), top_level))
+        return false;
+
+      return analyze_statements (for_cmd->body (), false, loop_depth + 1);
+    }
+
+  // Also handles do-until loops.
+
+  tree_while_command *while_cmd = dynamic_cast<tree_while_command *> (cmd);
+
+  if (while_cmd)
+    {
+      if (! analyze_expr (while_cmd->condition ()))
+        return false;
+
+      return analyze_statements (while_cmd->body (), false, loop_depth + 1);
+    }
+
+  // Anything else (RETURN, GLOBAL, PERSISTENT, TRY, UNWIND_PROTECT,
+  // FOR with a structure...) is run serially.
+
+  return false;
+}
+
+bool
+tree_parfor_plan::analyze_expr (tree_expression *expr)
+{
+  if (! expr || expr->is_constant ())
+    return true;
+
+  if (expr->is_identifier ())
+    {
+      tree_identifier *id = dynamic_cast<tree_identifier *> (expr);
+
+      if (id->is_black_hole ())
+        return true;
+
+      std::string nm = id->name ();
+
+      if (is_serial_only_name (nm))
+        return false;
+
+      var_info& info = vars[nm];
+
+      info.read = true;
+      info.seen = true;
+
+      return true;
+    }
+
+  if (expr->is_index_expression ())
+    return analyze_index (dynamic_cast<tree_index_expression *> (expr),
+                          false);
+
+  if (expr->is_assignment_expression ())
+    return analyze_assignment (expr, false);
+
+  if (expr->is_binary_expression ())
+    {
+      tree_binary_expression *binexp
+        = dynamic_cast<tree_binary_expression *> (expr);
+
+      return analyze_expr (binexp->lhs ()) && analyze_expr (binexp->rhs ());
+    }
+
+  if (expr->is_unary_expression ())
+    {
+      tree_unary_expression *unexp
+        = dynamic_cast<tree_unary_expression *> (expr);
+
+      octave_value::unary_op op = unexp->op_type ();
+
+      if (op == octave_value::op_incr || op == octave_value::op_decr)
+        return false;
+
+      return analyze_expr (unexp->operand ());
+    }
+
+  tree_colon_expression *colon = dynamic_cast<tree_colon_expression *> (expr);
+
+  if (colon)
+    return (analyze_expr (colon->base ())
+            && analyze_expr (colon->increment ())
+            && analyze_expr (colon->limit ()));
+
+  tree_array_list *array = dynamic_cast<tree_array_list *> (expr);
+
+  if (array)
+    {
+      for (tree_array_list::iterator p = array->begin ();
+           p != array->end (); p++)
+        {
+          tree_argument_list *row = *p;
+
+          for (tree_argument_list::iterator q = row->begin ();
+               q != row->end (); q++)
+            {
+              if (! analyze_expr (*q))
+                return false;
+            }
+        }
+
+      return true;
+    }
+
+  tree_fcn_handle *fh = dynamic_cast<tree_fcn_handle *> (expr);
+
+  if (fh)
+    return ! is_serial_only_name (fh->name ());
+
+  // Anonymous functions capture variables, which we don't track.
+
+  return false;
+}
+
+bool
+tree_parfor_plan::analyze_assignment (tree_expression *expr, bool top_level)
+{
+  tree_simple_assignment *asn = dynamic_cast<tree_simple_assignment *> (expr);
+
+  if (asn)
+    {
+      tree_expression *lhs = asn->left_hand_side ();
+
+      if (! analyze_expr (asn->right_hand_side ()))
+        return false;
+
+      // OP= assignments also use the current value.
+
+      if (asn->op_type () != octave_value::op_asn_eq && ! analyze_expr (lhs))
+        return false;
+
+      return analyze_lvalue (lhs, top_level);
+    }
+
+  tree_multi_assignment *masn = dynamic_cast<tree_multi_assignment *> (expr);
+
+  if (masn)
+    {
+      if (! analyze_expr (masn->right_hand_side ()))
+        return false;
+
+      tree_argument_list *lhs = masn->left_hand_side ();
+
+      for (tree_argument_list::iterator p = lhs->begin ();
+           p != lhs->end (); p++)
+        {
+          if (! analyze_lvalue (*p, top_level))
+            return false;
+        }
+
+      return true;
+    }
+
+  return false;
+}
+
+bool
+tree_parfor_plan::analyze_lvalue (tree_expression *expr, bool top_level)
+{
+  if (! expr)
+    return false;
+
+  if (expr->is_identifier ())
+    {
+      tree_identifier *id = dynamic_cast<tree_identifier *> (expr);
+
+      if (id->is_black_hole ())
+        return true;
+
+      std::string nm = id->name ();
+
+      if (nm == loop_var || is_serial_only_name (nm))
+        return false;
+
+      var_info& info = vars[nm];
+
+      if (! info.seen && top_level)
+        info.temporary = true;
+
+      info.assigned = true;
+      info.seen = true;
+
+      return true;
+    }
+
+  if (expr->is_index_expression ())
+    return analyze_index (dynamic_cast<tree_index_expression *> (expr),
+                          true);
+
+  return false;
+}
+
+bool
+tree_parfor_plan::analyze_index (tree_index_expression *expr,
+                                 bool is_lvalue)
+{
+  // The subscripts are evaluated before the value is indexed or
+  // assigned.
+
+  std::list<tree_argument_list *> args = expr->arg_lists ();
+
+  for (std::list<tree_argument_list *>::iterator p = args.begin ();
+       p != args.end (); p++)
+    {
+      tree_argument_list *lst = *p;
+
+      if (lst)
+        {
+          for (tree_argument_list::iterator q = lst->begin ();
+               q != lst->end (); q++)
+            {
+              if (! analyze_expr (*q))
+                return false;
+            }
+        }
+    }
+
+  std::list<tree_expression *> dyn_fields = expr->dyn_fields ();
+
+  for (std::list<tree_expression *>::iterator p = dyn_fields.begin ();
+       p != dyn_fields.end (); p++)
+    {
+      if (! analyze_expr (*p))
+        return false;
+    }
+
+  tree_expression *base = expr->expression ();
+
+  if (! base->is_identifier ())
+    return ! is_lvalue && analyze_expr (base);
+
+  tree_identifier *id = dynamic_cast<tree_identifier *> (base);
+
+  std::string nm = id->name ();
+
+  if (id->is_black_hole () || is_serial_only_name (nm)
+      || (is_lvalue && nm == loop_var))
+    return false;
+
+  std::string type = expr->type_tags ();
+
+  std::vector<subscript> subs;
+
+  if ((type == "(" || type == "{") && slice_subscripts (expr, subs))
+    add_slice (nm, subs, is_lvalue);
+  else
+    {
+      var_info& info = vars[nm];
+
+      if (is_lvalue)
+        info.other_assign = true;
+      else
+        info.read = true;
+
+      info.seen = true;
+    }
+
+  return true;
+}
+
+// Return true if EXPR is an expression statement of the form
+//
+//   S = S op EXPR   or   S op= EXPR
+//
+// which can be evaluated as a reduction.  OK is set to false if EXPR
+// can't be run in parallel.
+
+bool
+tree_parfor_plan::analyze_reduction (tree_expression *expr, bool& ok)
+{
+  tree_simple_assignment *asn = dynamic_cast<tree_simple_assignment *> (expr);
+
+  if (! asn)
+    return false;
+
+  tree_expression *lhs = asn->left_hand_side ();
+
+  if (! lhs || ! lhs->is_identifier ())
+    return false;
+
+  tree_identifier *id = dynamic_cast<tree_identifier *> (lhs);
+
+  std::string nm = id->name ();
+
+  if (id->is_black_hole () || nm == loop_var || is_serial_only_name (nm))
+    return false;
+
+  octave_value::binary_op op = octave_value::unknown_binary_op;
+  tree_expression *operand = 0;
+
+  switch (asn->op_type ())
+    {
+    case octave_value::op_add_eq:
+    case octave_value::op_sub_eq:
+      // The partial results of S -= EXPR are added.
+      op = octave_value::op_add;
+      operand = asn->right_hand_side ();
+      break;
+
+    case octave_value::op_mul_eq:
+      op = octave_value::op_mul;
+      operand = asn->right_hand_side ();
+      break;
+
+    case octave_value::op_el_mul_eq:
+      op = octave_value::op_el_mul;
+      operand = asn->right_hand_side ();
+      break;
+
+    case octave_value::op_el_and_eq:
+      op = octave_value::op_el_and;
+      operand = asn->right_hand_side ();
+      break;
+
+    case octave_value::op_el_or_eq:
+      op = octave_value::op_el_or;
+      operand = asn->right_hand_side ();
+      break;
+
+    case octave_value::op_asn_eq:
+      {
+        tree_expression *rhs = asn->right_hand_side ();
+
+        if (! rhs || ! rhs->is_binary_expression ()
+            || rhs->is_boolean_expression ()
+            || dynamic_cast<tree_compound_binary_expression *> (rhs))
+          return false;
+
+        tree_binary_expression *binexp
+          = dynamic_cast<tree_binary_expression *> (rhs);
+
+        bool lhs_is_var = is_named_identifier (binexp->lhs (), nm);
+        bool rhs_is_var = is_named_identifier (binexp->rhs (), nm);
+
+        switch (binexp->op_type ())
+          {
+          case octave_value::op_add:
+          case octave_value::op_el_mul:
+          case octave_value::op_el_and:
+          case octave_value::op_el_or:
+            op = binexp->op_type ();
+            if (lhs_is_var)
+              operand = binexp->rhs ();
+            else if (rhs_is_var)
+              operand = binexp->lhs ();
+            break;
+
+          case octave_value::op_sub:
+            op = octave_value::op_add;
+            if (lhs_is_var)
+              operand = binexp->rhs ();
+            break;
+
+          case octave_value::op_mul:
+            op = octave_value::op_mul;
+            if (lhs_is_var)
+              operand = binexp->rhs ();
+            break;
+
+          default:
+            break;
+          }
+      }
+      break;
+
+    default:
+      break;
+    }
+
+  if (! operand)
+    return false;
+
+  ok = analyze_expr (operand);
+
+  if (ok)
+    {
+      var_info& info = vars[nm];
+
+      if (info.reduction_op == octave_value::unknown_binary_op)
+        info.reduction_op = op;
+      else if (info.reduction_op != op)
+        info.bad_reduction = true;
+
+      info.seen = true;
+    }
+
+  return true;
+}
+
+bool
+tree_parfor_plan::classify (void)
+{
+  for (std::map<std::string, var_info>::const_iterator p = vars.begin ();
+       p != vars.end (); p++)
+    {
+      const std::string& nm = p->first;
+      const var_info& info = p->second;
+
+      bool is_assigned = (info.assigned || info.other_assign
+                          || info.sliced_assign
+                          || (info.reduction_op
+                              != octave_value::unknown_binary_op));
+
+      if (nm == loop_var)
+        {
+          if (is_assigned)
+            return false;
+        }
+      else if (info.temporary)
+        last_value_vars.push_back (nm);
+      else if (info.reduction_op != octave_value::unknown_binary_op)
+        {
+          if (info.bad_reduction || info.read || info.assigned
+              || info.other_assign || info.sliced_ref || info.sliced_assign)
+            return false;
+
+          reductions.push_back (reduction_var (nm, info.reduction_op));
+        }
+      else if (info.sliced_assign)
+        {
+          if (info.bad_slice || info.read || info.assigned
+              || info.other_assign)
+            return false;
+
+          sliced.push_back (sliced_var (nm, info.subs));
+        }
+      else if (is_assigned)
+        return false;
+    }
+
+  // Variables used as subscripts of sliced variables must not change.
+
+  for (size_t i = 0; i < sliced.size (); i++)
+    {
+      const std::vector<subscript>& subs = sliced[i].subs;
+
+      for (size_t j = 0; j < subs.size (); j++)
+        {
+          if (subs[j].type != subscript::variable_sub)
+            continue;
+
+          std::map<std::string, var_info>::const_iterator p
+            = vars.find (subs[j].name);
+
+          if (p == vars.end ())
+            return false;
+
+          const var_info& info = p->second;
+
+          if (info.temporary || info.assigned || info.other_assign
+              || info.sliced_assign
+              || info.reduction_op != octave_value::unknown_binary_op)
+            return false;
+        }
+    }
+
+  if (uses_ans)
+    last_value_vars.push_back ("ans");
+
+  return true;
+}
+
+bool
+tree_parfor_plan::slice_subscripts (tree_index_expression *expr,
+                                    std::vector<subscript>& subs) const
+{
+  std::list<tree_argument_list *> args = expr->arg_lists ();
+
+  if (args.size () != 1 || ! args.front ())
+    return false;
+
+  tree_argument_list *lst = args.front ();
+
+  int num_loop_subs = 0;
+
+  for (tree_argument_list::iterator p = lst->begin (); p != lst->end (); p++)
+    {
+      tree_expression *elt = *p;
+
+      if (elt->is_identifier ())
+        {
+          tree_identifier *id = dynamic_cast<tree_identifier *> (elt);
+
+          if (id->is_black_hole ())
+            return false;
+
+          std::string nm = id->name ();
+
+          if (nm == loop_var)
+            {
+              subs.push_back (subscript (subscript::loop_var_sub));
+              num_loop_subs++;
+            }
+          else
+            subs.push_back (subscript (subscript::variable_sub,
+                                       octave_value (), nm));
+        }
+      else if (elt->is_constant ())
+        {
+          octave_value val = elt->rvalue1 ();
+
+          if (! (val.is_magic_colon ()
+                 || (val.is_real_scalar () && val.is_double_type ())))
+            return false;
+
+          subs.push_back (subscript (subscript::constant_sub, val));
+        }
+      else
+        return false;
+    }
+
+  return num_loop_subs == 1;
+}
+
+void
+tree_parfor_plan::add_slice (const std::string& nm,
+                             const std::vector<subscript>& subs,
+                             bool is_lvalue)
+{
+  var_info& info = vars[nm];
+
+  if (! (info.sliced_ref || info.sliced_assign))
+    info.subs = subs;
+  else if (! (info.subs.size () == subs.size ()
+              && std::equal (subs.begin (), subs.end (),
+                             info.subs.begin ())))
+    info.bad_slice = true;
+
+  if (is_lvalue)
+    info.sliced_assign = true;
+  else
+    info.sliced_ref = true;
+
+  info.seen = true;
+}
+
+octave_value_list
+tree_parfor_plan::slice_index (const std::vector<subscript>& subs,
+                               const octave_value_list& sub_vals,
+                               const octave_value& loop_val) const
+{
+  octave_value_list idx = sub_vals;
+
+  for (size_t i = 0; i < subs.size (); i++)
+    {
+      if (subs[i].type == subscript::loop_var_sub)
+        idx(i) = loop_val;
+    }
+
+  return idx;
+}
+
+// Sliced variables are only combined correctly if each iteration
+// assigns a different slice.
+
+bool
+tree_parfor_plan::distinct_loop_values (const octave_value& rhs) const
+{
+  if (rhs.is_range ())
+    {
+      Range r = rhs.range_value ();
+
+      return r.numel () < 2 || r.inc () != 0;
+    }
+
+  if (! rhs.is_real_type () || rhs.is_sparse_type () || rhs.rows () != 1)
+    return false;
+
+  NDArray vals = rhs.array_value ();
+
+  std::vector<double> v (vals.data (), vals.data () + vals.numel ());
+
+  for (size_t i = 0; i < v.size (); i++)
+    {
+      if (octave::math::isnan (v[i]))
+        return false;
+    }
+
+  std::sort (v.begin (), v.end ());
+
+  return std::adjacent_find (v.begin (), v.end ()) == v.end ();
+}
+
+bool
+tree_parfor_plan::execute (tree_evaluator& tw, const octave_value& rhs)
+{
+  // Workers don't share the state of the interpreter, so loops are
+  // only run in parallel if the number of workers was requested with
+  // parfor (VAR = EXPR, MAXPROC).
+
+  if (! maxproc || in_parfor_worker || tree_evaluator::debug_mode
+      || profiler.is_active ())
+    return false;
+
+  // Only the forking thread survives in the workers.  The threads of
+  // the GUI and of a Java VM hold locks and state that the workers
+  // would inherit in an inconsistent state.
+
+  if (octave_link::enabled () || octave_java::is_vm_running ())
+    return false;
+
+  // Scalars are a single iteration.  Other types are an error, which
+  // is reported by the serial loop.
+
+  if (! (rhs.is_range () || rhs.is_matrix_type () || rhs.is_cell ()
+         || rhs.is_string () || rhs.is_map ()))
+    return false;
+
+  dim_vector dv = rhs.dims ().redim (2);
+
+  octave_idx_type steps = dv(1);
+
+  octave_idx_type num_workers
+    = octave_num_processors_wrapper (OCTAVE_NPROC_CURRENT);
+
+  if (num_workers > steps)
+    num_workers = steps;
+
+  double max_workers = maxproc->rvalue1 ().xdouble_value
+    ("parfor: maximum number of workers must be a numeric value");
+
+  if (max_workers < num_workers)
+    num_workers = (max_workers < 0
+                   ? 0 : static_cast<octave_idx_type> (max_workers));
+
+  if (num_workers < 2)
+    return false;
+
+  for (size_t i = 0; i < reductions.size (); i++)
+    {
+      // Let the serial loop report the undefined value.
+
+      if (! symbol_table::is_variable (reductions[i].name))
+        return false;
+    }
+
+  std::vector<octave_value_list> sub_vals (sliced.size ());
+
+  for (size_t i = 0; i < sliced.size (); i++)
+    {
+      const std::vector<subscript>& subs = sliced[i].subs;
+
+      octave_value_list vals (subs.size (), octave_value ());
+
+      for (size_t j = 0; j < subs.size (); j++)
+        {
+          if (subs[j].type == subscript::constant_sub)
+            vals(j) = subs[j].value;
+          else if (subs[j].type == subscript::variable_sub)
+            {
+              vals(j) = symbol_table::varval (subs[j].name);
+
+              if (vals(j).is_undefined ())
+                return false;
+            }
+        }
+
+      sub_vals[i] = vals;
+    }
+
+  if (! sliced.empty () && ! distinct_loop_values (rhs))
+    return false;
+
+  // Scripts would change the variables of the workers.
+
+  for (std::map<std::string, var_info>::const_iterator p = vars.begin ();
+       p != vars.end (); p++)
+    {
+      const std::string& nm = p->first;
+
+      if (! symbol_table::is_variable (nm))
+        {
+          octave_value fcn = symbol_table::find_function (nm);
+
+          if (fcn.is_defined () && fcn.is_user_script ())
+            return false;
+        }
+    }
+
+  std::vector<FILE *> files (num_workers, static_cast<FILE *> (0));
+  std::vector<pid_t> pids;
+
+  octave::unwind_protect frame;
+
+  frame.add_fcn (close_files, &files);
+
+  for (octave_idx_type w = 0; w < num_workers; w++)
+    {
+      files[w] = octave_tmpfile_wrapper ();
+
+      if (! files[w])
+        return false;
+    }
+
+  // Output that is still buffered would be written by every worker.
+
+  flush_octave_stdout ();
+  std::cout.flush ();
+  std::cerr.flush ();
+
+  std::string fork_msg;
+
+  for (octave_idx_type w = 0; w < num_workers; w++)
+    {
+      octave_idx_type first = (steps * w) / num_workers;
+      octave_idx_type last = (steps * (w + 1)) / num_workers;
+
+      pid_t pid = octave::sys::fork (fork_msg);
+
+      if (pid == 0)
+        run_worker (tw, rhs, first, last, sub_vals, files[w]);
+
+      if (pid < 0)
+        {
+          if (w == 0)
+            return false;
+
+          break;
+        }
+
+      pids.push_back (pid);
+    }
+
+  for (size_t w = 0; w < pids.size (); w++)
+    wait_for_worker (pids[w]);
+
+  octave_quit ();
+
+  if (pids.size () < static_cast<size_t> (num_workers))
+    error ("parfor: unable to start worker process: %s", fork_msg.c_str ());
+
+  std::vector<octave_scalar_map> results (num_workers);
+
+  for (octave_idx_type w = 0; w < num_workers; w++)
+    {
+      results[w] = read_worker_result (files[w]);
+
+      if (results[w].getfield ("interrupted").bool_value ())
+        octave_throw_interrupt_exception ();
+    }
+
+  // Combine the results in the order of the iterations.
+
+  for (octave_idx_type w = 0; w < num_workers; w++)
+    {
+      const octave_scalar_map& result = results[w];
+
+      octave_idx_type first = (steps * w) / num_workers;
+      octave_idx_type completed
+        = result.getfield ("completed").idx_type_value ();
+
+      Cell slices = result.getfield ("slices").cell_value ();
+      boolNDArray slices_set
+        = result.getfield ("slices_set").bool_array_value ();
+
+      for (size_t i = 0; i < sliced.size (); i++)
+        {
+          symbol_table::symbol_record sym
+            = symbol_table::find_symbol (sliced[i].name);
+
+          for (octave_idx_type k = 0; k < completed; k++)
+            {
+              if (! slices_set(i,k))
+                continue;
+
+              std::list<octave_value_list> idx
+                (1, slice_index (sliced[i].subs, sub_vals[i],
+                                 loop_value (rhs, first + k)));
+
+              sym.assign (octave_value::op_asn_eq, "(", idx, slices(i,k));
+            }
+        }
+
+      Cell partials = result.getfield ("reductions").cell_value ();
+      boolNDArray partials_set
+        = result.getfield ("reductions_set").bool_array_value ();
+
+      for (size_t i = 0; i < reductions.size (); i++)
+        {
+          if (! partials_set(i))
+            continue;
+
+          const std::string& nm = reductions[i].name;
+
+          symbol_table::assign (nm, do_binary_op (reductions[i].op,
+                                                  symbol_table::varval (nm),
+                                                  partials(i)));
+        }
+
+      Cell last_values = result.getfield ("last_values").cell_value ();
+      boolNDArray last_values_set
+        = result.getfield ("last_values_set").bool_array_value ();
+
+      for (size_t i = 0; i < last_value_vars.size (); i++)
+        {
+          if (last_values_set(i))
+            symbol_table::assign (last_value_vars[i], last_values(i));
+        }
+
+      if (result.getfield ("failed").bool_value ())
+        {
+          symbol_table::assign (loop_var, loop_value (rhs, first + completed));
+
+          std::string id = result.getfield ("identifier").string_value ();
+          std::string msg = result.getfield ("message").string_value ();
+
+          error_with_id (id.c_str (), "%s", msg.c_str ());
+        }
+    }
+
+  symbol_table::assign (loop_var, loop_value (rhs, steps - 1));
+
+  return true;
+}
+
+// Run iterations FIRST to LAST-1 of the loop in a worker process,
+// write the results to FID and exit.  Never returns.
+
+void
+tree_parfor_plan::run_worker (tree_evaluator& tw, const octave_value& rhs,
+                              octave_idx_type first, octave_idx_type last,
+                              const std::vector<octave_value_list>& sub_vals,
+                              FILE *fid) const
+{
+  in_parfor_worker = true;
+
+  // Errors are reported by the parent.
+
+  buffer_error_messages++;
+  Vdebug_on_error = false;
+  Vdebug_on_warning = false;
+
+  size_t num_sliced = sliced.size ();
+  size_t num_reductions = reductions.size ();
+  size_t num_last_values = last_value_vars.size ();
+
+  std::vector<octave_value> identities (num_reductions);
+  std::vector<octave_value> initial_values (num_last_values);
+
+  octave_idx_type completed = 0;
+
+  bool failed = false;
+  bool interrupted = false;
+
+  std::string msg;
+  std::string id;
+
+  try
+    {
+      // Don't start a pager in each worker.
+
+      feval ("more", ovl ("off"));
+
+      // Give each worker its own random number sequences.
+
+      static const char *dists[]
+        = { "uniform", "normal", "exponential", "poisson", "gamma", 0 };
+
+      for (const char **p = dists; *p; p++)
+        octave_rand::reset (*p);
+
+      for (size_t i = 0; i < num_reductions; i++)
+        {
+          identities[i] = reduction_identity (reductions[i].op);
+
+          symbol_table::assign (reductions[i].name, identities[i]);
+        }
+
+      for (size_t i = 0; i < num_last_values; i++)
+        initial_values[i] = symbol_table::varval (last_value_vars[i]);
+
+      for (octave_idx_type k = first; k < last; k++)
+        {
+          symbol_table::assign (loop_var, loop_value (rhs, k));
+
+          body->accept (tw);
+
+          octave_quit ();
+
+          if (tree_continue_command::continuing)
+            tree_continue_command::continuing--;
+
+          completed++;
+        }
+    }
+  catch (const octave_interrupt_exception&)
+    {
+      failed = true;
+      interrupted = true;
+    }
+  catch (const octave_execution_exception&)
+    {
+      failed = true;
+      msg = last_error_message ();
+      id = last_error_id ();
+
+      recover_from_exception ();
+    }
+  catch (const std::bad_alloc&)
+    {
+      failed = true;
+      msg = "out of memory or dimension too large for Octave's index type";
+    }
+
+  // Iterations that did not assign their slice leave nothing to
+  // extract, or a value that is already in the parent.
+
+  Cell slices (num_sliced, completed);
+  boolNDArray slices_set (dim_vector (num_sliced, completed), false);
+
+  for (size_t i = 0; i < num_sliced; i++)
+    {
+      octave_value val = symbol_table::varval (sliced[i].name);
+
+      if (val.is_undefined ())
+        continue;
+
+      for (octave_idx_type k = 0; k < completed; k++)
+        {
+          try
+            {
+              slices(i,k)
+                = val.do_index_op (slice_index (sliced[i].subs, sub_vals[i],
+                                                loop_value (rhs, first + k)));
+
+              slices_set(i,k) = true;
+            }
+          catch (const octave_execution_exception&)
+            {
+              recover_from_exception ();
+            }
+        }
+    }
+
+  Cell partials (num_reductions, 1);
+  boolNDArray partials_set (dim_vector (num_reductions, 1), false);
+
+  for (size_t i = 0; i < num_reductions; i++)
+    {
+      octave_value val = symbol_table::varval (reductions[i].name);
+
+      if (identities[i].is_defined () && val.is_defined ()
+          && ! val.is_copy_of (identities[i]))
+        {
+          partials(i) = val;
+          partials_set(i) = true;
+        }
+    }
+
+  Cell last_values (num_last_values, 1);
+  boolNDArray last_values_set (dim_vector (num_last_values, 1), false);
+
+  for (size_t i = 0; i < num_last_values; i++)
+    {
+      octave_value val = symbol_table::varval (last_value_vars[i]);
+
+      if (val.is_defined () && ! val.is_copy_of (initial_values[i]))
+        {
+          last_values(i) = val;
+          last_values_set(i) = true;
+        }
+    }
+
+  octave_scalar_map result;
+
+  result.assign ("completed", completed);
+  result.assign ("slices", slices);
+  result.assign ("slices_set", slices_set);
+  result.assign ("reductions", partials);
+  result.assign ("reductions_set", partials_set);
+  result.assign ("last_values", last_values);
+  result.assign ("last_values_set", last_values_set);
+  result.assign ("failed", failed);
+  result.assign ("interrupted", interrupted);
+  result.assign ("message", msg);
+  result.assign ("identifier", id);
+
+  std::ostringstream buf;
+
+  bool saved = false;
+
+  try
+    {
+      saved = save_binary_data (buf, result, "result", "", false, false);
+    }
+  catch (const octave_execution_exception&)
+    {
+      recover_from_exception ();
+    }
+
+  if (! saved)
+    {
+      // Report values that can't be saved as an error.
+
+      octave_scalar_map err;
+
+      err.assign ("completed", octave_idx_type (0));
+      err.assign ("slices", Cell (num_sliced, 0));
+      err.assign ("slices_set", boolNDArray (dim_vector (num_sliced, 0)));
+      err.assign ("reductions", Cell (num_reductions, 1));
+      err.assign ("reductions_set",
+                  boolNDArray (dim_vector (num_reductions, 1), false));
+      err.assign ("last_values", Cell (num_last_values, 1));
+      err.assign ("last_values_set",
+                  boolNDArray (dim_vector (num_last_values, 1), false));
+      err.assign ("failed", true);
+      err.assign ("interrupted", interrupted);
+      err.assign ("message",
+                  "parfor: unable to return the results of a worker process");
+      err.assign ("identifier", "Octave:parfor-worker-results");
+
+      buf.str ("");
+
+      save_binary_data (buf, err, "result", "", false, false);
+    }
+
+  std::string data = buf.str ();
+
+  std::fwrite (data.data (), 1, data.size (), fid);
+  std::fflush (fid);
+
+  flush_octave_stdout ();
+  std::cout.flush ();
+  std::cerr.flush ();
+
+  std::_Exit (0);
+}
+
+/*
+%!function [x, s, t] = __parfor_sweep__ (n, m)
+%!  x = zeros (1, n);
+%!  s = 0;
+%!  parfor (i = 1:n, m)
+%!    t = i^2;
+%!    x(i) = t + 1;
+%!    s += t;
+%!  endparfor
+%!endfunction
+
+%!function [x, c, p] = __parfor_mixed__ (a, n, m)
+%!  c = {};
+%!  p = 1;
+%!  x = [];
+%!  parfor (i = 1:n, m)
+%!    if (mod (i, 2))
+%!      x(2,i) = a(i);
+%!      continue;
+%!    endif
+%!    c{i} = sprintf ("%d", i);
+%!    p = p .* a(i);
+%!  endparfor
+%!endfunction
+
+## MAXPROC = 0 runs the loop serially
+%!test
+%! [x, s, t] = __parfor_sweep__ (100, 4);
+%! assert (x, (1:100).^2 + 1);
+%! assert (s, sum ((1:100).^2));
+%! assert (t, 10000);
+%! [x2, s2, t2] = __parfor_sweep__ (100, 0);
+%! assert ({x, s, t}, {x2, s2, t2});
+
+%!test
+%! a = 1:10;
+%! [x, c, p] = __parfor_mixed__ (a, 10, 3);
+%! [x2, c2, p2] = __parfor_mixed__ (a, 10, 0);
+%! assert (x, x2);
+%! assert (c, c2);
+%! assert (p, p2);
+
+## Errors in the workers are reported by the parent
+%!function __parfor_error__ ()
+%!  x = zeros (1, 8);
+%!  parfor (i = 1:8, 2)
+%!    x(i) = i;
+%!    if (i == 6)
+%!      error ("Octave:some-id", "parfor error %d", i);
+%!    endif
+%!  endparfor
+%!endfunction
+%!error <parfor error 6> __parfor_error__ ()
+*/
@@ -0,0 +1,253 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if ! defined (octave_pt_parfor_h)
+#define octave_pt_parfor_h 1
+
+#include "octave-config.h"
+
+#include <cstdio>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ov.h"
+
+class tree_command;
+class tree_evaluator;
+class tree_expression;
+class tree_index_expression;
+class tree_simple_for_command;
+class tree_statement_list;
+
+// Execution of parfor loops in worker processes.
+//
+// Each variable used in the body of the loop must fall in one of the
+// following classes:
+//
+//   loop       the loop variable, which must not be assigned.
+//
+//   broadcast  variables that are never assigned.
+//
+//   sliced     variables that are only indexed as X(..., I, ...) or
+//              X{..., I, ...}, with I the loop variable and the other
+//              subscripts constants, colons or broadcast variables.
+//
+//   reduction  variables that are only used in statements like
+//              S = S + EXPR or S += EXPR, with EXPR not using S.
+//
+//   temporary  variables that are assigned before any other use in
+//              each iteration.
+//
+// The iterations are divided in contiguous blocks, one for each
+// worker.  The workers are forked from the interpreter, so they start
+// with a copy of all variables.  When a worker is done, it writes the
+// slices it assigned, its partial reductions and the last values of
+// its temporaries to a temporary file in Octave's binary format.  The
+// parent combines the results in the order of the iterations, so the
+// final values are the same as those of the serial loop (up to the
+// order of floating point operations in reductions).
+
+class
+tree_parfor_plan
+{
+public:
+
+  // Return a plan for running the body of CMD in worker processes, or
+  // 0 if the variables of the body can't be classified.
+
+  static tree_parfor_plan *create (tree_simple_for_command& cmd);
+
+  ~tree_parfor_plan (void) { }
+
+  // Run the loop over the values of RHS.  If the loop must be run
+  // serially instead, return false without evaluating any part of it.
+
+  bool execute (tree_evaluator& tw, const octave_value& rhs);
+
+private:
+
+  // One subscript of a sliced variable.
+
+  class subscript
+  {
+  public:
+
+    enum subscript_type
+    {
+      loop_var_sub,
+      constant_sub,
+      variable_sub
+    };
+
+    subscript (subscript_type t = loop_var_sub,
+               const octave_value& v = octave_value (),
+               const std::string& nm = "")
+      : type (t), value (v), name (nm) { }
+
+    bool operator == (const subscript& s) const;
+
+    subscript_type type;
+
+    // The value of constant subscripts.
+    octave_value value;
+
+    // The name of broadcast variables used as subscripts.
+    std::string name;
+  };
+
+  class var_info
+  {
+  public:
+
+    var_info (void)
+      : seen (false), read (false), assigned (false), temporary (false),
+        sliced_ref (false), sliced_assign (false), other_assign (false),
+        bad_slice (false), reduction_op (octave_value::unknown_binary_op),
+        bad_reduction (false), subs () { }
+
+    // TRUE if the variable has been used before the current point of
+    // the analysis.
+    bool seen;
+
+    // Used other than as a sliced variable or in a reduction.
+    bool read;
+    bool assigned;
+
+    // TRUE if the first use of the variable is an assignment that is
+    // evaluated in every iteration.
+    bool temporary;
+
+    bool sliced_ref;
+    bool sliced_assign;
+
+    // Indexed assignment that doesn't match the sliced form.
+    bool other_assign;
+
+    // Sliced uses with different subscripts.
+    bool bad_slice;
+
+    octave_value::binary_op reduction_op;
+
+    // Reductions with different operators.
+    bool bad_reduction;
+
+    std::vector<subscript> subs;
+  };
+
+  class sliced_var
+  {
+  public:
+
+    sliced_var (const std::string& nm = "",
+                const std::vector<subscript>& s = std::vector<subscript> ())
+      : name (nm), subs (s) { }
+
+    std::string name;
+
+    std::vector<subscript> subs;
+  };
+
+  class reduction_var
+  {
+  public:
+
+    reduction_var (const std::string& nm = "",
+                   octave_value::binary_op o = octave_value::op_add)
+      : name (nm), op (o) { }
+
+    std::string name;
+
+    octave_value::binary_op op;
+  };
+
+  tree_parfor_plan (const std::string& nm, tree_expression *mp,
+                    tree_statement_list *lst)
+    : loop_var (nm), maxproc (mp), body (lst), vars (), sliced (),
+      reductions (), last_value_vars (), uses_ans (false) { }
+
+  bool analyze_statements (tree_statement_list *lst, bool top_level,
+                           int loop_depth);
+
+  bool analyze_command (tree_command *cmd, bool top_level, int loop_depth);
+
+  bool analyze_expr (tree_expression *expr);
+
+  bool analyze_assignment (tree_expression *expr, bool top_level);
+
+  bool analyze_lvalue (tree_expression *expr, bool top_level);
+
+  bool analyze_index (tree_index_expression *expr, bool is_lvalue);
+
+  bool analyze_reduction (tree_expression *expr, bool& ok);
+
+  bool classify (void);
+
+  bool slice_subscripts (tree_index_expression *expr,
+                         std::vector<subscript>& subs) const;
+
+  void add_slice (const std::string& nm, const std::vector<subscript>& subs,
+                  bool is_lvalue);
+
+  octave_value_list slice_index (const std::vector<subscript>& subs,
+                                 const octave_value_list& sub_vals,
+                                 const octave_value& loop_val) const;
+
+  bool distinct_loop_values (const octave_value& rhs) const;
+
+  void run_worker (tree_evaluator& tw, const octave_value& rhs,
+                   octave_idx_type first, octave_idx_type last,
+                   const std::vector<octave_value_list>& sub_vals,
+                   FILE *fid) const;
+
+  // Name of the loop variable.
+  std::string loop_var;
+
+  // The maxproc expression and the body of the loop.  Owned by the
+  // loop command.
+  tree_expression *maxproc;
+
+  tree_statement_list *body;
+
+  // Information about each variable, collected by the analysis.
+  std::map<std::string, var_info> vars;
+
+  std::vector<sliced_var> sliced;
+
+  std::vector<reduction_var> reductions;
+
+  // Temporaries and ans.  After the loop, they have the value they
+  // had at the end of the last iteration that assigned them.
+  std::vector<std::string> last_value_vars;
+
+  // TRUE if an expression statement may set ans.
+  bool uses_ans;
+
+  // No copying!
+
+  tree_parfor_plan (const tree_parfor_plan&);
+
+  tree_parfor_plan& operator = (const tree_parfor_plan&);
+};
+
+#endif
@@ -30,6 +30,7 @@ along with Octave; see the file COPYING.  If not, see
 #include <cassert>
 
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <vector>
 #include <algorithm>
@@ -907,6 +908,30 @@ Array<T>::resize_fill_value (void) const
 // Yes, we could do resize using index & assign.  However, that would
 // possibly involve a lot more memory traffic than we actually need.
 
+// Return the number of elements to allocate when an array of NX
+// elements grows to N elements by appending.  The extra space is
+// proportional to the current size so that a sequence of appends takes
+// amortized constant time per element.  Small arrays double in size;
+// larger ones grow by an eighth, so at most about a ninth of the space
+// is unused.  It is released by maybe_economize when the value is copied
+// to another variable, and for all variables by the pack function.
+
+template <typename T>
+octave_idx_type
+Array<T>::grow_capacity (octave_idx_type nx, octave_idx_type n)
+{
+  static const octave_idx_type max_doubling = 1024;
+
+  octave_idx_type extra = std::max (nx / 8, std::min (nx, max_doubling));
+
+  octave_idx_type max_len = std::numeric_limits<octave_idx_type>::max ();
+
+  if (extra > max_len - n)
+    extra = max_len - n;
+
+  return n + extra;
+}
+
 template <typename T>
 void
 Array<T>::resize1 (octave_idx_type n, const T& rfv)
@@ -942,24 +967,25 @@ Array<T>::resize1 (octave_idx_type n, const T& rfv)
       slice_len--;
       dimensions = dv;
     }
-  else if (n == nx + 1 && nx > 0)
+  else if (n > nx && n - nx <= nx)
     {
-      // Stack "push" operation.
+      // Stack "push" operation, also used for appending several
+      // elements as in x(end+1:end+k) = y.
       if (rep->count == 1
-          && slice_data + slice_len < rep->data + rep->len)
+          && slice_data + n <= rep->data + rep->len)
         {
-          slice_data[slice_len++] = rfv;
+          std::fill_n (slice_data + slice_len, n - nx, rfv);
+          slice_len = n;
           dimensions = dv;
         }
       else
         {
-          static const octave_idx_type max_stack_chunk = 1024;
-          octave_idx_type nn = n + std::min (nx, max_stack_chunk);
+          octave_idx_type nn = grow_capacity (nx, n);
           Array<T> tmp (Array<T> (dim_vector (nn, 1)), dv, 0, n);
           T *dest = tmp.fortran_vec ();
 
           std::copy (data (), data () + nx, dest);
-          dest[nx] = rfv;
+          std::fill_n (dest + nx, n - nx, rfv);
 
           *this = tmp;
         }
@@ -987,7 +1013,35 @@ Array<T>::resize2 (octave_idx_type r, octave_idx_type c, const T& rfv)
 
   octave_idx_type rx = rows ();
   octave_idx_type cx = columns ();
-  if (r != rx || c != cx)
+  if (r == rx && c == cx + 1 && rx > 0 && cx > 0)
+    {
+      // Append a column.  Like the stack "push" operation in resize1,
+      // use spare space at the end of the data if there is any and
+      // otherwise allocate extra space for later appends.
+      octave_idx_type nx = rx * cx;
+      octave_idx_type n = nx + rx;
+
+      if (rep->count == 1
+          && slice_data + n <= rep->data + rep->len)
+        {
+          std::fill_n (slice_data + slice_len, rx, rfv);
+          slice_len = n;
+          dimensions = dim_vector (r, c);
+        }
+      else
+        {
+          octave_idx_type nn = grow_capacity (nx, n);
+          Array<T> tmp (Array<T> (dim_vector (nn, 1)), dim_vector (r, c),
+                        0, n);
+          T *dest = tmp.fortran_vec ();
+
+          std::copy (data (), data () + nx, dest);
+          std::fill_n (dest + nx, rx, rfv);
+
+          *this = tmp;
+        }
+    }
+  else if (r != rx || c != cx)
     {
       Array<T> tmp = Array<T> (dim_vector (r, c));
       T *dest = tmp.fortran_vec ();
@@ -38,6 +38,8 @@ along with Octave; see the file COPYING.  If not, see
 #include "idx-vector.h"
 #include "lo-traits.h"
 #include "lo-utils.h"
+#include "oct-mem-stats.h"
+#include "oct-perf-counters.h"
 #include "oct-sort.h"
 #include "quit.h"
 #include "oct-refcount.h"
@@ -59,14 +61,14 @@ protected:
     octave_refcount<int> count;
 
     ArrayRep (T *d, octave_idx_type l)
-      : data (new T [l]), len (l), count (1)
+      : data (allocate (l)), len (l), count (1)
     {
       std::copy (d, d+l, data);
     }
 
     template <typename U>
     ArrayRep (U *d, octave_idx_type l)
-      : data (new T [l]), len (l), count (1)
+      : data (allocate (l)), len (l), count (1)
     {
       std::copy (d, d+l, data);
     }
@@ -74,26 +76,40 @@ protected:
     ArrayRep (void) : data (0), len (0), count (1) { }
 
     explicit ArrayRep (octave_idx_type n)
-      : data (new T [n]), len (n), count (1) { }
+      : data (allocate (n)), len (n), count (1) { }
 
     explicit ArrayRep (octave_idx_type n, const T& val)
-      : data (new T [n]), len (n), count (1)
+      : data (allocate (n)), len (n), count (1)
     {
       std::fill_n (data, n, val);
     }
 
     ArrayRep (const ArrayRep& a)
-      : data (new T [a.len]), len (a.len), count (1)
+      : data (allocate (a.len)), len (a.len), count (1)
     {
       std::copy (a.data, a.data + a.len, data);
     }
 
-    ~ArrayRep (void) { delete [] data; }
+    ~ArrayRep (void)
+    {
+      octave::memory_stats::release (len * sizeof (T));
+
+      delete [] data;
+    }
 
     octave_idx_type numel (void) const { return len; }
 
   private:
 
+    static T *allocate (octave_idx_type n)
+    {
+      T *retval = new T [n];
+
+      octave::memory_stats::allocate_array (n * sizeof (T));
+
+      return retval;
+    }
+
     // No assignment!
 
     ArrayRep& operator = (const ArrayRep& a);
@@ -107,6 +123,9 @@ public:
   {
     if (rep->count > 1)
       {
+        octave::memory_stats::deep_copy (slice_len * sizeof (T));
+        octave::perf_counters::increment (octave::perf_counters::cow_copies);
+
         ArrayRep *r = new ArrayRep (slice_data, slice_len);
 
         if (--rep->count == 0)
@@ -153,6 +172,9 @@ private:
 
   static typename Array<T>::ArrayRep *nil_rep (void);
 
+  static octave_idx_type grow_capacity (octave_idx_type nx,
+                                        octave_idx_type n);
+
 protected:
 
   //! For jit support
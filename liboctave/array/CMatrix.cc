@@ -64,6 +64,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "oct-fftw.h"
 #include "oct-locbuf.h"
 #include "oct-norm.h"
+#include "oct-probes.h"
 
 // Fortran functions we call.
 
@@ -973,11 +974,13 @@ ComplexMatrix::tinverse (MatrixType &mattype, octave_idx_type& info,
   retval = *this;
   Complex *tmp_data = retval.fortran_vec ();
 
+  OCTAVE_PROBE1 (lapack__entry, "ztrtri");
   F77_XFCN (ztrtri, ZTRTRI, (F77_CONST_CHAR_ARG2 (&uplo, 1),
                              F77_CONST_CHAR_ARG2 (&udiag, 1),
                              nr, tmp_data, nr, info
                              F77_CHAR_ARG_LEN (1)
                              F77_CHAR_ARG_LEN (1)));
+  OCTAVE_PROBE1 (lapack__return, "ztrtri");
 
   // Throw-away extra info LAPACK gives so as to not change output.
   rcon = 0.0;
@@ -1053,7 +1056,11 @@ ComplexMatrix::finverse (MatrixType &mattype, octave_idx_type& info,
   if (octave::math::isnan (anorm) || octave::math::isinf (anorm))
     info = -1;
   else
-    F77_XFCN (zgetrf, ZGETRF, (nc, nc, tmp_data, nr, pipvt, info));
+    {
+      OCTAVE_PROBE1 (lapack__entry, "zgetrf");
+      F77_XFCN (zgetrf, ZGETRF, (nc, nc, tmp_data, nr, pipvt, info));
+      OCTAVE_PROBE1 (lapack__return, "zgetrf");
+    }
 
   // Throw-away extra info LAPACK gives so as to not change output.
   rcon = 0.0;
@@ -1081,8 +1088,10 @@ ComplexMatrix::finverse (MatrixType &mattype, octave_idx_type& info,
     {
       octave_idx_type zgetri_info = 0;
 
+      OCTAVE_PROBE1 (lapack__entry, "zgetri");
       F77_XFCN (zgetri, ZGETRI, (nc, tmp_data, nr, pipvt,
                                  pz, lwork, zgetri_info));
+      OCTAVE_PROBE1 (lapack__return, "zgetri");
 
       if (zgetri_info != 0)
         info = -1;
@@ -1567,9 +1576,11 @@ ComplexMatrix::determinant (MatrixType& mattype,
       if (calc_cond) anorm = xnorm (*this, 1);
 
       char job = 'L';
+      OCTAVE_PROBE1 (lapack__entry, "zpotrf");
       F77_XFCN (zpotrf, ZPOTRF, (F77_CONST_CHAR_ARG2 (&job, 1), nr,
                                  tmp_data, nr, info
                                  F77_CHAR_ARG_LEN (1)));
+      OCTAVE_PROBE1 (lapack__return, "zpotrf");
 
       if (info != 0)
         {
@@ -1620,7 +1631,11 @@ ComplexMatrix::determinant (MatrixType& mattype,
       if (octave::math::isnan (anorm))
         info = -1;
       else
-        F77_XFCN (zgetrf, ZGETRF, (nr, nr, tmp_data, nr, pipvt, info));
+        {
+          OCTAVE_PROBE1 (lapack__entry, "zgetrf");
+          F77_XFCN (zgetrf, ZGETRF, (nr, nr, tmp_data, nr, pipvt, info));
+          OCTAVE_PROBE1 (lapack__return, "zgetrf");
+        }
 
       // Throw-away extra info LAPACK gives so as to not change output.
       rcon = 0.0;
@@ -1763,9 +1778,11 @@ ComplexMatrix::rcond (MatrixType &mattype) const
               anorm = atmp.abs().sum().
                       row(static_cast<octave_idx_type>(0)).max();
 
+              OCTAVE_PROBE1 (lapack__entry, "zpotrf");
               F77_XFCN (zpotrf, ZPOTRF, (F77_CONST_CHAR_ARG2 (&job, 1), nr,
                                          tmp_data, nr, info
                                          F77_CHAR_ARG_LEN (1)));
+              OCTAVE_PROBE1 (lapack__return, "zpotrf");
 
               if (info != 0)
                 {
@@ -1814,7 +1831,12 @@ ComplexMatrix::rcond (MatrixType &mattype) const
               if (octave::math::isnan (anorm))
                 info = -1;
               else
-                F77_XFCN (zgetrf, ZGETRF, (nr, nr, tmp_data, nr, pipvt, info));
+                {
+                  OCTAVE_PROBE1 (lapack__entry, "zgetrf");
+                  F77_XFCN (zgetrf, ZGETRF, (nr, nr, tmp_data, nr,
+                                             pipvt, info));
+                  OCTAVE_PROBE1 (lapack__return, "zgetrf");
+                }
 
               if (info != 0)
                 {
@@ -1882,6 +1904,7 @@ ComplexMatrix::utsolve (MatrixType &mattype, const ComplexMatrix& b,
       char trans = get_blas_char (transt);
       char dia = 'N';
 
+      OCTAVE_PROBE1 (lapack__entry, "ztrtrs");
       F77_XFCN (ztrtrs, ZTRTRS, (F77_CONST_CHAR_ARG2 (&uplo, 1),
                                  F77_CONST_CHAR_ARG2 (&trans, 1),
                                  F77_CONST_CHAR_ARG2 (&dia, 1),
@@ -1890,6 +1913,7 @@ ComplexMatrix::utsolve (MatrixType &mattype, const ComplexMatrix& b,
                                  F77_CHAR_ARG_LEN (1)
                                  F77_CHAR_ARG_LEN (1)
                                  F77_CHAR_ARG_LEN (1)));
+      OCTAVE_PROBE1 (lapack__return, "ztrtrs");
 
       if (calc_cond)
         {
@@ -1972,6 +1996,7 @@ ComplexMatrix::ltsolve (MatrixType &mattype, const ComplexMatrix& b,
       char trans = get_blas_char (transt);
       char dia = 'N';
 
+      OCTAVE_PROBE1 (lapack__entry, "ztrtrs");
       F77_XFCN (ztrtrs, ZTRTRS, (F77_CONST_CHAR_ARG2 (&uplo, 1),
                                  F77_CONST_CHAR_ARG2 (&trans, 1),
                                  F77_CONST_CHAR_ARG2 (&dia, 1),
@@ -1980,6 +2005,7 @@ ComplexMatrix::ltsolve (MatrixType &mattype, const ComplexMatrix& b,
                                  F77_CHAR_ARG_LEN (1)
                                  F77_CHAR_ARG_LEN (1)
                                  F77_CHAR_ARG_LEN (1)));
+      OCTAVE_PROBE1 (lapack__return, "ztrtrs");
 
       if (calc_cond)
         {
@@ -2055,9 +2081,11 @@ ComplexMatrix::fsolve (MatrixType &mattype, const ComplexMatrix& b,
 
           anorm = atmp.abs().sum().row(static_cast<octave_idx_type>(0)).max();
 
+          OCTAVE_PROBE1 (lapack__entry, "zpotrf");
           F77_XFCN (zpotrf, ZPOTRF, (F77_CONST_CHAR_ARG2 (&job, 1), nr,
                                      tmp_data, nr, info
                                      F77_CHAR_ARG_LEN (1)));
+          OCTAVE_PROBE1 (lapack__return, "zpotrf");
 
           // Throw-away extra info LAPACK gives so as to not change output.
           rcon = 0.0;
@@ -2105,10 +2133,12 @@ ComplexMatrix::fsolve (MatrixType &mattype, const ComplexMatrix& b,
 
                   octave_idx_type b_nc = b.cols ();
 
+                  OCTAVE_PROBE1 (lapack__entry, "zpotrs");
                   F77_XFCN (zpotrs, ZPOTRS, (F77_CONST_CHAR_ARG2 (&job, 1),
                                              nr, b_nc, tmp_data, nr,
                                              result, b.rows (), info
                                              F77_CHAR_ARG_LEN (1)));
+                  OCTAVE_PROBE1 (lapack__return, "zpotrs");
                 }
               else
                 {
@@ -2143,7 +2173,11 @@ ComplexMatrix::fsolve (MatrixType &mattype, const ComplexMatrix& b,
           if (octave::math::isnan (anorm) || octave::math::isinf (anorm))
             info = -2;
           else
-            F77_XFCN (zgetrf, ZGETRF, (nr, nr, tmp_data, nr, pipvt, info));
+            {
+              OCTAVE_PROBE1 (lapack__entry, "zgetrf");
+              F77_XFCN (zgetrf, ZGETRF, (nr, nr, tmp_data, nr, pipvt, info));
+              OCTAVE_PROBE1 (lapack__return, "zgetrf");
+            }
 
           // Throw-away extra info LAPACK gives so as to not change output.
           rcon = 0.0;
@@ -2194,10 +2228,12 @@ ComplexMatrix::fsolve (MatrixType &mattype, const ComplexMatrix& b,
                   octave_idx_type b_nc = b.cols ();
 
                   char job = 'N';
+                  OCTAVE_PROBE1 (lapack__entry, "zgetrs");
                   F77_XFCN (zgetrs, ZGETRS, (F77_CONST_CHAR_ARG2 (&job, 1),
                                              nr, b_nc, tmp_data, nr,
                                              pipvt, result, b.rows (), info
                                              F77_CHAR_ARG_LEN (1)));
+                  OCTAVE_PROBE1 (lapack__return, "zgetrs");
                 }
               else
                 mattype.mark_as_rectangular ();
@@ -2679,10 +2715,12 @@ ComplexMatrix::lssolve (const ComplexMatrix& b, octave_idx_type& info,
       lwork = static_cast<octave_idx_type> (std::real (work(0)));
       work.resize (dim_vector (lwork, 1));
 
+      OCTAVE_PROBE1 (lapack__entry, "zgelsd");
       F77_XFCN (zgelsd, ZGELSD, (m, n, nrhs, tmp_data, m, pretval,
                                  maxmn, ps, rcon, rank,
                                  work.fortran_vec (), lwork,
                                  prwork, piwork, info));
+      OCTAVE_PROBE1 (lapack__return, "zgelsd");
 
       if (s.elem (0) == 0.0)
         rcon = 0.0;
@@ -2839,10 +2877,12 @@ ComplexMatrix::lssolve (const ComplexColumnVector& b, octave_idx_type& info,
       rwork.resize (dim_vector (static_cast<octave_idx_type> (rwork(0)), 1));
       iwork.resize (dim_vector (iwork(0), 1));
 
+      OCTAVE_PROBE1 (lapack__entry, "zgelsd");
       F77_XFCN (zgelsd, ZGELSD, (m, n, nrhs, tmp_data, m, pretval,
                                  maxmn, ps, rcon, rank,
                                  work.fortran_vec (), lwork,
                                  prwork, piwork, info));
+      OCTAVE_PROBE1 (lapack__return, "zgelsd");
 
       if (rank < minmn)
         {
@@ -3599,6 +3639,8 @@ xgemm (const ComplexMatrix& a, const ComplexMatrix& b,
   if (a_nc != b_nr)
     err_nonconformant ("operator *", a_nr, a_nc, b_nr, b_nc);
 
+  OCTAVE_PROBE3 (blas__gemm__entry, a_nr, a_nc, b_nc);
+
   if (a_nr == 0 || a_nc == 0 || b_nc == 0)
     retval = ComplexMatrix (a_nr, b_nc, 0.0);
   else if (a.data () == b.data () && a_nr == b_nc && tra != trb)
@@ -3695,6 +3737,8 @@ xgemm (const ComplexMatrix& a, const ComplexMatrix& b,
         }
     }
 
+  OCTAVE_PROBE (blas__gemm__return);
+
   return retval;
 }
 
@@ -167,6 +167,8 @@ Sparse<T>::SparseRep::change_length (octave_idx_type nz)
   if (nz > nzmx || nz < nzmx - nzmx/frac)
     {
       // Reallocate.
+      octave::memory_stats::release (byte_size ());
+
       octave_idx_type min_nzmx = std::min (nz, nzmx);
 
       octave_idx_type * new_ridx = new octave_idx_type [nz];
@@ -182,6 +184,8 @@ Sparse<T>::SparseRep::change_length (octave_idx_type nz)
       d = new_data;
 
       nzmx = nz;
+
+      octave::memory_stats::allocate_array (byte_size ());
     }
 }
 
@@ -978,6 +982,11 @@ Sparse<T>::resize (octave_idx_type r, octave_idx_type c)
 
   if (c != rep->ncols)
     {
+      octave::memory_stats::release ((rep->ncols + 1)
+                                     * sizeof (octave_idx_type));
+      octave::memory_stats::allocate_array ((c + 1)
+                                            * sizeof (octave_idx_type));
+
       octave_idx_type *new_cidx = new octave_idx_type [c+1];
       std::copy (rep->c, rep->c + std::min (c, rep->ncols) + 1, new_cidx);
       delete [] rep->c;
@@ -38,6 +38,8 @@ along with Octave; see the file COPYING.  If not, see
 #include "dim-vector.h"
 #include "lo-error.h"
 #include "lo-utils.h"
+#include "oct-mem-stats.h"
+#include "oct-perf-counters.h"
 
 #include "oct-sort.h"
 
@@ -77,6 +79,8 @@ protected:
         ncols (0), count (1)
     {
       c[0] = 0;
+
+      octave::memory_stats::allocate_array (byte_size ());
     }
 
     SparseRep (octave_idx_type n)
@@ -85,6 +89,8 @@ protected:
     {
       for (octave_idx_type i = 0; i < n + 1; i++)
         c[i] = 0;
+
+      octave::memory_stats::allocate_array (byte_size ());
     }
 
     SparseRep (octave_idx_type nr, octave_idx_type nc, octave_idx_type nz = 0)
@@ -95,6 +101,8 @@ protected:
     {
       for (octave_idx_type i = 0; i < nc + 1; i++)
         c[i] = 0;
+
+      octave::memory_stats::allocate_array (byte_size ());
     }
 
     SparseRep (const SparseRep& a)
@@ -106,9 +114,18 @@ protected:
       std::copy (a.d, a.d + nz, d);
       std::copy (a.r, a.r + nz, r);
       std::copy (a.c, a.c + ncols + 1, c);
+
+      octave::memory_stats::allocate_array (byte_size ());
     }
 
-    ~SparseRep (void) { delete [] d; delete [] r; delete [] c; }
+    ~SparseRep (void)
+    {
+      octave::memory_stats::release (byte_size ());
+
+      delete [] d;
+      delete [] r;
+      delete [] c;
+    }
 
     octave_idx_type length (void) const { return nzmx; }
 
@@ -138,6 +155,13 @@ protected:
 
     bool any_element_is_nan (void) const;
 
+    // The number of bytes allocated for the data and indices.
+    size_t byte_size (void) const
+    {
+      return (nzmx * (sizeof (T) + sizeof (octave_idx_type))
+              + (ncols + 1) * sizeof (octave_idx_type));
+    }
+
   private:
 
     // No assignment!
@@ -151,6 +175,9 @@ protected:
   {
     if (rep->count > 1)
       {
+        octave::memory_stats::deep_copy (rep->byte_size ());
+        octave::perf_counters::increment (octave::perf_counters::cow_copies);
+
         SparseRep *r = new SparseRep (*rep);
 
         if (--rep->count == 0)
@@ -61,6 +61,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "oct-cmplx.h"
 #include "oct-fftw.h"
 #include "oct-norm.h"
+#include "oct-probes.h"
 #include "quit.h"
 
 // Fortran functions we call.
@@ -664,11 +665,13 @@ Matrix::tinverse (MatrixType &mattype, octave_idx_type& info, double& rcon,
   retval = *this;
   double *tmp_data = retval.fortran_vec ();
 
+  OCTAVE_PROBE1 (lapack__entry, "dtrtri");
   F77_XFCN (dtrtri, DTRTRI, (F77_CONST_CHAR_ARG2 (&uplo, 1),
                              F77_CONST_CHAR_ARG2 (&udiag, 1),
                              nr, tmp_data, nr, info
                              F77_CHAR_ARG_LEN (1)
                              F77_CHAR_ARG_LEN (1)));
+  OCTAVE_PROBE1 (lapack__return, "dtrtri");
 
   // Throw-away extra info LAPACK gives so as to not change output.
   rcon = 0.0;
@@ -739,7 +742,9 @@ Matrix::finverse (MatrixType &mattype, octave_idx_type& info, double& rcon,
     anorm = retval.abs ().sum ().row (static_cast<octave_idx_type>(0))
             .max ();
 
+  OCTAVE_PROBE1 (lapack__entry, "dgetrf");
   F77_XFCN (dgetrf, DGETRF, (nc, nc, tmp_data, nr, pipvt, info));
+  OCTAVE_PROBE1 (lapack__return, "dgetrf");
 
   // Throw-away extra info LAPACK gives so as to not change output.
   rcon = 0.0;
@@ -768,8 +773,10 @@ Matrix::finverse (MatrixType &mattype, octave_idx_type& info, double& rcon,
     {
       octave_idx_type dgetri_info = 0;
 
+      OCTAVE_PROBE1 (lapack__entry, "dgetri");
       F77_XFCN (dgetri, DGETRI, (nc, tmp_data, nr, pipvt,
                                  pz, lwork, dgetri_info));
+      OCTAVE_PROBE1 (lapack__return, "dgetri");
 
       if (dgetri_info != 0)
         info = -1;
@@ -1246,9 +1253,11 @@ Matrix::determinant (MatrixType& mattype,
       if (calc_cond) anorm = xnorm (*this, 1);
 
       char job = 'L';
+      OCTAVE_PROBE1 (lapack__entry, "dpotrf");
       F77_XFCN (dpotrf, DPOTRF, (F77_CONST_CHAR_ARG2 (&job, 1), nr,
                                  tmp_data, nr, info
                                  F77_CHAR_ARG_LEN (1)));
+      OCTAVE_PROBE1 (lapack__return, "dpotrf");
 
       if (info != 0)
         {
@@ -1294,7 +1303,9 @@ Matrix::determinant (MatrixType& mattype,
       double anorm = 0;
       if (calc_cond) anorm = xnorm (*this, 1);
 
+      OCTAVE_PROBE1 (lapack__entry, "dgetrf");
       F77_XFCN (dgetrf, DGETRF, (nr, nr, tmp_data, nr, pipvt, info));
+      OCTAVE_PROBE1 (lapack__return, "dgetrf");
 
       // Throw-away extra info LAPACK gives so as to not change output.
       rcon = 0.0;
@@ -1437,9 +1448,11 @@ Matrix::rcond (MatrixType &mattype) const
               anorm = atmp.abs().sum().
                       row(static_cast<octave_idx_type>(0)).max();
 
+              OCTAVE_PROBE1 (lapack__entry, "dpotrf");
               F77_XFCN (dpotrf, DPOTRF, (F77_CONST_CHAR_ARG2 (&job, 1), nr,
                                          tmp_data, nr, info
                                          F77_CHAR_ARG_LEN (1)));
+              OCTAVE_PROBE1 (lapack__return, "dpotrf");
 
               if (info != 0)
                 {
@@ -1483,7 +1496,9 @@ Matrix::rcond (MatrixType &mattype) const
               Array<octave_idx_type> iz (dim_vector (nc, 1));
               octave_idx_type *piz = iz.fortran_vec ();
 
+              OCTAVE_PROBE1 (lapack__entry, "dgetrf");
               F77_XFCN (dgetrf, DGETRF, (nr, nr, tmp_data, nr, pipvt, info));
+              OCTAVE_PROBE1 (lapack__return, "dgetrf");
 
               if (info != 0)
                 {
@@ -1550,6 +1565,7 @@ Matrix::utsolve (MatrixType &mattype, const Matrix& b, octave_idx_type& info,
       char trans = get_blas_char (transt);
       char dia = 'N';
 
+      OCTAVE_PROBE1 (lapack__entry, "dtrtrs");
       F77_XFCN (dtrtrs, DTRTRS, (F77_CONST_CHAR_ARG2 (&uplo, 1),
                                  F77_CONST_CHAR_ARG2 (&trans, 1),
                                  F77_CONST_CHAR_ARG2 (&dia, 1),
@@ -1558,6 +1574,7 @@ Matrix::utsolve (MatrixType &mattype, const Matrix& b, octave_idx_type& info,
                                  F77_CHAR_ARG_LEN (1)
                                  F77_CHAR_ARG_LEN (1)
                                  F77_CHAR_ARG_LEN (1)));
+      OCTAVE_PROBE1 (lapack__return, "dtrtrs");
 
       if (calc_cond)
         {
@@ -1639,6 +1656,7 @@ Matrix::ltsolve (MatrixType &mattype, const Matrix& b, octave_idx_type& info,
       char trans = get_blas_char (transt);
       char dia = 'N';
 
+      OCTAVE_PROBE1 (lapack__entry, "dtrtrs");
       F77_XFCN (dtrtrs, DTRTRS, (F77_CONST_CHAR_ARG2 (&uplo, 1),
                                  F77_CONST_CHAR_ARG2 (&trans, 1),
                                  F77_CONST_CHAR_ARG2 (&dia, 1),
@@ -1647,6 +1665,7 @@ Matrix::ltsolve (MatrixType &mattype, const Matrix& b, octave_idx_type& info,
                                  F77_CHAR_ARG_LEN (1)
                                  F77_CHAR_ARG_LEN (1)
                                  F77_CHAR_ARG_LEN (1)));
+      OCTAVE_PROBE1 (lapack__return, "dtrtrs");
 
       if (calc_cond)
         {
@@ -1721,9 +1740,11 @@ Matrix::fsolve (MatrixType &mattype, const Matrix& b, octave_idx_type& info,
 
           anorm = atmp.abs().sum().row(static_cast<octave_idx_type>(0)).max();
 
+          OCTAVE_PROBE1 (lapack__entry, "dpotrf");
           F77_XFCN (dpotrf, DPOTRF, (F77_CONST_CHAR_ARG2 (&job, 1), nr,
                                      tmp_data, nr, info
                                      F77_CHAR_ARG_LEN (1)));
+          OCTAVE_PROBE1 (lapack__return, "dpotrf");
 
           // Throw-away extra info LAPACK gives so as to not change output.
           rcon = 0.0;
@@ -1771,10 +1792,12 @@ Matrix::fsolve (MatrixType &mattype, const Matrix& b, octave_idx_type& info,
 
                   octave_idx_type b_nc = b.cols ();
 
+                  OCTAVE_PROBE1 (lapack__entry, "dpotrs");
                   F77_XFCN (dpotrs, DPOTRS, (F77_CONST_CHAR_ARG2 (&job, 1),
                                              nr, b_nc, tmp_data, nr,
                                              result, b.rows (), info
                                              F77_CHAR_ARG_LEN (1)));
+                  OCTAVE_PROBE1 (lapack__return, "dpotrs");
                 }
               else
                 {
@@ -1802,7 +1825,9 @@ Matrix::fsolve (MatrixType &mattype, const Matrix& b, octave_idx_type& info,
           Array<octave_idx_type> iz (dim_vector (nc, 1));
           octave_idx_type *piz = iz.fortran_vec ();
 
+          OCTAVE_PROBE1 (lapack__entry, "dgetrf");
           F77_XFCN (dgetrf, DGETRF, (nr, nr, tmp_data, nr, pipvt, info));
+          OCTAVE_PROBE1 (lapack__return, "dgetrf");
 
           // Throw-away extra info LAPACK gives so as to not change output.
           rcon = 0.0;
@@ -1853,10 +1878,12 @@ Matrix::fsolve (MatrixType &mattype, const Matrix& b, octave_idx_type& info,
                   octave_idx_type b_nc = b.cols ();
 
                   char job = 'N';
+                  OCTAVE_PROBE1 (lapack__entry, "dgetrs");
                   F77_XFCN (dgetrs, DGETRS, (F77_CONST_CHAR_ARG2 (&job, 1),
                                              nr, b_nc, tmp_data, nr,
                                              pipvt, result, b.rows (), info
                                              F77_CHAR_ARG_LEN (1)));
+                  OCTAVE_PROBE1 (lapack__return, "dgetrs");
                 }
               else
                 mattype.mark_as_rectangular ();
@@ -2320,10 +2347,12 @@ Matrix::lssolve (const Matrix& b, octave_idx_type& info,
       lwork = static_cast<octave_idx_type> (work(0));
       work.resize (dim_vector (lwork, 1));
 
+      OCTAVE_PROBE1 (lapack__entry, "dgelsd");
       F77_XFCN (dgelsd, DGELSD, (m, n, nrhs, tmp_data, m, pretval,
                                  maxmn, ps, rcon, rank,
                                  work.fortran_vec (), lwork,
                                  piwork, info));
+      OCTAVE_PROBE1 (lapack__return, "dgelsd");
 
       if (s.elem (0) == 0.0)
         rcon = 0.0;
@@ -2472,10 +2501,12 @@ Matrix::lssolve (const ColumnVector& b, octave_idx_type& info,
       lwork = static_cast<octave_idx_type> (work(0));
       work.resize (dim_vector (lwork, 1));
 
+      OCTAVE_PROBE1 (lapack__entry, "dgelsd");
       F77_XFCN (dgelsd, DGELSD, (m, n, nrhs, tmp_data, m, pretval,
                                  maxmn, ps, rcon, rank,
                                  work.fortran_vec (), lwork,
                                  piwork, info));
+      OCTAVE_PROBE1 (lapack__return, "dgelsd");
 
       if (rank < minmn)
         {
@@ -3041,6 +3072,8 @@ xgemm (const Matrix& a, const Matrix& b,
   if (a_nc != b_nr)
     err_nonconformant ("operator *", a_nr, a_nc, b_nr, b_nc);
 
+  OCTAVE_PROBE3 (blas__gemm__entry, a_nr, a_nc, b_nc);
+
   if (a_nr == 0 || a_nc == 0 || b_nc == 0)
     retval = Matrix (a_nr, b_nc, 0.0);
   else if (a.data () == b.data () && a_nr == b_nc && tra != trb)
@@ -3106,6 +3139,8 @@ xgemm (const Matrix& a, const Matrix& b,
         }
     }
 
+  OCTAVE_PROBE (blas__gemm__return);
+
   return retval;
 }
 
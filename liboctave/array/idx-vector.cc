@@ -37,6 +37,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "Range.h"
 
 #include "oct-locbuf.h"
+#include "oct-perf-counters.h"
 #include "lo-error.h"
 #include "lo-mappers.h"
 
@@ -261,6 +262,8 @@ template <typename T>
 idx_vector::idx_scalar_rep::idx_scalar_rep (T x)
   : data (0)
 {
+  octave::perf_counters::increment (octave::perf_counters::idx_conversions);
+
   octave_idx_type dummy = 0;
 
   data = convert_index (x, err, dummy);
@@ -312,6 +315,8 @@ template <typename T>
 idx_vector::idx_vector_rep::idx_vector_rep (const Array<T>& nda)
   : data (0), len (nda.numel ()), ext (0), aowner (0), orig_dims (nda.dims ())
 {
+  octave::perf_counters::increment (octave::perf_counters::idx_conversions);
+
   if (len != 0)
     {
       std::unique_ptr<octave_idx_type []> d (new octave_idx_type [len]);
@@ -36,6 +36,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "oct-fftw.h"
 #include "quit.h"
 #include "oct-locbuf.h"
+#include "oct-perf-counters.h"
 #include "singleton-cleanup.h"
 
 #if defined (HAVE_FFTW3_THREADS) || defined (HAVE_FFTW3F_THREADS)
@@ -183,6 +184,8 @@ octave_fftw_planner::do_create_plan (int dir, const int rank,
 
   if (create_new_plan)
     {
+      octave::perf_counters::increment (octave::perf_counters::fftw_plans);
+
       d[which] = dist;
       s[which] = stride;
       r[which] = rank;
@@ -303,6 +306,8 @@ octave_fftw_planner::do_create_plan (const int rank, const dim_vector dims,
 
   if (create_new_plan)
     {
+      octave::perf_counters::increment (octave::perf_counters::fftw_plans);
+
       rd = dist;
       rs = stride;
       rr = rank;
@@ -539,6 +544,8 @@ octave_float_fftw_planner::do_create_plan (int dir, const int rank,
 
   if (create_new_plan)
     {
+      octave::perf_counters::increment (octave::perf_counters::fftw_plans);
+
       d[which] = dist;
       s[which] = stride;
       r[which] = rank;
@@ -660,6 +667,8 @@ octave_float_fftw_planner::do_create_plan (const int rank,
 
   if (create_new_plan)
     {
+      octave::perf_counters::increment (octave::perf_counters::fftw_plans);
+
       rd = dist;
       rs = stride;
       rr = rank;
@@ -26,6 +26,11 @@ along with Octave; see the file COPYING.  If not, see
 
 #include "octave-config.h"
 
+#include <cstddef>
+
+#include <new>
+#include <utility>
+
 // This class allows registering actions in a list for later
 // execution, either explicitly or when the container goes out of
 // scope.
@@ -239,42 +244,42 @@ public:
   // Call to void func (void).
   void add_fcn (void (*fcn) (void))
   {
-    add (new fcn_elem (fcn));
+    add_elem<fcn_elem> (fcn);
   }
 
   // Call to void func (T).
   template <typename T>
   void add_fcn (void (*action) (T), T val)
   {
-    add (new fcn_arg_elem<T> (action, val));
+    add_elem<fcn_arg_elem<T> > (action, val);
   }
 
   // Call to void func (const T&).
   template <typename T>
   void add_fcn (void (*action) (const T&), const T& val)
   {
-    add (new fcn_crefarg_elem<T> (action, val));
+    add_elem<fcn_crefarg_elem<T> > (action, val);
   }
 
   // Call to T::method (void).
   template <typename T>
   void add_method (T *obj, void (T::*method) (void))
   {
-    add (new method_elem<T> (obj, method));
+    add_elem<method_elem<T> > (obj, method);
   }
 
   // Call to T::method (A).
   template <typename T, typename A>
   void add_method (T *obj, void (T::*method) (A), A arg)
   {
-    add (new method_arg_elem<T, A> (obj, method, arg));
+    add_elem<method_arg_elem<T, A> > (obj, method, arg);
   }
 
   // Call to T::method (const A&).
   template <typename T, typename A>
   void add_method (T *obj, void (T::*method) (const A&), const A& arg)
   {
-    add (new method_crefarg_elem<T, A> (obj, method, arg));
+    add_elem<method_crefarg_elem<T, A> > (obj, method, arg);
   }
 
   // Call to delete (T*).
@@ -282,21 +287,21 @@ public:
   template <typename T>
   void add_delete (T *obj)
   {
-    add (new delete_ptr_elem<T> (obj));
+    add_elem<delete_ptr_elem<T> > (obj);
   }
 
   // Protect any variable.
   template <typename T>
   void protect_var (T& var)
   {
-    add (new restore_var_elem<T> (var, var));
+    add_elem<restore_var_elem<T> > (var, var);
   }
 
   // Protect any variable, value given.
   template <typename T>
   void protect_var (T& var, const T& val)
   {
-    add (new restore_var_elem<T> (var, val));
+    add_elem<restore_var_elem<T> > (var, val);
   }
 
   operator bool (void) const { return ! empty (); }
@@ -331,8 +336,40 @@ public:
 
   bool empty (void) const { return size () == 0; }
 
+protected:
+
+  // Storage for the elements created by add_fcn, add_method,
+  // add_delete and protect_var.  Elements in storage that was not
+  // obtained with operator new must not be deleted; derived classes
+  // that override these functions must also release such elements
+  // themselves.
+
+  virtual void *allocate (size_t size) { return ::operator new (size); }
+
+  virtual void deallocate (void *ptr) { ::operator delete (ptr); }
+
 private:
 
+  template <typename E, typename... A>
+  void add_elem (A&&... args)
+  {
+    void *ptr = allocate (sizeof (E));
+
+    E *new_elem;
+
+    try
+      {
+        new_elem = new (ptr) E (std::forward<A> (args)...);
+      }
+    catch (...)
+      {
+        deallocate (ptr);
+        throw;
+      }
+
+    add (new_elem);
+  }
+
   // No copying!
 
   action_container (const action_container&);
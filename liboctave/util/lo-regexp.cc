@@ -27,6 +27,7 @@ along with Octave; see the file COPYING.  If not, see
 #endif
 
 #include <list>
+#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -41,6 +42,7 @@ along with Octave; see the file COPYING.  If not, see
 #include "base-list.h"
 #include "lo-error.h"
 #include "oct-locbuf.h"
+#include "oct-refcount.h"
 #include "quit.h"
 #include "lo-regexp.h"
 #include "str-vec.h"
@@ -52,16 +54,189 @@ along with Octave; see the file COPYING.  If not, see
 // FIXME: should this be configurable?
 #define MAXLOOKBEHIND 10
 
+// Maximum number of compiled patterns to keep in the cache.
+#define MAX_CACHED_PATTERNS 128
+
 static bool lookbehind_warned = false;
 
 // FIXME: don't bother collecting and composing return values
 //        the user doesn't want.
 
+// A compiled pattern along with the information about named tokens
+// that was extracted from the original pattern.  Compiled patterns are
+// reference counted so that they may be shared by regexp objects and
+// the cache of recently used patterns.
+
+class
+regexp_compiled_pattern
+{
+public:
+
+  regexp_compiled_pattern (pcre *r, const string_vector& np, int nn,
+                           const Array<int>& ni)
+    : re (r), extra (0), named_pats (np), nnames (nn), named_idx (ni),
+      count (1)
+  {
+#if defined (PCRE_STUDY_JIT_COMPILE)
+    const char *err;
+
+    // Failure to study the pattern is not an error.  Matching will
+    // simply be done without the JIT or the extra study data.
+    extra = pcre_study (re, PCRE_STUDY_JIT_COMPILE, &err);
+#endif
+  }
+
+  ~regexp_compiled_pattern (void)
+  {
+#if defined (PCRE_STUDY_JIT_COMPILE)
+    if (extra)
+      pcre_free_study (extra);
+#endif
+
+    pcre_free (re);
+  }
+
+  pcre *re;
+
+  pcre_extra *extra;
+
+  string_vector named_pats;
+
+  int nnames;
+
+  Array<int> named_idx;
+
+  octave_refcount<int> count;
+
+private:
+
+  // No copying!
+
+  regexp_compiled_pattern (const regexp_compiled_pattern&);
+
+  regexp_compiled_pattern& operator = (const regexp_compiled_pattern&);
+};
+
+// A least recently used cache of compiled patterns, keyed on the
+// pattern and the options that affect compilation.  Functions like
+// regexp, regexprep, and strsplit create a new regexp object for each
+// string they process, so without the cache the same pattern would be
+// translated and compiled over and over again.
+
+class
+regexp_cache
+{
+public:
+
+  typedef std::pair<std::string, regexp_compiled_pattern *> entry;
+
+  typedef std::list<entry>::iterator entry_iterator;
+
+  static regexp_compiled_pattern *lookup (const std::string& key)
+  {
+    regexp_compiled_pattern *retval = 0;
+
+    std::map<std::string, entry_iterator>::iterator p = index.find (key);
+
+    if (p != index.end ())
+      {
+        // Move to the front of the list of recently used patterns.
+        lru.splice (lru.begin (), lru, p->second);
+
+        retval = p->second->second;
+      }
+
+    return retval;
+  }
+
+  static void insert (const std::string& key, regexp_compiled_pattern *cp)
+  {
+    cp->count++;
+
+    lru.push_front (entry (key, cp));
+
+    index[key] = lru.begin ();
+
+    while (lru.size () > MAX_CACHED_PATTERNS)
+      {
+        entry& last = lru.back ();
+
+        if (--last.second->count == 0)
+          delete last.second;
+
+        index.erase (last.first);
+
+        lru.pop_back ();
+      }
+  }
+
+private:
+
+  static std::list<entry> lru;
+
+  static std::map<std::string, entry_iterator> index;
+};
+
+std::list<regexp_cache::entry> regexp_cache::lru;
+
+std::map<std::string, regexp_cache::entry_iterator> regexp_cache::index;
+
+static std::string
+regexp_cache_key (const std::string& pattern, const regexp::opts& options)
+{
+  char flags = ('0'
+                + (options.case_insensitive () ? 1 : 0)
+                + (options.dotexceptnewline () ? 2 : 0)
+                + (options.lineanchors () ? 4 : 0)
+                + (options.freespacing () ? 8 : 0));
+
+  return flags + pattern;
+}
+
+regexp::regexp (const regexp& rx)
+  : pattern (rx.pattern), options (rx.options), data (rx.data),
+    named_pats (rx.named_pats), nnames (rx.nnames),
+    named_idx (rx.named_idx), who (rx.who)
+{
+  if (data)
+    static_cast<regexp_compiled_pattern *> (data)->count++;
+}
+
+regexp&
+regexp::operator = (const regexp& rx)
+{
+  if (this != &rx)
+    {
+      if (rx.data)
+        static_cast<regexp_compiled_pattern *> (rx.data)->count++;
+
+      free ();
+
+      pattern = rx.pattern;
+      options = rx.options;
+      data = rx.data;
+      named_pats = rx.named_pats;
+      nnames = rx.nnames;
+      named_idx = rx.named_idx;
+      who = rx.who;
+    }
+
+  return *this;
+}
+
 void
 regexp::free (void)
 {
   if (data)
-    pcre_free (static_cast<pcre *> (data));
+    {
+      regexp_compiled_pattern *cp
+        = static_cast<regexp_compiled_pattern *> (data);
+
+      if (--cp->count == 0)
+        delete cp;
+
+      data = 0;
+    }
 }
 
 void
@@ -70,6 +245,26 @@ regexp::compile_internal (void)
   // If we had a previously compiled pattern, release it.
   free ();
 
+  std::string key = regexp_cache_key (pattern, options);
+
+  regexp_compiled_pattern *cp = regexp_cache::lookup (key);
+
+  if (cp)
+    {
+      cp->count++;
+
+      data = cp;
+      named_pats = cp->named_pats;
+      nnames = cp->nnames;
+      named_idx = cp->named_idx;
+
+      return;
+    }
+
+  named_pats = string_vector ();
+  nnames = 0;
+  named_idx = Array<int> ();
+
   size_t max_length = MAXLOOKBEHIND;
 
   size_t pos = 0;
@@ -228,11 +423,18 @@ regexp::compile_internal (void)
        | (options.lineanchors () ? PCRE_MULTILINE : 0)
        | (options.freespacing () ? PCRE_EXTENDED : 0));
 
-  data = pcre_compile (buf_str.c_str (), pcre_options, &err, &erroffset, 0);
+  pcre *re = pcre_compile (buf_str.c_str (), pcre_options, &err, &erroffset,
+                           0);
 
-  if (! data)
+  if (! re)
     (*current_liboctave_error_handler)
       ("%s: %s at position %d of expression", who.c_str (), err, erroffset);
+
+  cp = new regexp_compiled_pattern (re, named_pats, nnames, named_idx);
+
+  regexp_cache::insert (key, cp);
+
+  data = cp;
 }
 
 regexp::match_data
@@ -248,7 +450,10 @@ regexp::match (const std::string& buffer)
   char *nametable;
   size_t idx = 0;
 
-  pcre *re = static_cast<pcre *> (data);
+  regexp_compiled_pattern *cp = static_cast<regexp_compiled_pattern *> (data);
+
+  pcre *re = cp->re;
+  pcre_extra *extra = cp->extra;
 
   pcre_fullinfo (re, 0, PCRE_INFO_CAPTURECOUNT,  &subpatterns);
   pcre_fullinfo (re, 0, PCRE_INFO_NAMECOUNT, &namecount);
@@ -270,10 +475,25 @@ regexp::match (const std::string& buffer)
     {
       OCTAVE_QUIT;
 
-      int matches = pcre_exec (re, 0, buffer.c_str (),
+      int matches = pcre_exec (re, extra, buffer.c_str (),
+                               buffer.length (), idx,
+                               (idx ? PCRE_NOTBOL : 0),
+                               ovector, (subpatterns+1)*3);
+
+#if defined (PCRE_ERROR_JIT_STACKLIMIT)
+      if (matches == PCRE_ERROR_JIT_STACKLIMIT)
+        {
+          // The JIT ran out of stack.  Retry without it.
+          pcre_extra pe = *extra;
+
+          pe.flags &= ~PCRE_EXTRA_EXECUTABLE_JIT;
+
+          matches = pcre_exec (re, &pe, buffer.c_str (),
                                buffer.length (), idx,
                                (idx ? PCRE_NOTBOL : 0),
                                ovector, (subpatterns+1)*3);
+        }
+#endif
 
       if (matches == PCRE_ERROR_MATCHLIMIT)
         {
@@ -285,10 +505,15 @@ regexp::match (const std::string& buffer)
 
           pcre_extra pe;
 
+          if (extra)
+            pe = *extra;
+          else
+            pe.flags = 0;
+
           pcre_config (PCRE_CONFIG_MATCH_LIMIT,
                        static_cast<void *> (&pe.match_limit));
 
-          pe.flags = PCRE_EXTRA_MATCH_LIMIT;
+          pe.flags |= PCRE_EXTRA_MATCH_LIMIT;
 
           int i = 0;
           while (matches == PCRE_ERROR_MATCHLIMIT
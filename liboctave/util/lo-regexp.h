@@ -53,24 +53,9 @@ public:
     compile_internal ();
   }
 
-  regexp (const regexp& rx)
-    : pattern (rx.pattern), data (rx.data), named_pats (rx.named_pats),
-      nnames (rx.nnames), named_idx (rx.named_idx)
-  { }
+  regexp (const regexp& rx);
 
-  regexp& operator = (const regexp& rx)
-  {
-    if (this != &rx)
-      {
-        pattern = rx.pattern;
-        data = rx.data;
-        named_pats = rx.named_pats;
-        nnames = rx.nnames;
-        named_idx = rx.named_idx;
-      }
-
-    return *this;
-  }
+  regexp& operator = (const regexp& rx);
 
   ~regexp (void) { free (); }
 
@@ -229,7 +214,9 @@ private:
 
   opts options;
 
-  // Internal data describing the regular expression.
+  // Internal data describing the regular expression.  This is a
+  // reference counted compiled pattern that may be shared with other
+  // regexp objects and with the cache of compiled patterns.
   void *data;
 
   std::string m;
@@ -22,10 +22,13 @@ UTIL_INC = \
   liboctave/util/oct-binmap.h \
   liboctave/util/oct-cmplx.h \
   liboctave/util/oct-glob.h \
+  liboctave/util/oct-hash-table.h \
   liboctave/util/oct-inttypes.h \
   liboctave/util/oct-inttypes-fwd.h \
   liboctave/util/oct-locbuf.h \
+  liboctave/util/oct-mem-stats.h \
   liboctave/util/oct-mutex.h \
+  liboctave/util/oct-perf-counters.h \
   liboctave/util/oct-refcount.h \
   liboctave/util/oct-rl-edit.h \
   liboctave/util/oct-rl-hist.h \
@@ -43,6 +46,7 @@ UTIL_INC = \
 
 NOINSTALL_UTIL_INC = \
   liboctave/util/kpse.h \
+  liboctave/util/oct-probes.h \
   liboctave/util/oct-sparse.h
 
 UTIL_C_SRC = \
@@ -66,7 +70,9 @@ UTIL_SRC = \
   liboctave/util/oct-glob.cc \
   liboctave/util/oct-inttypes.cc \
   liboctave/util/oct-locbuf.cc \
+  liboctave/util/oct-mem-stats.cc \
   liboctave/util/oct-mutex.cc \
+  liboctave/util/oct-perf-counters.cc \
   liboctave/util/oct-shlib.cc \
   liboctave/util/pathsearch.cc \
   liboctave/util/lo-regexp.cc \
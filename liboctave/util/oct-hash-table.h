@@ -0,0 +1,300 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if ! defined (octave_oct_hash_table_h)
+#define octave_oct_hash_table_h 1
+
+#include "octave-config.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "oct-inttypes.h"
+
+namespace octave
+{
+  // Hash functions for the key types used with idx_hash_table.  Equal
+  // values must have equal hash codes, so negative zero is hashed the
+  // same as positive zero.
+
+  inline size_t
+  hash_mix (uint64_t h)
+  {
+    // Finalization step of MurmurHash3.
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+    return static_cast<size_t> (h);
+  }
+
+  inline size_t
+  hash_combine (size_t seed, size_t h)
+  {
+    return hash_mix (seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6)
+                             + (seed >> 2)));
+  }
+
+  inline size_t
+  hash_value (double x)
+  {
+    uint64_t bits;
+
+    if (x == 0)
+      x = 0;
+
+    std::memcpy (&bits, &x, sizeof (bits));
+
+    return hash_mix (bits);
+  }
+
+  inline size_t
+  hash_value (float x)
+  {
+    return hash_value (static_cast<double> (x));
+  }
+
+  inline size_t
+  hash_value (bool x)
+  {
+    return hash_mix (x);
+  }
+
+  inline size_t
+  hash_value (char x)
+  {
+    return hash_mix (static_cast<unsigned char> (x));
+  }
+
+  template <typename T>
+  inline size_t
+  hash_value (const octave_int<T>& x)
+  {
+    return hash_mix (static_cast<uint64_t> (x.value ()));
+  }
+
+  inline size_t
+  hash_value (const char *s, size_t len)
+  {
+    // FNV-1a.
+    uint64_t h = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < len; i++)
+      {
+        h ^= static_cast<unsigned char> (s[i]);
+        h *= 0x100000001b3ULL;
+      }
+
+    return hash_mix (h);
+  }
+
+  inline size_t
+  hash_value (const std::string& s)
+  {
+    return hash_value (s.data (), s.length ());
+  }
+
+  // An open addressing hash table of indices.  The keys themselves are
+  // stored elsewhere, usually in an array, and are identified by their
+  // index.  Callers supply the hash code of the key being looked up and
+  // a predicate EQ such that EQ (I) is true if the key being looked up
+  // is equal to the key with index I.  The table uses linear probing
+  // and is kept at most half full.
+
+  class
+  idx_hash_table
+  {
+  public:
+
+    idx_hash_table (octave_idx_type n = 0)
+      : slot_idx (), slot_hash (), mask (0), count (0)
+    {
+      size_t len = 16;
+
+      while (len < 2 * static_cast<size_t> (n))
+        len *= 2;
+
+      slot_idx.resize (len, -1);
+      slot_hash.resize (len, 0);
+      mask = len - 1;
+    }
+
+    // Number of indices stored in the table.
+    octave_idx_type numel (void) const { return count; }
+
+    // Return the stored index of a key equal to the one being looked
+    // up, or -1 if there is none.
+
+    template <typename EQ>
+    octave_idx_type find (size_t h, const EQ& eq) const
+    {
+      for (size_t k = h & mask; ; k = (k + 1) & mask)
+        {
+          octave_idx_type idx = slot_idx[k];
+
+          if (idx < 0)
+            return -1;
+          else if (slot_hash[k] == h && eq (idx))
+            return idx;
+        }
+    }
+
+    // If a key equal to the one being looked up is already stored,
+    // return its index.  Otherwise, store IDX and return -1.
+
+    template <typename EQ>
+    octave_idx_type insert (size_t h, octave_idx_type idx, const EQ& eq)
+    {
+      size_t k = h & mask;
+
+      for (; ; k = (k + 1) & mask)
+        {
+          octave_idx_type i = slot_idx[k];
+
+          if (i < 0)
+            break;
+          else if (slot_hash[k] == h && eq (i))
+            return i;
+        }
+
+      slot_idx[k] = idx;
+      slot_hash[k] = h;
+
+      if (2 * static_cast<size_t> (++count) > mask)
+        grow ();
+
+      return -1;
+    }
+
+    // Remove the key equal to the one being looked up and return its
+    // index, or return -1 if there is none.  Later entries of the
+    // probe sequence are shifted back so that no deleted markers are
+    // needed.
+
+    template <typename EQ>
+    octave_idx_type remove (size_t h, const EQ& eq)
+    {
+      size_t k = h & mask;
+
+      for (; ; k = (k + 1) & mask)
+        {
+          octave_idx_type i = slot_idx[k];
+
+          if (i < 0)
+            return -1;
+          else if (slot_hash[k] == h && eq (i))
+            break;
+        }
+
+      octave_idx_type retval = slot_idx[k];
+
+      for (size_t j = k; ; )
+        {
+          slot_idx[k] = -1;
+
+          size_t home;
+
+          do
+            {
+              j = (j + 1) & mask;
+
+              if (slot_idx[j] < 0)
+                {
+                  count--;
+                  return retval;
+                }
+
+              home = slot_hash[j] & mask;
+            }
+          while (k <= j ? (k < home && home <= j) : (k < home || home <= j));
+
+          slot_idx[k] = slot_idx[j];
+          slot_hash[k] = slot_hash[j];
+
+          k = j;
+        }
+    }
+
+    // Replace the stored index OLD_IDX of a key with hash code H by
+    // NEW_IDX.
+
+    void reindex (size_t h, octave_idx_type old_idx, octave_idx_type new_idx)
+    {
+      for (size_t k = h & mask; slot_idx[k] >= 0; k = (k + 1) & mask)
+        {
+          if (slot_idx[k] == old_idx)
+            {
+              slot_idx[k] = new_idx;
+              break;
+            }
+        }
+    }
+
+    void clear (void)
+    {
+      slot_idx.assign (slot_idx.size (), -1);
+      count = 0;
+    }
+
+  private:
+
+    void grow (void)
+    {
+      size_t len = 2 * slot_idx.size ();
+
+      std::vector<octave_idx_type> old_idx (len, -1);
+      std::vector<size_t> old_hash (len, 0);
+
+      old_idx.swap (slot_idx);
+      old_hash.swap (slot_hash);
+
+      mask = len - 1;
+
+      for (size_t j = 0; j < old_idx.size (); j++)
+        {
+          if (old_idx[j] >= 0)
+            {
+              size_t k = old_hash[j] & mask;
+
+              while (slot_idx[k] >= 0)
+                k = (k + 1) & mask;
+
+              slot_idx[k] = old_idx[j];
+              slot_hash[k] = old_hash[j];
+            }
+        }
+    }
+
+    std::vector<octave_idx_type> slot_idx;
+
+    std::vector<size_t> slot_hash;
+
+    size_t mask;
+
+    octave_idx_type count;
+  };
+}
+
+#endif
@@ -28,6 +28,7 @@ along with Octave; see the file COPYING.  If not, see
 
 #include "lo-error.h"
 #include "oct-locbuf.h"
+#include "oct-perf-counters.h"
 
 // FIXME: Maybe we should querying for available physical memory?
 
@@ -75,10 +76,18 @@ octave_chunk_buffer::octave_chunk_buffer (size_t size) : cnk (0), dat (0)
           // Use new [] to get std::bad_alloc if out of memory.
 
           dat = new char [size];
+
+          octave::perf_counters::increment
+            (octave::perf_counters::chunk_allocations);
+
           return;
         }
 
       dat = new char [chunk_size];
+
+      octave::perf_counters::increment
+        (octave::perf_counters::chunk_allocations);
+
       chunk = top = dat;
       left = chunk_size;
     }
@@ -0,0 +1,56 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include "oct-mem-stats.h"
+#include "oct-probes.h"
+
+namespace octave
+{
+  size_t memory_stats::allocated_bytes = 0;
+  size_t memory_stats::freed_bytes = 0;
+  size_t memory_stats::live_bytes = 0;
+  size_t memory_stats::peak_bytes = 0;
+  size_t memory_stats::mark_peak_bytes = 0;
+  size_t memory_stats::num_copies = 0;
+  size_t memory_stats::copied_bytes = 0;
+
+  void
+  memory_stats::allocate_array (size_t n)
+  {
+    OCTAVE_PROBE1 (array__alloc, n);
+
+    allocate (n);
+  }
+
+  void
+  memory_stats::deep_copy (size_t n)
+  {
+    OCTAVE_PROBE1 (array__copy, n);
+
+    num_copies++;
+    copied_bytes += n;
+  }
+}
@@ -0,0 +1,102 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if ! defined (octave_oct_mem_stats_h)
+#define octave_oct_mem_stats_h 1
+
+#include "octave-config.h"
+
+#include <cstddef>
+
+namespace octave
+{
+  // Counters for the memory used by the data of Array and Sparse
+  // objects and by octave_value objects.  The counters are updated
+  // without locking, so they are only exact if the objects are created
+  // and destroyed by a single thread, as they are in the interpreter.
+
+  class
+  OCTAVE_API
+  memory_stats
+  {
+  public:
+
+    static void allocate (size_t n)
+    {
+      allocated_bytes += n;
+      live_bytes += n;
+
+      if (live_bytes > mark_peak_bytes)
+        {
+          mark_peak_bytes = live_bytes;
+
+          if (live_bytes > peak_bytes)
+            peak_bytes = live_bytes;
+        }
+    }
+
+    // Like allocate, for the data of an array.  This is not inline so
+    // that the tracing probe for it is in the library.
+    static void allocate_array (size_t n);
+
+    static void release (size_t n)
+    {
+      freed_bytes += n;
+      live_bytes -= n;
+    }
+
+    // Note a copy of N bytes of data that was made because the data
+    // was shared (copy-on-write).
+    static void deep_copy (size_t n);
+
+    static size_t allocated (void) { return allocated_bytes; }
+
+    static size_t freed (void) { return freed_bytes; }
+
+    static size_t live (void) { return live_bytes; }
+
+    static size_t peak (void) { return peak_bytes; }
+
+    static size_t copies (void) { return num_copies; }
+
+    static size_t copied (void) { return copied_bytes; }
+
+    // The largest number of live bytes since the last call to
+    // reset_mark_peak.
+
+    static size_t mark_peak (void) { return mark_peak_bytes; }
+
+    static void reset_mark_peak (void) { mark_peak_bytes = live_bytes; }
+
+  private:
+
+    static size_t allocated_bytes;
+    static size_t freed_bytes;
+    static size_t live_bytes;
+    static size_t peak_bytes;
+    static size_t mark_peak_bytes;
+    static size_t num_copies;
+    static size_t copied_bytes;
+  };
+}
+
+#endif
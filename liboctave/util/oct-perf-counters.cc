@@ -0,0 +1,57 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <algorithm>
+
+#include "oct-perf-counters.h"
+
+namespace octave
+{
+  size_t perf_counters::counts[perf_counters::num_counters] = { 0 };
+
+  const char *
+  perf_counters::name (counter_id id)
+  {
+    static const char *names[num_counters] =
+    {
+      "cow_copies",
+      "idx_conversions",
+      "binary_op_conversions",
+      "load_path_rescans",
+      "fcn_lookup_misses",
+      "chunk_allocations",
+      "fftw_plans"
+    };
+
+    return names[id];
+  }
+
+  void
+  perf_counters::reset (void)
+  {
+    std::fill_n (counts, static_cast<int> (num_counters), 0);
+  }
+}
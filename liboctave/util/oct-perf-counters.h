@@ -0,0 +1,84 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if ! defined (octave_oct_perf_counters_h)
+#define octave_oct_perf_counters_h 1
+
+#include "octave-config.h"
+
+#include <cstddef>
+
+namespace octave
+{
+  // Counters for events that are expensive enough to matter for the
+  // performance of the interpreter, so that tests can check that they
+  // don't happen more often than expected.  Counting is a single
+  // increment, so the counters are always enabled.  Like the memory
+  // counters, they are not updated atomically.
+
+  class
+  OCTAVE_API
+  perf_counters
+  {
+  public:
+
+    enum counter_id
+    {
+      // Copies of the data of arrays that were shared when modified.
+      cow_copies,
+
+      // Index vectors converted from arrays or scalars of numbers.
+      idx_conversions,
+
+      // Operands converted to another type to find a binary operator.
+      binary_op_conversions,
+
+      // Rescans of the directories in the load path.
+      load_path_rescans,
+
+      // Function lookups that failed before rescanning the load path.
+      fcn_lookup_misses,
+
+      // Heap allocations by octave_chunk_buffer.
+      chunk_allocations,
+
+      // FFTW plans created.
+      fftw_plans,
+
+      num_counters
+    };
+
+    static void increment (counter_id id) { counts[id]++; }
+
+    static size_t value (counter_id id) { return counts[id]; }
+
+    static const char *name (counter_id id);
+
+    static void reset (void);
+
+  private:
+
+    static size_t counts[num_counters];
+  };
+}
+
+#endif
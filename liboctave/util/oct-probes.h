@@ -0,0 +1,80 @@
+/*
+
+Copyright (C) 2026 The Octave Project Developers
+
+This file is part of Octave.
+
+Octave is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+Octave is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with Octave; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+
+*/
+
+#if ! defined (octave_oct_probes_h)
+#define octave_oct_probes_h 1
+
+// Static probes (USDT) for tracing tools such as SystemTap, perf, and
+// bpftrace.  All probes belong to the provider "octave".  A probe is a
+// single no-op instruction and a note in the library that tells the
+// tracer where it is, so the arguments should be cheap to compute.
+// Configuring with --disable-probes removes them entirely.
+//
+// This header depends on config.h and must not be included by
+// installed headers.
+//
+// The probes are
+//
+//   function__entry (name, file)       user function called
+//   function__return (name)            user function returned or failed
+//   array__alloc (bytes)               array data allocated
+//   array__copy (bytes)                shared array data copied
+//   blas__gemm__entry (m, k, n)        matrix product computed
+//   blas__gemm__return ()
+//   lapack__entry (routine)            LAPACK routine called
+//   lapack__return (routine)
+//   stream__read (fid, bytes)          data read by fread
+//   stream__write (fid, bytes)         data written by fwrite
+//   load__entry (file)                 load called
+//   load__return (file)
+//   save__entry (file)                 save called
+//   save__return (file)
+
+#if defined (ENABLE_PROBES)
+
+#  include <sys/sdt.h>
+
+#  define OCTAVE_PROBE(name) \
+  DTRACE_PROBE (octave, name)
+
+#  define OCTAVE_PROBE1(name, a1) \
+  DTRACE_PROBE1 (octave, name, a1)
+
+#  define OCTAVE_PROBE2(name, a1, a2) \
+  DTRACE_PROBE2 (octave, name, a1, a2)
+
+#  define OCTAVE_PROBE3(name, a1, a2, a3) \
+  DTRACE_PROBE3 (octave, name, a1, a2, a3)
+
+#else
+
+#  define OCTAVE_PROBE(name) ((void) 0)
+
+#  define OCTAVE_PROBE1(name, a1) ((void) 0)
+
+#  define OCTAVE_PROBE2(name, a1, a2) ((void) 0)
+
+#  define OCTAVE_PROBE3(name, a1, a2, a3) ((void) 0)
+
+#endif
+
+#endif
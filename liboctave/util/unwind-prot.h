@@ -28,8 +28,8 @@ along with Octave; see the file COPYING.  If not, see
 
 #include <cstddef>
 
-#include <stack>
-#include <memory>
+#include <type_traits>
+#include <vector>
 
 #include "action-container.h"
 
@@ -41,7 +41,7 @@ namespace octave
   {
   public:
 
-    unwind_protect (void) : lifo () { }
+    unwind_protect (void) : nelem (0), arena_used (0), overflow () { }
 
     // Destructor should not raise an exception, so all actions
     // registered should be exception-safe.  If you're not sure, see
@@ -51,7 +51,12 @@ namespace octave
 
     virtual void add (elem *new_elem)
     {
-      lifo.push (new_elem);
+      if (nelem < max_inline_elem)
+        lifo[nelem] = new_elem;
+      else
+        overflow.push_back (new_elem);
+
+      nelem++;
     }
 
     OCTAVE_DEPRECATED ("use 'add (new fcn_arg_elem<void *> (fcn, ptr))' instead")
@@ -69,10 +74,20 @@ namespace octave
     {
       if (! empty ())
         {
+          elem *ptr = pop ();
+
           // No leak on exception!
-          std::unique_ptr<elem> ptr (lifo.top ());
-          lifo.pop ();
-          ptr->run ();
+          try
+            {
+              ptr->run ();
+            }
+          catch (...)
+            {
+              release (ptr);
+              throw;
+            }
+
+          release (ptr);
         }
     }
 
@@ -85,24 +100,94 @@ namespace octave
     void discard_first (void)
     {
       if (! empty ())
-        {
-          elem *ptr = lifo.top ();
-          lifo.pop ();
-          delete ptr;
-        }
+        release (pop ());
     }
 
     OCTAVE_DEPRECATED ("use 'discard' instead")
     void discard_top (int num) { discard (num); }
 
-    size_t size (void) const { return lifo.size (); }
+    size_t size (void) const { return nelem; }
 
   protected:
 
-    std::stack<elem *> lifo;
+    // Most frames hold only a few small actions, so the actions and the
+    // list of pointers to them are stored in the object itself.  Actions
+    // are added and removed in LIFO order, so the arena is a simple
+    // stack.  Anything that does not fit is allocated on the heap.
+
+    static const size_t max_inline_elem = 16;
+
+    static const size_t arena_size = 256;
+
+    void *allocate (size_t size)
+    {
+      size_t align = alignof (std::max_align_t);
+      size_t len = (size + align - 1) & ~(align - 1);
+
+      if (len > arena_size - arena_used)
+        return ::operator new (size);
+
+      void *ptr = arena_data () + arena_used;
+      arena_used += len;
+
+      return ptr;
+    }
+
+    void deallocate (void *ptr)
+    {
+      if (in_arena (ptr))
+        arena_used = static_cast<char *> (ptr) - arena_data ();
+      else
+        ::operator delete (ptr);
+    }
+
+    size_t nelem;
+
+    elem *lifo[max_inline_elem];
+
+    size_t arena_used;
+
+    std::aligned_storage<arena_size, alignof (std::max_align_t)>::type arena;
+
+    std::vector<elem *> overflow;
 
   private:
 
+    char *arena_data (void) { return reinterpret_cast<char *> (&arena); }
+
+    bool in_arena (const void *ptr)
+    {
+      const char *p = static_cast<const char *> (ptr);
+
+      return p >= arena_data () && p < arena_data () + arena_size;
+    }
+
+    elem *pop (void)
+    {
+      nelem--;
+
+      if (nelem < max_inline_elem)
+        return lifo[nelem];
+
+      elem *ptr = overflow.back ();
+      overflow.pop_back ();
+      return ptr;
+    }
+
+    // Elements in the arena are destroyed in place; all others were
+    // allocated with operator new.
+
+    void release (elem *ptr)
+    {
+      if (in_arena (ptr))
+        {
+          ptr->~elem ();
+          deallocate (ptr);
+        }
+      else
+        delete ptr;
+    }
+
     // No copying!
 
     unwind_protect (const unwind_protect&);
@@ -29,6 +29,8 @@ along with Octave; see the file COPYING.  If not, see
 #  include "config.h"
 #endif
 
+#include <time.h>
+
 #include <sys/resource.h>
 #include <sys/time.h>
 #include <sys/times.h>
@@ -56,6 +58,34 @@ octave_gettimeofday_wrapper (time_t *sec, long *usec)
   return status;
 }
 
+// Time from a clock that is not affected by changes of the system
+// time.  Falls back to the time of day if there is no such clock.
+
+int
+octave_monotonic_time_wrapper (time_t *sec, long *nsec)
+{
+  long usec;
+  int status;
+
+#if defined (HAVE_CLOCK_GETTIME) && defined (CLOCK_MONOTONIC)
+  struct timespec ts;
+
+  if (clock_gettime (CLOCK_MONOTONIC, &ts) == 0)
+    {
+      *sec = ts.tv_sec;
+      *nsec = ts.tv_nsec;
+
+      return 0;
+    }
+#endif
+
+  status = octave_gettimeofday_wrapper (sec, &usec);
+
+  *nsec = 1000 * usec;
+
+  return status;
+}
+
 int
 octave_cpu_time (time_t *usr_sec, time_t *sys_sec,
                  long *usr_usec, long *sys_usec)
@@ -152,3 +182,22 @@ octave_mktime_wrapper (struct tm *tp)
 {
   return mktime (tp);
 }
+
+// Start a timer that sends SIGPROF every USEC microseconds of CPU time
+// used by the process, or stop it if USEC is 0.
+
+int
+octave_set_profiling_timer_wrapper (long usec)
+{
+#if defined (HAVE_SETITIMER) && defined (ITIMER_PROF)
+  struct itimerval it;
+
+  it.it_interval.tv_sec = usec / 1000000;
+  it.it_interval.tv_usec = usec % 1000000;
+  it.it_value = it.it_interval;
+
+  return setitimer (ITIMER_PROF, &it, 0);
+#else
+  return -1;
+#endif
+}
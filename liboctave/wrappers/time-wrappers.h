@@ -35,6 +35,8 @@ extern "C" {
 
 extern int octave_gettimeofday_wrapper (time_t *sec, long *usec);
 
+extern int octave_monotonic_time_wrapper (time_t *sec, long *nsec);
+
 extern int
 octave_cpu_time (time_t *usr_sec, time_t *sys_sec,
                  long *usr_usec, long *sys_usec);
@@ -51,6 +53,8 @@ octave_getrusage_wrapper (time_t *usr_sec, time_t *sys_sec,
 extern time_t
 octave_mktime_wrapper (struct tm *tp);
 
+extern int octave_set_profiling_timer_wrapper (long usec);
+
 #if defined __cplusplus
 }
 #endif
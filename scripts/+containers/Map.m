@@ -0,0 +1,142 @@
+## Copyright (C) 2026 The Octave Project Developers
+##
+## This file is part of Octave.
+##
+## Octave is free software; you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or (at
+## your option) any later version.
+##
+## Octave is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+## General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+## -*- texinfo -*-
+## @deftypefn  {} {@var{m} =} containers.Map ()
+## @deftypefnx {} {@var{m} =} containers.Map (@var{keys}, @var{vals})
+## @deftypefnx {} {@var{m} =} containers.Map (@var{keys}, @var{vals}, "UniformValues", @var{is_uniform})
+## @deftypefnx {} {@var{m} =} containers.Map ("KeyType", @var{kt}, "ValueType", @var{vt})
+##
+## Create an object of the containers.Map class that stores a list of
+## key-value pairs.
+##
+## @var{keys} is an array of @emph{unique} keys for the map.  The keys can
+## be numeric scalars or strings.  The type for numeric keys may be one of
+## @qcode{"double"}, @qcode{"single"}, @qcode{"int32"}, @qcode{"uint32"},
+## @qcode{"int64"}, or @qcode{"uint64"}.  Keys of other numeric types are
+## stored with the key type @qcode{"double"}.  A single string key may be
+## entered as is.  Multiple string keys are entered as a cell array of
+## strings.
+##
+## @var{vals} is an array of values for the map with the @emph{same} number
+## of elements as @var{keys}.
+##
+## When called with no input arguments a default map is created with
+## strings as the key type and @qcode{"any"} as the value type.
+##
+## The @qcode{"UniformValues"} option specifies whether the values of
+## the map must be strictly of the same type.  If @var{is_uniform} is true,
+## any values which would be added to the map are first validated to ensure
+## they are of the correct type.
+##
+## When called with @qcode{"KeyType"} and @qcode{"ValueType"} arguments,
+## create an empty map with the specified types.  The inputs @var{kt} and
+## @var{vt} are the types for the keys and values of the map respectively.
+## Allowed values for @var{kt} are @qcode{"char"}, @qcode{"double"},
+## @qcode{"single"}, @qcode{"int32"}, @qcode{"uint32"}, @qcode{"int64"},
+## @qcode{"uint64"}.  Allowed values for @var{vt} are @qcode{"any"},
+## @qcode{"char"}, @qcode{"double"}, @qcode{"single"}, @qcode{"int32"},
+## @qcode{"uint32"}, @qcode{"int64"}, @qcode{"uint64"}, @qcode{"logical"}.
+##
+## The keys and values are stored in a hash table, so looking up, adding,
+## or removing a key takes constant time on average.  Keys of the types
+## @qcode{"int64"} and @qcode{"uint64"} are stored exactly.  The value for
+## a key is obtained or set by indexing the map with the key, as in
+## @code{@var{m}(@var{key})}.  The read-only properties @code{Count},
+## @code{KeyType}, and @code{ValueType} return the number of entries and
+## the types of the map.
+##
+## Maps have the following methods.  They may be called as
+## @code{keys (@var{m})} or as @code{@var{m}.keys ()}.  They are not
+## global functions, so they do not hide functions with the same names
+## that are called with other arguments.
+##
+## @table @code
+## @item keys (@var{m})
+## Return the keys of @var{m} in a cell array, sorted in ascending order.
+##
+## @item values (@var{m})
+## @itemx values (@var{m}, @var{keys})
+## Return the values of @var{m} in a cell array, in the order of the sorted
+## keys.  If the cell array @var{keys} is given, return the values
+## corresponding to those keys in a cell array of the same size.  It is an
+## error if any of the keys is not present in @var{m}.
+##
+## @item isKey (@var{m}, @var{key})
+## Return true if @var{key} is a key of @var{m}.  If @var{key} is a cell
+## array, return a logical array of the same size indicating which of its
+## elements are keys of @var{m}.
+##
+## @item remove (@var{m}, @var{key})
+## Remove @var{key}, or each key in the cell array @var{key}, and its value
+## from @var{m}.  It is an error if any of the keys is not present.
+## @end table
+##
+## Maps have reference semantics.  Copying a map does not copy its keys and
+## values, so changes made through one copy are visible through all copies.
+##
+## @seealso{struct}
+## @end deftypefn
+
+function m = Map (varargin)
+
+  m = __containers_map__ (varargin{:});
+
+endfunction
+
+
+%!test
+%! m = containers.Map ();
+%! assert (m.Count, 0);
+%! assert (length (m), 0);
+%! assert (isempty (m));
+%! assert (m.KeyType, "char");
+%! assert (m.ValueType, "any");
+
+%!test
+%! m = containers.Map ({"a", "b", "c"}, {1, "two", [3, 3]});
+%! assert (m.Count, 3);
+%! assert (m.ValueType, "any");
+%! assert (m("b"), "two");
+%! assert (m.keys (), {"a", "b", "c"});
+%! assert (m.values ({"c"}), {[3, 3]});
+%! assert (m.isKey ({"a", "z"}), [true, false]);
+
+%!test
+%! m = containers.Map ("KeyType", "double", "ValueType", "double");
+%! for i = 1:1000
+%!   m(i) = i^2;
+%! endfor
+%! assert (m.Count, 1000);
+%! assert (m(31), 961);
+%! remove (m, num2cell (1:2:1000));
+%! assert (m.Count, 500);
+%! assert (cell2mat (keys (m)), 2:2:1000);
+%! assert (cell2mat (values (m)), (2:2:1000).^2);
+
+%!test
+%! m1 = containers.Map ("x", 1);
+%! m2 = m1;
+%! m2("y") = 2;
+%! assert (keys (m1), {"x", "y"});
+%! remove (m2, "x");
+%! assert (keys (m1), {"y"});
+
+%!error <the number of keys and values must match>
+%! containers.Map ({"a", "b"}, {1});
+%!error <unsupported ValueType> containers.Map ("ValueType", "cell")
@@ -0,0 +1,14 @@
+FCN_FILE_DIRS += scripts/+containers
+
+scripts_PLUS_containers_FCN_FILES = \
+  scripts/+containers/Map.m
+
+scripts_PLUS_containersdir = $(fcnfiledir)/+containers
+
+scripts_PLUS_containers_DATA = $(scripts_PLUS_containers_FCN_FILES)
+
+FCN_FILES += $(scripts_PLUS_containers_FCN_FILES)
+
+PKG_ADD_FILES += scripts/+containers/PKG_ADD
+
+DIRSTAMP_FILES += scripts/+containers/$(octave_dirstamp)
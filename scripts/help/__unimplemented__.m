@@ -607,7 +607,6 @@ function list = missing_functions ()
   "commandwindow",
   "condeig",
   "coneplot",
-  "containers.Map",
   "contourslice",
   "corrcoef",
   "countcats",
@@ -693,7 +692,6 @@ function list = missing_functions ()
   "iscategorical",
   "iscategory",
   "isenum",
-  "isKey",
   "ismissing",
   "isocaps",
   "isordinal",
@@ -705,7 +703,6 @@ function list = missing_functions ()
   "javaMethodEDT",
   "javaObjectEDT",
   "join",
-  "keys",
   "last",
   "ldl",
   "libfunctions",
@@ -726,7 +723,6 @@ function list = missing_functions ()
   "matfile",
   "matlabrc",
   "memmapfile",
-  "memory",
   "mergecats",
   "methodsview",
   "MException",
@@ -792,7 +788,6 @@ function list = missing_functions ()
   "readtable",
   "reducepatch",
   "reducevolume",
-  "remove",
   "removecats",
   "renamecats",
   "reordercats",
@@ -863,7 +858,6 @@ function list = missing_functions ()
   "unmesh",
   "unstack",
   "userpath",
-  "values",
   "varfun",
   "verctrl",
   "verLessThan",
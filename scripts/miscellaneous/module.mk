@@ -52,7 +52,6 @@ scripts_miscellaneous_FCN_FILES = \
   scripts/miscellaneous/news.m \
   scripts/miscellaneous/open.m \
   scripts/miscellaneous/orderfields.m \
-  scripts/miscellaneous/pack.m \
   scripts/miscellaneous/parseparams.m \
   scripts/miscellaneous/perl.m \
   scripts/miscellaneous/python.m \
@@ -4,6 +4,7 @@ scripts_CLEANFILES =
 scripts_DISTCLEANFILES =
 scripts_MAINTAINERCLEANFILES =
 
+include scripts/+containers/module.mk
 include scripts/audio/module.mk
 include scripts/deprecated/module.mk
 include scripts/elfun/module.mk
@@ -95,7 +96,9 @@ $(1)/PKG_ADD: $$($(2)_FCN_FILES) $$($(2)_GEN_FCN_FILES) $(1)/$(octave_dirstamp)
 	mv $$@-t $$@
 endef
 
-$(foreach d, $(FCN_FILE_DIRS), $(eval $(call PKG_ADD_FILE_TEMPLATE, $(d),$(subst /,_,$(subst -,_,$(d))))))
+## Automake variable names can't contain '+', so package directories
+## such as scripts/+containers use the prefix scripts_PLUS_containers.
+$(foreach d, $(FCN_FILE_DIRS), $(eval $(call PKG_ADD_FILE_TEMPLATE, $(d),$(subst +,PLUS_,$(subst /,_,$(subst -,_,$(d)))))))
 
 define GEN_FCN_FILES_TEMPLATE
 $(1): $(1:.m=.in.m) build-aux/subst-config-vals.sh $(dir $(1))$(octave_dirstamp)
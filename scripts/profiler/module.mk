@@ -4,8 +4,10 @@ FCN_FILE_DIRS += \
 scripts_profiler_FCN_FILES = \
   scripts/profiler/profexplore.m \
   scripts/profiler/profexport.m \
+  scripts/profiler/profflame.m \
   scripts/profiler/profile.m \
-  scripts/profiler/profshow.m
+  scripts/profiler/profshow.m \
+  scripts/profiler/proftrace.m
 
 scripts_profilerdir = $(fcnfiledir)/profiler
 scripts_profiler_DATA = $(scripts_profiler_FCN_FILES)
@@ -0,0 +1,113 @@
+## Copyright (C) 2026 The Octave Project Developers
+##
+## This file is part of Octave.
+##
+## Octave is free software; you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or (at
+## your option) any later version.
+##
+## Octave is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+## General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+## -*- texinfo -*-
+## @deftypefn  {} {} profflame (@var{file})
+## @deftypefnx {} {} profflame (@var{file}, @var{data})
+## Export the profiler call tree as collapsed stacks for flame graphs.
+##
+## Write one line to @var{file} for each node of the hierarchical profile.
+## Each line consists of the names of the functions on the call stack,
+## separated by semicolons, followed by the time spent in the innermost
+## function itself, in microseconds.  This is the input format of the
+## @command{flamegraph.pl} script and of most other flame graph viewers.
+##
+## The input @var{data} is the structure returned by @code{profile ("info")}.
+## If unspecified, @code{profflame} will use the current profile dataset.
+##
+## @seealso{proftrace, profexport, profshow, profile}
+## @end deftypefn
+
+function profflame (file, data)
+
+  if (nargin < 1 || nargin > 2)
+    print_usage ();
+  endif
+
+  if (! ischar (file))
+    error ("profflame: FILE must be a string");
+  endif
+
+  if (nargin == 1)
+    data = profile ("info");
+  endif
+
+  names = strrep ({data.FunctionTable.FunctionName}, ";", ":");
+  lines = __collapse__ (data.Hierarchical, names, "", {});
+
+  fid = fopen (file, "w");
+  if (fid < 0)
+    error ("profflame: failed to open '%s' for writing", file);
+  endif
+  unwind_protect
+    if (! isempty (lines))
+      fprintf (fid, "%s\n", lines{:});
+    endif
+  unwind_protect_cleanup
+    fclose (fid);
+  end_unwind_protect
+
+endfunction
+
+function lines = __collapse__ (nodes, names, prefix, lines)
+
+  for i = 1 : numel (nodes)
+    stack = [prefix, names{nodes(i).Index}];
+    usec = round (1e6 * nodes(i).SelfTime);
+    if (usec > 0)
+      lines{end+1} = sprintf ("%s %d", stack, usec);
+    endif
+    lines = __collapse__ (nodes(i).Children, names, [stack, ";"], lines);
+  endfor
+
+endfunction
+
+
+%!test
+%! fcn = struct ("FunctionName", {"f", "g;h"});
+%! leaf = struct ("Index", 2, "SelfTime", 0.25, "TotalTime", 0.25,
+%!                "NumCalls", 1, "Children", struct ([]));
+%! root = struct ("Index", 1, "SelfTime", 1.5, "TotalTime", 1.75,
+%!                "NumCalls", 1, "Children", leaf);
+%! data = struct ("FunctionTable", fcn, "Hierarchical", root);
+%! file = tempname ();
+%! unwind_protect
+%!   profflame (file, data);
+%!   str = fileread (file);
+%! unwind_protect_cleanup
+%!   unlink (file);
+%! end_unwind_protect
+%! assert (str, "f 1500000\nf;g:h 250000\n");
+
+## An empty profile gives an empty file
+%!test
+%! data = struct ("FunctionTable", struct ("FunctionName", {}),
+%!                "Hierarchical", struct ([]));
+%! file = tempname ();
+%! unwind_protect
+%!   profflame (file, data);
+%!   str = fileread (file);
+%! unwind_protect_cleanup
+%!   unlink (file);
+%! end_unwind_protect
+%! assert (isempty (str));
+
+## Test input validation
+%!error profflame ()
+%!error profflame (1, 2, 3)
+%!error <FILE must be a string> profflame (5)
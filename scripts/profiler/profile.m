@@ -18,8 +18,12 @@
 
 ## -*- texinfo -*-
 ## @deftypefn  {} {} profile on
+## @deftypefnx {} {} profile on -sample
+## @deftypefnx {} {} profile on -sample @var{interval}
 ## @deftypefnx {} {} profile off
 ## @deftypefnx {} {} profile resume
+## @deftypefnx {} {} profile resume -sample
+## @deftypefnx {} {} profile resume -sample @var{interval}
 ## @deftypefnx {} {} profile clear
 ## @deftypefnx {} {@var{S} =} profile ("status")
 ## @deftypefnx {} {@var{T} =} profile ("info")
@@ -29,6 +33,19 @@
 ## @item profile on
 ## Start the profiler, clearing all previously collected data if there is any.
 ##
+## @item profile on -sample
+## @itemx profile on -sample @var{interval}
+## Start the profiler in sampling mode.  Instead of timing every call, the
+## profiler counts the functions and lines that are executing every
+## @var{interval} seconds of CPU time, 0.001 by default.  This has almost no
+## overhead, so it is suitable for long runs and code that calls many small
+## functions.  The times are estimated from the number of samples, and the
+## call counts @code{NumCalls} and those in @code{ExecutedLines} are the
+## numbers of samples taken in each function and line.  Time spent in
+## compiled code is attributed to the builtin function or operator that was
+## called, and time outside of any function is not recorded.  No memory usage
+## and no @code{FunctionHistory} are recorded in this mode.
+##
 ## @item profile off
 ## Stop profiling.  The collected data can later be retrieved and examined
 ## with @code{T = profile ("info")}.
@@ -38,7 +55,8 @@
 ##
 ## @item profile resume
 ## Restart profiling without clearing the old data.  All newly collected
-## statistics are added to the existing ones.
+## statistics are added to the existing ones.  With @option{-sample}, the
+## profiler is restarted in sampling mode.
 ##
 ## @item @var{S} = profile ("status")
 ## Return a structure with information about the current status of the
@@ -54,23 +72,63 @@
 ## index into the @code{FunctionTable} identifying the function it corresponds
 ## to as well as data fields for number of calls and time spent at this level
 ## in the call tree.
-## @seealso{profshow, profexplore}
+##
+## The fields @code{TotalMemAllocated} and @code{TotalMemFreed} of each entry
+## of @code{FunctionTable} are the number of bytes allocated and freed for
+## arrays and values while executing the function itself, @code{PeakMem} is
+## the largest number of bytes in use at any time while executing it, and
+## @code{NumCopies} is the number of arrays that had to be copied because
+## their data was shared with another variable.
+##
+## For functions defined in Octave code, the field @code{ExecutedLines} of
+## each entry of @code{FunctionTable} is a matrix with one row for each line
+## of the function that was executed.  The columns are the line number, the
+## number of times the line was executed, the time spent on the line itself,
+## not including the time of the functions called from it, and the bytes
+## allocated, bytes freed, peak bytes in use and number of copies for the
+## line, in the same way.
+##
+## The field @code{FunctionHistory} is a matrix with one column for each
+## function entry and exit in the order they occurred.  The first row is 0 for
+## entries and 1 for exits, the second row is the index of the function in
+## @code{FunctionTable}, and the third row is the time in seconds since
+## profiling was started.  Only the first events are recorded for very long
+## runs.
+## @seealso{profshow, profexplore, profflame, proftrace}
 ## @end table
 ## @end deftypefn
 
 ## Built-in profiler.
 ## Author: Daniel Kraft <d@domob.eu>
 
-function retval = profile (option)
+function retval = profile (option, varargin)
 
-  if (nargin != 1)
+  if (nargin < 1 || nargin > 3)
     print_usage ();
   endif
 
+  interval = 0;
+  if (nargin > 1)
+    if (! any (strcmp (option, {"on", "resume"}))
+        || ! strcmp (varargin{1}, "-sample"))
+      print_usage ();
+    endif
+    interval = 1e-3;
+    if (nargin > 2)
+      interval = varargin{2};
+      if (ischar (interval))
+        interval = str2double (interval);
+      endif
+      if (! (isscalar (interval) && isreal (interval) && interval > 0))
+        error ("profile: INTERVAL must be a positive number");
+      endif
+    endif
+  endif
+
   switch (option)
     case "on"
       __profiler_reset__ ();
-      __profiler_enable__ (true);
+      __profiler_enable__ (true, interval);
 
     case "off"
       __profiler_enable__ (false);
@@ -79,7 +137,7 @@ function retval = profile (option)
       __profiler_reset__ ();
 
     case "resume"
-      __profiler_enable__ (true);
+      __profiler_enable__ (true, interval);
 
     case "status"
       enabled = __profiler_enable__ ();
@@ -91,8 +149,9 @@ function retval = profile (option)
       retval = struct ("ProfilerStatus", enabled);
 
     case "info"
-      [flat, tree] = __profiler_data__ ();
-      retval = struct ("FunctionTable", flat, "Hierarchical", tree);
+      [flat, tree, hist] = __profiler_data__ ();
+      retval = struct ("FunctionTable", flat, "Hierarchical", tree,
+                       "FunctionHistory", hist);
 
     otherwise
       warning ("profile: Unrecognized option '%s'", option);
@@ -129,25 +188,77 @@ endfunction
 %! info = profile ("info");
 %! assert (isstruct (info));
 %! assert (size (info), [1, 1]);
-%! assert (fieldnames (info), {"FunctionTable"; "Hierarchical"});
+%! assert (fieldnames (info), {"FunctionTable"; "Hierarchical"; "FunctionHistory"});
 %! ftbl = info.FunctionTable;
-%! assert (fieldnames (ftbl), {"FunctionName"; "TotalTime"; "NumCalls"; "IsRecursive"; "Parents"; "Children"});
+%! assert (fieldnames (ftbl), {"FunctionName"; "TotalTime"; "NumCalls"; "IsRecursive"; "Parents"; "Children"; "ExecutedLines"; "TotalMemAllocated"; "TotalMemFreed"; "PeakMem"; "NumCopies"});
 %! hier = info.Hierarchical;
 %! assert (fieldnames (hier), {"Index"; "SelfTime"; "TotalTime"; "NumCalls"; "Children"});
 %! profile ("clear");
 %! info = profile ("info");
 %! assert (isstruct (info));
 %! assert (size (info), [1, 1]);
-%! assert (fieldnames (info), {"FunctionTable"; "Hierarchical"});
+%! assert (fieldnames (info), {"FunctionTable"; "Hierarchical"; "FunctionHistory"});
 %! ftbl = info.FunctionTable;
 %! assert (size (ftbl), [0, 1]);
-%! assert (fieldnames (ftbl), {"FunctionName"; "TotalTime"; "NumCalls"; "IsRecursive"; "Parents"; "Children"});
+%! assert (fieldnames (ftbl), {"FunctionName"; "TotalTime"; "NumCalls"; "IsRecursive"; "Parents"; "Children"; "ExecutedLines"; "TotalMemAllocated"; "TotalMemFreed"; "PeakMem"; "NumCopies"});
+%! assert (info.FunctionHistory, zeros (3, 0));
 %! hier = info.Hierarchical;
 %! assert (size (hier), [0, 1]);
 %! assert (fieldnames (hier), {"Index"; "SelfTime"; "NumCalls"; "Children"});
 
+%!function x = __profile_work__ (n)
+%!  x = 0;
+%!  for i = 1:n
+%!    x += sqrt (i);
+%!  endfor
+%!endfunction
+
+%!testif HAVE_SETITIMER
+%! profile ("on", "-sample", 1e-3);
+%! t0 = cputime ();
+%! do
+%!   __profile_work__ (1e4);
+%! until (cputime () - t0 > 0.5)
+%! profile ("off");
+%! info = profile ("info");
+%! assert (fieldnames (info), {"FunctionTable"; "Hierarchical"; "FunctionHistory"});
+%! ftbl = info.FunctionTable;
+%! assert (fieldnames (ftbl), {"FunctionName"; "TotalTime"; "NumCalls"; "IsRecursive"; "Parents"; "Children"; "ExecutedLines"; "TotalMemAllocated"; "TotalMemFreed"; "PeakMem"; "NumCopies"});
+%! idx = find (strcmp ({ftbl.FunctionName}, "__profile_work__"));
+%! assert (numel (idx), 1);
+%! assert (ftbl(idx).TotalTime > 0);
+%! assert (ftbl(idx).NumCalls > 0);
+%! assert (isempty (info.FunctionHistory));
+%! profile ("clear");
+
+%!function x = __profile_alloc__ (n)
+%!  x = zeros (n, 1);
+%!  y = x;
+%!  y(1) = 1;
+%!endfunction
+
+%!test
+%! profile ("on");
+%! __profile_alloc__ (1e5);
+%! profile ("off");
+%! info = profile ("info");
+%! ftbl = info.FunctionTable;
+%! idx = find (strcmp ({ftbl.FunctionName}, "__profile_alloc__"));
+%! assert (numel (idx), 1);
+%! ## The copy made by the assignment to y(1).
+%! assert (ftbl(idx).TotalMemAllocated >= 8e5);
+%! assert (ftbl(idx).PeakMem >= 2 * 8e5);
+%! assert (ftbl(idx).NumCopies >= 1);
+%! lines = ftbl(idx).ExecutedLines;
+%! assert (columns (lines), 7);
+%! assert (max (lines(:,4)) >= 8e5);
+%! assert (sum (lines(:,4)) <= ftbl(idx).TotalMemAllocated);
+%! profile ("clear");
+
 ## Test input validation
 %!error profile ()
 %!error profile ("on", 2)
+%!error profile ("off", "-sample")
+%!error <INTERVAL must be a positive number> profile ("on", "-sample", -1)
 %!error profile ("INVALID_OPTION")
 
@@ -0,0 +1,131 @@
+## Copyright (C) 2026 The Octave Project Developers
+##
+## This file is part of Octave.
+##
+## Octave is free software; you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or (at
+## your option) any later version.
+##
+## Octave is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+## General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+## -*- texinfo -*-
+## @deftypefn  {} {} proftrace (@var{file})
+## @deftypefnx {} {} proftrace (@var{file}, @var{data})
+## Export the profiler function history as a trace timeline.
+##
+## Write the function entries and exits recorded in the field
+## @code{FunctionHistory} of the profile to @var{file} in the JSON trace
+## event format.  The file can be opened with trace viewers such as the
+## @samp{chrome://tracing} page of the Chrome browser or Perfetto, which show
+## each function call as a span on a timeline.
+##
+## Exits of functions that were entered before profiling was started are
+## omitted, and calls that were still active when profiling was stopped end
+## at the time of the last recorded event.
+##
+## The input @var{data} is the structure returned by @code{profile ("info")}.
+## If unspecified, @code{proftrace} will use the current profile dataset.
+##
+## @seealso{profflame, profexport, profshow, profile}
+## @end deftypefn
+
+function proftrace (file, data)
+
+  if (nargin < 1 || nargin > 2)
+    print_usage ();
+  endif
+
+  if (! ischar (file))
+    error ("proftrace: FILE must be a string");
+  endif
+
+  if (nargin == 1)
+    data = profile ("info");
+  endif
+
+  names = {data.FunctionTable.FunctionName};
+  names = strrep (strrep (names, '\', '\\'), '"', '\"');
+  hist = data.FunctionHistory;
+
+  n = columns (hist);
+  events = cell (1, n);
+  stack = zeros (1, n);
+  depth = 0;
+  nev = 0;
+  for i = 1 : n
+    idx = hist(2,i);
+    usec = 1e6 * hist(3,i);
+    if (hist(1,i) == 0)
+      depth += 1;
+      stack(depth) = idx;
+      ph = "B";
+    elseif (depth > 0 && stack(depth) == idx)
+      depth -= 1;
+      ph = "E";
+    else
+      continue;
+    endif
+    nev += 1;
+    events{nev} = __event__ (names{idx}, ph, usec);
+  endfor
+
+  if (n > 0)
+    usec = 1e6 * hist(3,n);
+    for i = depth : -1 : 1
+      nev += 1;
+      events{nev} = __event__ (names{stack(i)}, "E", usec);
+    endfor
+  endif
+
+  fid = fopen (file, "w");
+  if (fid < 0)
+    error ("proftrace: failed to open '%s' for writing", file);
+  endif
+  unwind_protect
+    fputs (fid, "{\"traceEvents\":[\n");
+    fputs (fid, strjoin (events(1:nev), ",\n"));
+    fputs (fid, "\n],\"displayTimeUnit\":\"ms\"}\n");
+  unwind_protect_cleanup
+    fclose (fid);
+  end_unwind_protect
+
+endfunction
+
+function str = __event__ (name, ph, usec)
+  str = sprintf ('{"name":"%s","ph":"%s","ts":%.3f,"pid":1,"tid":1}',
+                 name, ph, usec);
+endfunction
+
+
+%!test
+%! fcn = struct ("FunctionName", {"f", 'say "hi"'});
+%! hist = [0, 0, 1, 1, 0;
+%!         1, 2, 2, 2, 1;
+%!         0, 1e-6, 2e-6, 3e-6, 4e-6];
+%! data = struct ("FunctionTable", fcn, "FunctionHistory", hist);
+%! file = tempname ();
+%! unwind_protect
+%!   proftrace (file, data);
+%!   str = fileread (file);
+%! unwind_protect_cleanup
+%!   unlink (file);
+%! end_unwind_protect
+%! ev = regexp (str, '"name":"((?:[^"\\]|\\.)*)","ph":"(.)","ts":([0-9.]+)',
+%!              "tokens");
+%! assert (numel (ev), 6);
+%! assert (ev{2}, {'say \"hi\"', "B", "1.000"});
+%! assert (ev{3}{2}, "E");
+%! assert (ev{6}, {"f", "E", "4.000"});
+
+## Test input validation
+%!error proftrace ()
+%!error proftrace (1, 2, 3)
+%!error <FILE must be a string> proftrace (5)
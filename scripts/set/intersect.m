@@ -20,6 +20,7 @@
 ## -*- texinfo -*-
 ## @deftypefn  {} {@var{c} =} intersect (@var{a}, @var{b})
 ## @deftypefnx {} {@var{c} =} intersect (@var{a}, @var{b}, "rows")
+## @deftypefnx {} {@var{c} =} intersect (@dots{}, "stable")
 ## @deftypefnx {} {[@var{c}, @var{ia}, @var{ib}] =} intersect (@dots{})
 ##
 ## Return the unique elements common to both @var{a} and @var{b} sorted in
@@ -35,17 +36,38 @@
 ## If requested, return index vectors @var{ia} and @var{ib} such that
 ## @code{@var{c} = @var{a}(@var{ia})} and @code{@var{c} = @var{b}(@var{ib})}.
 ##
+## If the optional input @qcode{"stable"} is given then the common elements
+## (or rows) are returned in the order in which they first occur in @var{a},
+## and @var{ia} and @var{ib} refer to their first occurrences.  This option
+## is not supported for sparse or complex arrays.
+##
 ## @end deftypefn
 ## @seealso{unique, union, setdiff, setxor, ismember}
 
 function [c, ia, ib] = intersect (a, b, varargin)
 
-  if (nargin < 2 || nargin > 3)
+  if (nargin < 2 || nargin > 4)
+    print_usage ();
+  endif
+
+  optstable = strcmp ("stable", varargin);
+  varargin(optstable) = [];
+  optstable = any (optstable);
+  if (numel (varargin) > 1)
     print_usage ();
   endif
 
   [a, b] = validsetargs ("intersect", a, b, varargin{:});
 
+  by_rows = ! isempty (varargin);
+  use_hash = (strcmp (class (a), class (b))
+              && (iscellstr (a) || (isreal (a) && isreal (b)
+                                    && ! issparse (a) && ! issparse (b))));
+
+  if (optstable && ! use_hash)
+    error ('intersect: "stable" requires A and B of the same class and not sparse or complex');
+  endif
+
   if (isempty (a) || isempty (b))
     ## Special case shortcuts algorithm.
     ## Lots of type checking required for Matlab compatibility.
@@ -57,8 +79,14 @@ function [c, ia, ib] = intersect (a, b, varargin)
       c = "";
     endif
     ia = ib = [];
+  elseif (use_hash)
+    ## Group equal values with a hash table and sort only the common ones.
+    if (nargout > 1)
+      [c, ia, ib] = __intersect__ (a, b, by_rows, optstable);
+    else
+      c = __intersect__ (a, b, by_rows, optstable);
+    endif
   else
-    by_rows = nargin == 3;
     isrowvec = isrow (a) && isrow (b);
 
     ## Form A and B into sets
@@ -150,6 +178,17 @@ endfunction
 %! assert (ia, [1:3]');
 %! assert (ib, [1:3]');
 
+## Test "stable" option
+%!test
+%! a = [3 2 4 5 7 6 5 1 0 13 13];
+%! b = [3 5 12 1 1 7];
+%! [c,ia,ib] = intersect (a, b, "stable");
+%! assert (c, [3 5 7 1]);
+%! assert (ia, [1 4 5 8]);
+%! assert (ib, [1 2 6 4]);
+%!assert (intersect ({"b","c","a"}, {"a","b"}, "stable"), {"b","a"})
+%!assert (intersect ([4,5;1,2;4,5], [1,2;4,5], "rows", "stable"), [4,5;1,2])
+
 ## Test return type of empty intersections
 %!assert (intersect (['a', 'b'], {}), {})
 %!assert (intersect ([], {'a', 'b'}), {})
@@ -92,6 +92,19 @@ function [tf, s_idx] = ismember (a, s, varargin)
 
   by_rows = nargin == 3;
 
+  ## Use a hash table when both arguments have the same real, full type.
+  if (strcmp (class (a), class (s))
+      && (iscellstr (a) || (isreal (a) && isreal (s)
+                            && ! issparse (a) && ! issparse (s)))
+      && ! (by_rows && (isempty (a) || isempty (s))))
+    if (nargout > 1)
+      [tf, s_idx] = __ismember__ (a, s, by_rows);
+    else
+      tf = __ismember__ (a, s, by_rows);
+    endif
+    return;
+  endif
+
   if (! by_rows)
     s = s(:);
     ## Check sort status, because we expect the array will often be sorted.
@@ -221,6 +234,16 @@ endfunction
 %! assert (result, [true; false; true]);
 %! assert (s_idx, [1; 0; 2]);
 
+%!test
+%! [result, s_idx] = ismember (int8 ([1, 2, 3]), [2, 3, 2]);
+%! assert (result, [false, true, true]);
+%! assert (s_idx, [0, 3, 2]);
+
+%!test
+%! [result, s_idx] = ismember ([NaN, 1], [1, NaN, 1]);
+%! assert (result, [false, true]);
+%! assert (s_idx, [0, 3]);
+
 %!test
 %! [result, s_idx] = ismember ([1:3; 5:7; 4:6; 0:2; 1:3; 2:4], [1:3], "rows");
 %! assert (result, logical ([1 0 0 0 1 0]'));
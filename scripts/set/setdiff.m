@@ -20,6 +20,7 @@
 ## -*- texinfo -*-
 ## @deftypefn  {} {@var{c} =} setdiff (@var{a}, @var{b})
 ## @deftypefnx {} {@var{c} =} setdiff (@var{a}, @var{b}, "rows")
+## @deftypefnx {} {@var{c} =} setdiff (@dots{}, "stable")
 ## @deftypefnx {} {[@var{c}, @var{ia}] =} setdiff (@dots{})
 ## Return the unique elements in @var{a} that are not in @var{b} sorted in
 ## ascending order.
@@ -33,6 +34,11 @@
 ##
 ## If requested, return the index vector @var{ia} such that
 ## @code{@var{c} = @var{a}(@var{ia})}.
+##
+## If the optional input @qcode{"stable"} is given then the elements (or
+## rows) are returned in the order in which they first occur in @var{a}, and
+## @var{ia} refers to their first occurrences.  This option is not supported
+## for sparse or complex arrays.
 ## @seealso{unique, union, intersect, setxor, ismember}
 ## @end deftypefn
 
@@ -41,16 +47,37 @@
 
 function [c, ia] = setdiff (a, b, varargin)
 
-  if (nargin < 2 || nargin > 3)
+  if (nargin < 2 || nargin > 4)
+    print_usage ();
+  endif
+
+  optstable = strcmp ("stable", varargin);
+  varargin(optstable) = [];
+  optstable = any (optstable);
+  if (numel (varargin) > 1)
     print_usage ();
   endif
 
   [a, b] = validsetargs ("setdiff", a, b, varargin{:});
 
-  by_rows = nargin == 3;
+  by_rows = ! isempty (varargin);
   isrowvec = isrow (a);
+  use_hash = (! isempty (a) && strcmp (class (a), class (b))
+              && (iscellstr (a) || (isreal (a) && isreal (b)
+                                    && ! issparse (a) && ! issparse (b))));
+
+  if (optstable && ! use_hash && ! isempty (a))
+    error ('setdiff: "stable" requires A and B of the same class and not sparse or complex');
+  endif
 
-  if (by_rows)
+  if (use_hash)
+    ## Group equal values with a hash table and sort only the remaining ones.
+    if (nargout > 1)
+      [c, ia] = __setdiff__ (a, b, by_rows, optstable);
+    else
+      c = __setdiff__ (a, b, by_rows, optstable);
+    endif
+  elseif (by_rows)
     if (nargout > 1)
       [c, ia] = unique (a, "rows");
     else
@@ -114,6 +141,14 @@ endfunction
 %! assert (c, [5]);
 %! assert (c, a(ia));
 
+%!test
+%! [c, ia] = setdiff ([5, 3, 9, 5, 1], [3, 4], "stable");
+%! assert (c, [5, 9, 1]);
+%! assert (ia, [1, 3, 5]);
+%!assert (setdiff ({"z","b","a"}, {"b"}, "stable"), {"z","a"})
+%!assert (setdiff ([4,4;1,1;2,2], [1,1], "rows", "stable"), [4,4;2,2])
+%!assert (setdiff (int8 ([3, 1, 2]), [1, 5]), int8 ([2, 3]))
+
 ## Test output orientation compatibility (bug #42577)
 %!assert (setdiff ([1:5], 2), [1,3,4,5])
 %!assert (setdiff ([1:5]', 2), [1;3;4;5])
@@ -23,6 +23,7 @@
 ## @deftypefnx {} {[@var{y}, @var{i}, @var{j}] =} unique (@dots{})
 ## @deftypefnx {} {[@var{y}, @var{i}, @var{j}] =} unique (@dots{}, "first")
 ## @deftypefnx {} {[@var{y}, @var{i}, @var{j}] =} unique (@dots{}, "last")
+## @deftypefnx {} {} unique (@dots{}, "stable")
 ## Return the unique elements of @var{x} sorted in ascending order.
 ##
 ## If the input @var{x} is a column vector then return a column vector;
@@ -41,6 +42,12 @@
 ## @qcode{"last"} is specified, return the highest possible indices in
 ## @var{i}, otherwise, if @qcode{"first"} is specified, return the lowest.
 ## The default is @qcode{"last"}.
+##
+## If the optional argument @qcode{"stable"} is given then the unique
+## elements (or rows) are returned in the order of their first occurrence in
+## @var{x} instead of sorted order, and the default for @var{i} becomes
+## @qcode{"first"}.  This option is not supported for sparse or complex
+## arrays.
 ## @seealso{union, intersect, setdiff, setxor, ismember}
 ## @end deftypefn
 
@@ -58,14 +65,21 @@ function [y, i, j] = unique (x, varargin)
       error ("unique: options must be strings");
     endif
 
-    optrows  = any (strcmp ("rows", varargin));
-    optfirst = any (strcmp ("first", varargin));
-    optlast  = any (strcmp ("last", varargin));
+    optrows   = any (strcmp ("rows", varargin));
+    optfirst  = any (strcmp ("first", varargin));
+    optlast   = any (strcmp ("last", varargin));
+    optstable = any (strcmp ("stable", varargin));
     if (optfirst && optlast)
       error ('unique: cannot specify both "first" and "last"');
-    elseif (optfirst + optlast + optrows != nargin-1)
+    elseif (optfirst + optlast + optrows + optstable != nargin-1)
       error ("unique: invalid option");
     endif
+    if (optstable)
+      if (issparse (x) || iscomplex (x))
+        error ('unique: "stable" is not supported for sparse or complex arrays');
+      endif
+      optfirst = ! optlast;
+    endif
 
     if (optrows && iscellstr (x))
       warning ('unique: "rows" is ignored for cell arrays');
@@ -74,6 +88,7 @@ function [y, i, j] = unique (x, varargin)
   else
     optrows = false;
     optfirst = false;
+    optstable = false;
   endif
 
   ## FIXME: The operations
@@ -120,6 +135,16 @@ function [y, i, j] = unique (x, varargin)
     return;
   endif
 
+  ## Group equal values with a hash table and sort only the unique ones.
+  if (iscellstr (x) || (isreal (x) && ! issparse (x)))
+    if (nargout > 1)
+      [y, i, j] = __unique__ (x, optrows, optfirst, optstable);
+    else
+      y = __unique__ (x, optrows, optfirst, optstable);
+    endif
+    return;
+  endif
+
   if (optrows)
     if (nargout > 1)
       [y, i] = sortrows (y);
@@ -190,6 +215,11 @@ endfunction
 %!assert (unique (uint8 ([1,2,2,3,2,4]), "rows"), uint8 ([1,2,2,3,2,4]))
 %!assert (unique (uint8 ([1,2,2,3,2,4])), uint8 ([1,2,3,4]))
 %!assert (unique (uint8 ([1,2,2,3,2,4]'), "rows"), uint8 ([1,2,3,4]'))
+%!assert (unique ([3,1,2,1,3], "stable"), [3,1,2])
+%!assert (unique ([3;1;2;1;3], "stable"), [3;1;2])
+%!assert (unique ({"b","a","b","c"}, "stable"), {"b","a","c"})
+%!assert (unique ([2,1;1,1;2,1], "rows", "stable"), [2,1;1,1])
+%!assert (unique ([1,NaN,1,NaN], "stable"), [1,NaN,NaN])
 
 %!test
 %! [a,i,j] = unique ([1,1,2,3,3,3,4]);
@@ -210,6 +240,18 @@ endfunction
 %! assert (j, [1;1;1]);
 %!
 %!test
+%! [a,i,j] = unique ([4,2,4,1,2], "stable");
+%! assert (a, [4,2,1]);
+%! assert (i, [1,2,4]);
+%! assert (j, [1,2,1,3,2]);
+%!
+%!test
+%! [a,i,j] = unique ([4,2,4,1,2], "stable", "last");
+%! assert (a, [4,2,1]);
+%! assert (i, [3,5,4]);
+%! assert (j, [1,2,1,3,2]);
+%!
+%!test
 %! A = [1,2,3;1,2,3];
 %! [a,i,j] = unique (A, "rows");
 %! assert (a, [1,2,3]);
@@ -226,5 +268,6 @@ endfunction
 %!error <invalid option> unique ({"a", "b", "c"}, "UnknownOption1", "UnknownOption2")
 %!error <invalid option> unique ({"a", "b", "c"}, "rows", "UnknownOption2")
 %!error <invalid option> unique ({"a", "b", "c"}, "UnknownOption1", "last")
+%!error <"stable" is not supported> unique ([1i, 1], "stable")
 %!warning <"rows" is ignored for cell arrays> unique ({"1"}, "rows");
 
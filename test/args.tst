@@ -234,3 +234,21 @@
 %!test
 %! f()
 
+
+## argument and return lists around the size stored without allocation
+%!function varargout = f (varargin)
+%!  varargout = fliplr (varargin);
+%!endfunction
+%!test
+%! for n = 0:7
+%!   args = num2cell (1:n);
+%!   out = cell (1, n);
+%!   [out{:}] = f (args{:});
+%!   assert (out, num2cell (n:-1:1));
+%! endfor
+%!test
+%! [a, b, c, d, e] = f (1, 2, 3, 4, 5);
+%! assert ([a, b, c, d, e], [5, 4, 3, 2, 1]);
+%! c = cell (1, 3);
+%! [c{1:3}] = deal (max ([3, 1, 2]));
+%! assert (c, {3, 3, 3});
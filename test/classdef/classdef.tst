@@ -71,3 +71,34 @@
 %! obj = foo_method_changes_property_size (3);
 %! obj = obj.move_element_to_end (2);
 %! assert (obj.element, [1 3 2]);
+
+%%  Objects of the same class share the layout of their property values
+%!test
+%! p = foo_value_class (4, 48, 50e3);
+%! q = foo_value_class (5, 60, 20e3);
+%! r = p;
+%! for k = 1:3
+%!   r.term = r.term + 1;
+%! endfor
+%! assert ([p.term, q.term, r.term], [48, 60, 51]);
+%! assert ([p.rate, q.rate, r.rate], [4, 5, 4]);
+%! assert (amount (r), foo_value_class (4, 51, 50e3).amount, eps ());
+
+%%  Subclass objects have their own layout including inherited properties
+%!test
+%! p = foo_value_class (4, 48, 50e3);
+%! s = foo_value_subclass (5, 60, 20e3, 10);
+%! for k = 1:2
+%!   assert ([p.rate, p.term, s.rate, s.term, s.fee], [4, 48, 5, 60, 10]);
+%!   s.term = s.term + 1;
+%!   p.term = p.term - 1;
+%! endfor
+%! assert ([p.term, s.term], [46, 62]);
+%! assert (amount (s), foo_value_class (5, 62, 20e3).amount + 10, eps ());
+
+%%  Properties that are not defined can not be referenced or assigned
+%!test
+%! s = foo_value_subclass (5, 60, 20e3, 10);
+%! fail ("s.no_such_property", "unknown method or property");
+%! fail ("s.no_such_property = 1", "unknown property");
+%! assert (s.fee, 10);
@@ -0,0 +1,14 @@
+classdef foo_value_subclass < foo_value_class
+  properties
+    fee;
+  end
+  methods
+    function obj = foo_value_subclass (r, t, p, f)
+      obj = obj@foo_value_class (r, t, p);
+      obj.fee = f;
+    end
+    function amt = amount (obj)
+      amt = amount@foo_value_class (obj) + obj.fee;
+    end
+  end
+end
@@ -2,6 +2,7 @@ classdef_TEST_FILES = \
   test/classdef/foo_method_changes_property_size.m \
   test/classdef/foo_static_method_constant_property.m \
   test/classdef/foo_value_class.m \
+  test/classdef/foo_value_subclass.m \
   test/classdef/classdef.tst
 
 TEST_FILES += $(classdef_TEST_FILES)
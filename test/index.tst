@@ -586,3 +586,36 @@
 %! c = cell(1,1,1);
 %! c{1,1,1} = zeros(5, 2);
 %! c{1,1,1}(:, 1) = 1;
+
+## Growing arrays by appending
+%!test
+%! x = [];
+%! for i = 1:5000
+%!   x(end+1) = i;
+%! endfor
+%! assert (x, 1:5000);
+%! y = x;
+%! x(end+1) = 0;
+%! assert (numel (y), 5000);
+%! x(end) = [];
+%! assert (x, y);
+
+%!test
+%! A = zeros (3, 1);
+%! for i = 2:2000
+%!   A(:,end+1) = [i; -i; 2*i];
+%! endfor
+%! assert (size (A), [3, 2000]);
+%! assert (A(:,end), [2000; -2000; 4000]);
+%! B = A;
+%! A(:,end+1) = 1;
+%! assert (size (B), [3, 2000]);
+%! assert (A(:,1:end-1), B);
+
+%!test
+%! c = {};
+%! for i = 1:3000
+%!   c{end+1} = sprintf ("%d", i);
+%! endfor
+%! assert (numel (c), 3000);
+%! assert (c{2500}, "2500");
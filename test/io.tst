@@ -727,3 +727,17 @@
 %!assert (sprintf ("%s", repmat ("blah", 2, 1)), "bbllaahh")
 %!assert (sprintf ("%c", repmat ("blah", 2, 1)), "bbllaahh")
 %!assert (sprintf ("%c %c %s", repmat ("blah", 2, 1)), "b b llaahh")
+
+## Formatting of real numeric arrays
+%!assert (sprintf ("%d,%f\n", [1, 2; 3, 4]), "1,3.000000\n2,4.000000\n")
+%!assert (sprintf ("%d %d|", 1:3), "1 2|3 ")
+%!assert (sprintf ("%d,", int8 ([-1, 2]), single (3), true), "-1,2,3,1,")
+%!assert (sprintf ("%d %i %u %x", 1.5, -2.5, -1, 255), "1.5 -2.5 -1 ff")
+%!assert (sprintf ("[%+5.1f]", [-Inf, NaN, NA, Inf]),
+%!        "[ -Inf][ +NaN][  +NA][ +Inf]")
+%!assert (sprintf ("%d%%", [10, 20]), "10%20%")
+%!test
+%! x = (1:1e5)';
+%! str = sprintf ("%d,%.2f\n", [x, x/4]');
+%! assert (numel (strsplit (str, "\n")), 1e5 + 1);
+%! assert (str(end-15:end), "100000,25000.00\n");
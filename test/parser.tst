@@ -326,3 +326,23 @@
 ## Maybe unnecessary, but check that further changes to parser don't
 ## invalidate error handling (bug #46534).
 #!error <vertical dimensions mismatch \(1x2 vs 1x1\)> z = [1, 2; 3]
+
+## Operations on constants are folded when parsed
+%!test
+%! a = [1, -2, +3, 4e1, -5i, 1+2i];
+%! assert (a, [1, -2, 3, 40, complex(0, -5), complex(1, 2)]);
+%! assert (10:-2:1, [10, 8, 6, 4, 2]);
+%! assert ([1, 2, 3]', [1; 2; 3]);
+%! assert (! 0, true);
+%! f = @() -2 * 3;
+%! assert (func2str (f), "@() -2 * 3");
+%! assert (f (), -6);
+
+%!error <nonconformant> [1, 2] + [1, 2, 3]
+
+## Literal numbers
+%!assert (1_000, 1000)
+%!assert (123456789012345, 1.23456789012345e14)
+%!assert (1234567890123456789, 1.234567890123456789e18)
+%!assert (0x1F, 31)
+%!assert (2d2, 200)
@@ -38,5 +38,23 @@
 %!
 %!assert (f (5), 120)
 
+## error at the bottom of a deep recursion unwinds every frame
+%!function y = g (x)
+%!  if (x == 0)
+%!    error ("g: bottom");
+%!  endif
+%!  y = g (x-1);
+%!endfunction
+%!
+%!test
+%! for i = 1:3
+%!   try
+%!     g (100);
+%!   catch err
+%!     assert (err.message, "g: bottom");
+%!   end_try_catch
+%! endfor
+%! assert (f (5), 120);
+
 %%FIXME: Need test for maximum recursion depth
 
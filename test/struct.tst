@@ -242,3 +242,39 @@
 %! s = resize (struct (),3,2);
 %! s(3).foo = 42;
 %! s(7);
+
+## test cached field lookups when the fields of a struct change
+%!test
+%! s = struct ("a", 1, "b", 2);
+%! t = s;
+%! x = zeros (1, 4);
+%! for i = 1:4
+%!   x(i) = s.b;
+%!   s.b = s.b + 1;
+%!   if (i == 2)
+%!     s = rmfield (s, "a");
+%!   elseif (i == 3)
+%!     s = struct ("c", 0, "b", 10);
+%!   endif
+%! endfor
+%! assert (x, [2, 3, 4, 10]);
+%! assert (t, struct ("a", 1, "b", 2));
+%! assert (s, struct ("c", 0, "b", 11));
+
+%!test
+%! s.a.b.c = 1;
+%! for i = 1:3
+%!   s.a.b.c = s.a.b.c + 1;
+%!   s.d = i;
+%! endfor
+%! assert (s.a.b.c, 4);
+%! assert (s.d, 3);
+
+%!error <structure has no member 'b'>
+%! s = struct ("a", 1);
+%! for i = 1:2
+%!   x = s.a;
+%!   s = struct ("b", 2);
+%!   s = rmfield (s, "b");
+%! endfor
+%! x = s.b;